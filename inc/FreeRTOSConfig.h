@@ -42,16 +42,30 @@
 
 /* clang-format off */
 
+/* With ASIGNACION_ESTATICA every kernel object is reserved at link time and the heap is not used. */
+#ifdef ASIGNACION_ESTATICA
+#define configSUPPORT_STATIC_ALLOCATION  1
+#define configSUPPORT_DYNAMIC_ALLOCATION 0
+#else
 #define configSUPPORT_STATIC_ALLOCATION  0
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#endif
+
+/* On the posix board each task runs in a pthread, whose stack can not be smaller than PTHREAD_STACK_MIN
+ * (16 Kbytes on Linux) and also holds the frames of the signals that emulate the interrupts. */
+#ifdef POSIX
+#define configMINIMAL_STACK_SIZE ((uint16_t)(16 * 1024 / sizeof(StackType_t)))
+#else
+#define configMINIMAL_STACK_SIZE ((uint16_t)128)
+#endif
 
 #define configUSE_PREEMPTION             1
 #define configUSE_IDLE_HOOK              0
-#define configUSE_TICKLESS_IDLE          0
-#define configUSE_TICK_HOOK              0
+#define configUSE_TICKLESS_IDLE          1
+#define configUSE_TICK_HOOK              1
 #define configCPU_CLOCK_HZ               (SystemCoreClock)
 #define configTICK_RATE_HZ               ((TickType_t)1000) // 1000 ticks per second => 1ms tick rate
 #define configMAX_PRIORITIES             (15)
-#define configMINIMAL_STACK_SIZE         ((uint16_t)128)
 #define configAPPLICATION_ALLOCATED_HEAP 0
 #define configTOTAL_HEAP_SIZE            ((size_t)(16 * 1024)) /* 16 Kbytes. */
 #define configMAX_TASK_NAME_LEN          (16)
@@ -60,12 +74,12 @@
 #define configIDLE_SHOULD_YIELD          1
 #define configUSE_MUTEXES                1
 #define configQUEUE_REGISTRY_SIZE        8
-#define configCHECK_FOR_STACK_OVERFLOW   0
+#define configCHECK_FOR_STACK_OVERFLOW   2
 #define configUSE_RECURSIVE_MUTEXES      1
 #define configUSE_MALLOC_FAILED_HOOK     0
 #define configUSE_APPLICATION_TASK_TAG   0
 #define configUSE_COUNTING_SEMAPHORES    1
-#define configGENERATE_RUN_TIME_STATS    0
+#define configGENERATE_RUN_TIME_STATS    1
 
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES           0
@@ -79,16 +93,19 @@
 
 /* Set the following definitions to 1 to include the API function, or zero
  * to exclude the API function. */
-#define INCLUDE_vTaskPrioritySet         1
-#define INCLUDE_uxTaskPriorityGet        1
-#define INCLUDE_vTaskDelete              1
-#define INCLUDE_vTaskCleanUpResources    0
-#define INCLUDE_vTaskSuspend             1
-#define INCLUDE_vTaskDelayUntil          1
-#define INCLUDE_vTaskDelay               1
-#define INCLUDE_xTaskGetSchedulerState   1
-#define INCLUDE_xTimerPendFunctionCall   1
-#define INCLUDE_xSemaphoreGetMutexHolder 1
+#define INCLUDE_vTaskPrioritySet               1
+#define INCLUDE_uxTaskPriorityGet              1
+#define INCLUDE_vTaskDelete                    1
+#define INCLUDE_vTaskCleanUpResources          0
+#define INCLUDE_vTaskSuspend                   1
+#define INCLUDE_vTaskDelayUntil                1
+#define INCLUDE_vTaskDelay                     1
+#define INCLUDE_xTaskGetSchedulerState         1
+#define INCLUDE_xTimerPendFunctionCall         1
+#define INCLUDE_xSemaphoreGetMutexHolder       1
+#define INCLUDE_xTaskGetIdleTaskHandle         1
+#define INCLUDE_xTaskGetCurrentTaskHandle      1
+#define INCLUDE_xTimerGetTimerDaemonTaskHandle 1
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -157,6 +174,24 @@ void vMainPostStopProcessing(void);
 #define configPRE_STOP_PROCESSING  vMainPreStopProcessing
 #define configPOST_STOP_PROCESSING vMainPostStopProcessing
 
+/* The application bounds the idle time to the work pending in the tick hook before suppressing
+ * ticks, and catches up the suppressed ticks when it wakes up. */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+void vApplicationSleep(uint32_t xExpectedIdleTime);
+#endif /* defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__) */
+
+#define portSUPPRESS_TICKS_AND_SLEEP(xExpectedIdleTime) vApplicationSleep(xExpectedIdleTime)
+
+/* Run time statistics are measured in microseconds with the free running counter of the HAL, which
+ * keeps counting while the tick is suppressed. */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+void TickCounterStart(void);
+uint32_t TickCounterRead(void);
+#endif /* defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__) */
+
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() TickCounterStart()
+#define portGET_RUN_TIME_COUNTER_VALUE()         TickCounterRead()
+
 /* Definitions that map the FreeRTOS port interrupt handlers to their CMSIS
  * standard names. */
 #define vPortSVCHandler     SVC_Handler
@@ -0,0 +1,232 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef APLICACION_H
+#define APLICACION_H
+
+/** \brief Logica del reloj despertador
+ **
+ ** La aplicacion se ejecuta en dos contextos. La interrupcion del tic cuenta el tiempo, multiplexa
+ ** la pantalla, lee las teclas y la referencia externa, y genera eventos. La tarea de la aplicacion
+ ** procesa esos eventos de a uno.
+ **
+ ** Propiedad del estado:
+ ** - El modo, los valores que se estan ajustando y las esperas pendientes pertenecen a la tarea y
+ **   solo se modifican en ApplicationProcess. La plataforma temporiza las esperas sin trabajo en el
+ **   tic; como un vencimiento puede llegar despues de reiniciar la espera, la tarea guarda el limite
+ **   de cada una y descarta los vencimientos anteriores.
+ ** - El estado de las teclas y la deteccion de cambios pertenecen al tic y solo se modifican en
+ **   ApplicationTick.
+ ** - Un evento que no entra en la cola de la plataforma se cuenta como perdido. El tic mantiene el
+ **   nivel de las teclas y la mitad del segundo aunque se pierdan sus cambios, y despues de una
+ **   perdida la tarea lee esos niveles y genera los cambios de teclas que no vio. Los eventos de
+ **   teclas que no cambian lo que vio la tarea se ignoran, por lo que un cambio se atiende una sola vez.
+ ** - El reloj, la pantalla y la bandera de alarma sonando se comparten. El tic los usa sin
+ **   interrupciones; la tarea solo los usa entre Bloquear y Liberar de la plataforma, y escribe la
+ **   pantalla completa en una sola seccion, por lo que nunca se ve un cuadro a medio dibujar.
+ ** - Al despertar de un periodo de bajo consumo ApplicationResume hace el trabajo de los tics
+ **   omitidos con el tic detenido, por lo que tambien es duena del estado del tic.
+ **
+ ** El puerto de la referencia tambien funciona como consola: una linea `$C` pide a la plataforma que
+ ** envie su informe de carga del procesador.
+ **
+ ** \addtogroup aplicacion Aplicacion
+ ** \brief Logica del reloj despertador
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include "bspciaa.h"
+#include "disciplina.h"
+#include "reloj.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/* === Public data type declarations =========================================================== */
+
+//! Teclas de la placa, en el orden en que se leen
+typedef enum {
+    TECLA_SET_TIME,
+    TECLA_SET_ALARM,
+    TECLA_DECREMENT,
+    TECLA_INCREMENT,
+    TECLA_ACCEPT,
+    TECLA_CANCEL,
+    TECLAS,
+} tecla_t;
+
+//! Tipos de eventos que procesa la aplicacion
+typedef enum {
+    EVENTO_TECLA_PRESIONADA, //!< Se presiono la tecla indicada en el dato
+    EVENTO_TECLA_LIBERADA,   //!< Se libero la tecla indicada en el dato
+    EVENTO_MEDIO_SEGUNDO,    //!< Cambio de mitad de segundo, el dato indica si es la primera mitad
+    EVENTO_ALARMA,           //!< La alarma empezo o dejo de sonar, el dato indica si esta sonando
+    EVENTO_REFERENCIA,       //!< Se recibio la hora desde la referencia externa
+    EVENTO_TIEMPO_AGOTADO,   //!< Vencio la espera indicada en el dato
+    EVENTO_CONSULTA,         //!< Se recibio un pedido de informe por la consola
+} evento_tipo_t;
+
+//! Esperas que la plataforma temporiza para la aplicacion
+typedef enum {
+    ESPERA_PULSACION,   //!< Tiempo que hay que mantener una tecla para entrar en un ajuste
+    ESPERA_INACTIVIDAD, //!< Tiempo sin actividad tras el cual se abandona un ajuste
+    ESPERAS,
+} espera_t;
+
+//! Evento que el tic envia a la tarea de la aplicacion
+typedef struct evento_s {
+    evento_tipo_t tipo; //!< Tipo de evento
+    uint8_t dato;       //!< Informacion adicional que depende del tipo de evento
+} * evento_t;
+
+//! Funcion de callback para entrar o salir de una seccion que el tic no puede interrumpir
+typedef void (*aplicacion_seccion_t)(void);
+
+//! Funcion de callback para enviar un evento desde el tic a la tarea, devuelve false si no lo pudo entregar
+typedef bool (*aplicacion_notificar_t)(evento_t evento);
+
+//! Funcion de callback para iniciar o reiniciar una espera que termina con un evento EVENTO_TIEMPO_AGOTADO
+typedef void (*aplicacion_temporizar_t)(espera_t espera, uint32_t milisegundos);
+
+//! Funcion de callback para cancelar una espera
+typedef void (*aplicacion_detener_t)(espera_t espera);
+
+//! Funcion de callback para enviar por la consola el informe de carga de la plataforma
+typedef void (*aplicacion_informar_t)(void);
+
+//! Estructura con los servicios del sistema operativo que usa la aplicacion
+typedef struct aplicacion_plataforma_s {
+    aplicacion_seccion_t Bloquear;      //!< Funcion para impedir que el tic interrumpa a la tarea
+    aplicacion_seccion_t Liberar;       //!< Funcion para volver a permitir el tic
+    aplicacion_notificar_t Notificar;   //!< Funcion para enviar un evento a la tarea desde el tic
+    aplicacion_temporizar_t Temporizar; //!< Funcion para iniciar una espera desde la tarea
+    aplicacion_detener_t Detener;       //!< Funcion para cancelar una espera desde la tarea
+    aplicacion_informar_t Informar;     //!< Funcion para enviar el informe de carga, NULL si no hay informe
+} const * aplicacion_plataforma_t;
+
+//! Motivos por los que termina un periodo de bajo consumo
+typedef enum {
+    DESPERTAR_PANTALLA,     //!< La pantalla vuelve a tener digitos encendidos que multiplexar
+    DESPERTAR_TECLAS,       //!< Toca leer las teclas
+    DESPERTAR_RELOJ,        //!< Cambia el medio segundo del reloj
+    DESPERTAR_TAREA,        //!< Vence una espera de la tarea de la aplicacion
+    DESPERTAR_INTERRUPCION, //!< Otra interrupcion termino el reposo antes de lo previsto
+    DESPERTARES,
+} despertar_t;
+
+//! Contadores de los periodos de bajo consumo
+typedef struct reposo_s {
+    uint32_t despertares;          //!< Cantidad de periodos de reposo terminados
+    uint32_t tics_dormido;         //!< Tics transcurridos con el procesador dormido
+    uint32_t tics_omitidos;        //!< Tics que no se atendieron y se recuperaron al despertar
+    uint32_t causas[DESPERTARES]; //!< Cantidad de despertares por cada motivo
+} * reposo_t;
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Inicializa la aplicacion, debe llamarse antes de que empiece a ejecutarse el tic
+ *
+ * @param  placa                 Puntero al descriptor de la placa
+ * @param  reloj_aplicacion      Puntero al descriptor del reloj, creado con ApplicationAlarm como notificacion
+ * @param  disciplina_aplicacion Puntero al descriptor de la disciplina del reloj, o NULL si no se usa
+ * @param  servicios             Puntero a la estructura con los servicios del sistema operativo
+ */
+void ApplicationCreate(board_t placa, clock_t reloj_aplicacion, disciplina_t disciplina_aplicacion,
+                       aplicacion_plataforma_t servicios);
+
+/**
+ * @brief Procesa un tic del sistema, se llama desde la interrupcion una vez por milisegundo
+ *
+ * Los tics que se omiten durante un periodo de bajo consumo no llaman a esta funcion sino que se
+ * recuperan todos juntos con ApplicationResume.
+ */
+void ApplicationTick(void);
+
+/**
+ * @brief Calcula cuantos tics puede dormir el procesador sin demorar el trabajo del tic
+ *
+ * Se llama antes de entrar en bajo consumo, sin que el tic pueda interrumpir. El limite vale uno cuando
+ * el proximo tic ya tiene trabajo, por ejemplo mientras la pantalla muestra algun digito.
+ *
+ * @param  esperados Cantidad de tics que el sistema operativo no tiene tareas que ejecutar
+ * @return uint32_t  Cantidad maxima de tics que se pueden omitir, contando el que despierta
+ */
+uint32_t ApplicationSleepLimit(uint32_t esperados);
+
+/**
+ * @brief Recupera el tiempo transcurrido durante un periodo de bajo consumo
+ *
+ * Avanza el reloj, la pantalla y la lectura de las teclas los tics que no se atendieron y procesa el
+ * ultimo como un tic normal. Se llama al despertar, sin que el tic pueda interrumpir.
+ *
+ * @param  tics     Cantidad de tics transcurridos desde que se llamo a ApplicationSleepLimit
+ */
+void ApplicationResume(uint32_t tics);
+
+/**
+ * @brief Consulta los contadores de los periodos de bajo consumo
+ *
+ * @param  estadisticas Puntero a la estructura donde se copian los contadores
+ */
+void ApplicationSleepStats(reposo_t estadisticas);
+
+/**
+ * @brief Consulta la cantidad de eventos que la plataforma no pudo entregar a la tarea
+ *
+ * @return uint32_t Cantidad de eventos perdidos desde que se inicializo la aplicacion
+ */
+uint32_t ApplicationLostEvents(void);
+
+/**
+ * @brief Procesa un evento en la tarea de la aplicacion
+ *
+ * @param  evento   Puntero al evento recibido
+ * @param  ahora    Tiempo actual en milisegundos
+ */
+void ApplicationProcess(evento_t evento, uint32_t ahora);
+
+/**
+ * @brief Notificacion del reloj cuando la alarma empieza o deja de sonar
+ *
+ * @param  estado   Indica si la alarma esta sonando
+ */
+void ApplicationAlarm(bool estado);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* APLICACION_H */
@@ -34,6 +34,8 @@ SPDX-License-Identifier: MIT
 
 #include "digital.h"
 #include "display.h"
+#include "hal_sci.h"
+#include "traza.h"
 
 /* === Cabecera C++ ============================================================================ */
 
@@ -58,6 +60,8 @@ typedef struct board_s {
     digital_input_t accept;    //!< Puntero a descriptor de la entrada accept
     digital_input_t cancel;    //!< Puntero a descriptor de la entrada cancel
     display_t display;         //!< Puntero a descirptor de la pantalla
+    hal_sci_t referencia;      //!< Puerto serie por el que llega la hora de referencia
+    traza_t traza;             //!< Grabacion de las entradas y la pantalla, NULL si no se graba
 } const * board_t;
 
 /* === Public variable declarations ============================================================ */
@@ -0,0 +1,126 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef CALENDARIO_H
+#define CALENDARIO_H
+
+/** \brief Calculos de fechas del calendario civil
+ **
+ ** Conversiones entre fechas y numero de dias en tiempo constante, sin recorrer meses ni anios,
+ ** y reglas de horario de verano definidas en una tabla constante.
+ **
+ ** \addtogroup calendario Calendario
+ ** \brief Calendario gregoriano proleptico
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+//! Valor de semana en una regla de horario de verano que indica la ultima semana del mes
+#define DST_ULTIMA_SEMANA 5
+
+/* === Public data type declarations =========================================================== */
+
+//! Fecha del calendario civil
+typedef struct fecha_s {
+    int16_t anio; //!< Anio completo, por ejemplo 2023
+    uint8_t mes;  //!< Mes del anio, de 1 a 12
+    uint8_t dia;  //!< Dia del mes, de 1 a 31
+} fecha_t;
+
+//! Reglas de horario de verano disponibles en la tabla
+typedef enum {
+    DST_NINGUNO,        //!< Sin horario de verano
+    DST_EUROPA_CENTRAL, //!< Ultimo domingo de marzo a ultimo domingo de octubre
+    DST_AMERICA_NORTE,  //!< Segundo domingo de marzo a primer domingo de noviembre
+    DST_AUSTRALIA_SUR,  //!< Primer domingo de octubre a primer domingo de abril
+    DST_CANTIDAD,       //!< Cantidad de reglas definidas
+} dst_regla_t;
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Calcula la cantidad de dias entre el 1 de enero de 1970 y una fecha
+ *
+ * @param  anio     Anio completo
+ * @param  mes      Mes del anio, de 1 a 12
+ * @param  dia      Dia del mes, de 1 a 31
+ * @return int32_t  Dias desde el 1 de enero de 1970, negativo para fechas anteriores
+ */
+int32_t CalendarDaysFromCivil(int32_t anio, uint32_t mes, uint32_t dia);
+
+/**
+ * @brief Calcula la fecha correspondiente a una cantidad de dias desde el 1 de enero de 1970
+ *
+ * @param  dias     Dias desde el 1 de enero de 1970
+ * @param  fecha    Puntero a la estructura donde se devuelve la fecha
+ */
+void CalendarCivilFromDays(int32_t dias, fecha_t * fecha);
+
+/**
+ * @brief Calcula el dia de la semana de una cantidad de dias desde el 1 de enero de 1970
+ *
+ * @param  dias     Dias desde el 1 de enero de 1970
+ * @return uint8_t  Dia de la semana, 0 para domingo hasta 6 para sabado
+ */
+uint8_t CalendarWeekday(int32_t dias);
+
+/**
+ * @brief Verifica que una fecha exista en el calendario
+ *
+ * @param  fecha    Puntero a la fecha a verificar
+ * @return true     La fecha es valida
+ * @return false    El mes o el dia estan fuera de rango
+ */
+bool CalendarIsValid(const fecha_t * fecha);
+
+/**
+ * @brief Calcula el desplazamiento de horario de verano vigente en un instante de hora estandar
+ *
+ * @param  regla     Regla de horario de verano a aplicar
+ * @param  dias      Dias desde el 1 de enero de 1970, en hora estandar local
+ * @param  segundos  Segundos desde la medianoche, en hora estandar local
+ * @param  siguiente Puntero donde se devuelven los segundos que faltan para el proximo cambio,
+ *                   o cero si la regla no tiene cambios. Puede ser NULL.
+ * @return int32_t   Segundos que se suman a la hora estandar para obtener la hora local
+ */
+int32_t CalendarDstOffset(dst_regla_t regla, int32_t dias, uint32_t segundos, uint32_t * siguiente);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* CALENDARIO_H */
@@ -0,0 +1,138 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef CARGA_H
+#define CARGA_H
+
+/** \brief Medicion de la carga del procesador
+ **
+ ** Calcula el uso del procesador de cada tarea a partir del tiempo de ejecucion acumulado que lleva
+ ** el sistema operativo. Cada muestra cierra una ventana de medicion; los porcentajes corresponden
+ ** a la ultima ventana y el pico a la ventana de mayor carga desde que se creo la medicion.
+ **
+ ** El informe es una linea de texto con el formato
+ ** `$C,<ventana>,<carga>,<pico>,<perdidos>,<tarea>,<uso>,<tarea>,<uso>...`, donde la ventana se
+ ** expresa en unidades del contador, la carga, el pico y el uso de cada tarea en decimas de por
+ ** ciento, y los perdidos son los eventos que la plataforma no pudo entregar a la aplicacion porque
+ ** la tarea no alcanzaba a atenderlos.
+ **
+ ** \addtogroup carga Carga
+ ** \brief Medicion de la carga del procesador
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/* === Public data type declarations =========================================================== */
+
+//! Descriptor de la medicion de carga
+typedef struct carga_s * carga_t;
+
+//! Tiempo de ejecucion de una tarea tal como lo informa el sistema operativo
+typedef struct carga_muestra_s {
+    const char * nombre; //!< Nombre de la tarea, debe seguir siendo valido hasta la proxima muestra
+    uint32_t numero;    //!< Numero que identifica a la tarea de una ventana a otra
+    uint32_t tiempo;    //!< Tiempo de ejecucion acumulado, en unidades del contador
+    bool inactiva;       //!< Bandera que indica si es la tarea inactiva del sistema operativo
+} const * carga_muestra_t;
+
+//! Resultado de la ultima ventana de medicion
+typedef struct carga_estado_s {
+    uint32_t ventanas;     //!< Cantidad de ventanas medidas
+    uint32_t ventana;      //!< Duracion de la ultima ventana, en unidades del contador
+    uint16_t carga;        //!< Tiempo ocupado en la ultima ventana, en decimas de por ciento
+    uint16_t inactivo;     //!< Tiempo de la tarea inactiva en la ultima ventana, en decimas de por ciento
+    uint16_t pico;         //!< Carga de la ventana mas ocupada, en decimas de por ciento
+    uint32_t ventana_pico; //!< Numero de la ventana mas ocupada, contando desde cero
+    uint32_t perdidos;     //!< Eventos perdidos por la plataforma hasta la ultima ventana
+} * carga_estado_t;
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Crea una medicion de carga
+ *
+ * @return carga_t Puntero al descriptor de la medicion, o NULL si no quedan descriptores libres
+ */
+carga_t LoadCreate(void);
+
+/**
+ * @brief Cierra una ventana de medicion con el tiempo de ejecucion actual de las tareas
+ *
+ * Las tareas se reconocen por su numero. Las que no aparecen en la muestra se consideran borradas
+ * y las nuevas se miden desde que se crearon, por lo que los contadores deben empezar en cero.
+ *
+ * @param  carga    Puntero al descriptor de la medicion
+ * @param  muestras Vector con el tiempo de ejecucion de cada tarea
+ * @param  cantidad Cantidad de elementos del vector
+ * @param  total    Valor actual del contador con el que se mide el tiempo de ejecucion
+ */
+void LoadSample(carga_t carga, carga_muestra_t muestras, uint8_t cantidad, uint32_t total);
+
+/**
+ * @brief Registra la cantidad de eventos que la plataforma perdio hasta el cierre de la ventana
+ *
+ * @param  carga    Puntero al descriptor de la medicion
+ * @param  perdidos Cantidad total de eventos perdidos desde el arranque
+ */
+void LoadSetLostEvents(carga_t carga, uint32_t perdidos);
+
+/**
+ * @brief Consulta el resultado de la ultima ventana de medicion
+ *
+ * @param  carga    Puntero al descriptor de la medicion
+ * @param  estado   Puntero a la estructura donde se devuelve el resultado
+ */
+void LoadGetStatus(carga_t carga, carga_estado_t estado);
+
+/**
+ * @brief Escribe el informe de la ultima ventana como una linea de texto terminada en fin de linea
+ *
+ * Las tareas que no entran completas en el espacio disponible se omiten del informe.
+ *
+ * @param  carga    Puntero al descriptor de la medicion
+ * @param  texto    Puntero al espacio donde se escribe el informe, no se termina con un cero
+ * @param  tamano   Cantidad de caracteres disponibles
+ * @return uint16_t Cantidad de caracteres escritos, cero si no entra ni el encabezado
+ */
+uint16_t LoadReport(carga_t carga, char * texto, uint16_t tamano);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* CARGA_H */
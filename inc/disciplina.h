@@ -0,0 +1,118 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef DISCIPLINA_H
+#define DISCIPLINA_H
+
+/** \brief Disciplina del reloj contra una referencia de tiempo externa
+ **
+ ** Recibe mensajes con la hora de una referencia externa, estima el desfase y el error de frecuencia
+ ** del reloj y los corrige en forma gradual a traves del acumulador de fase de los tics. Solo las
+ ** diferencias mayores a medio segundo se corrigen de un salto.
+ **
+ ** Cada mensaje es una linea de texto con el formato `$T,<segundos>,<microsegundos>`, donde los
+ ** segundos se cuentan desde el 1 de enero de 2000 en la hora estandar del reloj.
+ **
+ ** \addtogroup disciplina Disciplina
+ ** \brief Disciplina del reloj contra una referencia externa
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include "reloj.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/* === Public data type declarations =========================================================== */
+
+//! Descriptor de la disciplina de un reloj
+typedef struct disciplina_s * disciplina_t;
+
+//! Estado de la disciplina del reloj
+typedef struct disciplina_estado_s {
+    int32_t desfase;    //!< Ultimo desfase medido contra la referencia, en microsegundos
+    int32_t frecuencia; //!< Correccion de frecuencia que compensa la deriva del reloj, en partes por mil millones
+    uint32_t jitter;    //!< Variacion promedio del desfase entre mensajes, en microsegundos
+    uint32_t saltos;    //!< Cantidad de veces que la hora se corrigio de un salto
+    bool sincronizado;  //!< Bandera que indica si el reloj sigue a la referencia
+} * disciplina_estado_t;
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Crea la disciplina de un reloj contra una referencia externa
+ *
+ * @param  reloj        Puntero al descriptor del reloj que se corrige
+ * @return disciplina_t Puntero al descriptor de la disciplina, o NULL si no quedan descriptores libres
+ */
+disciplina_t DisciplineCreate(clock_t reloj);
+
+/**
+ * @brief Procesa los datos recibidos desde la referencia
+ *
+ * La hora de cada mensaje se compara con la del reloj en el momento en que se recibe el fin de
+ * linea, por lo que los datos deben entregarse apenas se reciben.
+ *
+ * @param  disciplina Puntero al descriptor de la disciplina
+ * @param  datos      Puntero a los datos recibidos
+ * @param  cantidad   Cantidad de datos recibidos
+ * @return true       Se completo y proceso al menos un mensaje de la referencia
+ */
+bool DisciplineReceive(disciplina_t disciplina, const char * datos, uint16_t cantidad);
+
+/**
+ * @brief Procesa una hora de la referencia tomada en este momento
+ *
+ * @param  disciplina   Puntero al descriptor de la disciplina
+ * @param  segundos     Segundos desde el 1 de enero de 2000 en la hora estandar de la referencia
+ * @param  microsegundos Fraccion del segundo de la referencia, en microsegundos
+ * @return true         La muestra se uso para corregir el reloj
+ * @return false        La muestra se descarto por ser un pico aislado
+ */
+bool DisciplineSample(disciplina_t disciplina, uint32_t segundos, uint32_t microsegundos);
+
+/**
+ * @brief Consulta el estado de la disciplina del reloj
+ *
+ * @param  disciplina Puntero al descriptor de la disciplina
+ * @param  estado     Puntero a la estructura donde se devuelve el estado
+ */
+void DisciplineGetStatus(disciplina_t disciplina, disciplina_estado_t estado);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* DISCIPLINA_H */
@@ -99,6 +99,36 @@ void DisplayWriteBCD(display_t display, uint8_t * number, uint8_t size);
  */
 void DisplayRefresh(display_t display);
 
+/**
+ * @brief Consulta durante cuantos refrescos la pantalla va a seguir completamente apagada
+ *
+ * La pantalla esta apagada cuando ningun digito tiene segmentos encendidos o cuando todos los que
+ * tienen estan en la mitad apagada del parpadeo.
+ *
+ * @param  display  Puntero al descriptor de la pantalla
+ * @return uint16_t Cantidad de refrescos que se pueden omitir, cero si hay algun digito encendido
+ */
+uint16_t DisplayDarkTime(display_t display);
+
+/**
+ * @brief Avanza la multiplexacion y el parpadeo como si se hubieran hecho los refrescos indicados
+ *
+ * Se usa al salir de un periodo de bajo consumo para que el parpadeo conserve su fase. No escribe en
+ * la pantalla, que debe haber quedado apagada.
+ *
+ * @param  display   Puntero al descriptor de la pantalla
+ * @param  refrescos Cantidad de refrescos omitidos
+ */
+void DisplaySkip(display_t display, uint16_t refrescos);
+
+/**
+ * @brief Obtiene la imagen que muestra la pantalla, con los digitos en la mitad apagada del parpadeo en cero
+ *
+ * @param  display  Puntero al descriptor de la pantalla
+ * @param  frame    Vector donde se copian los segmentos de cada digito, con tantos elementos como digitos
+ */
+void DisplayGetFrame(display_t display, uint8_t * frame);
+
 void DisplayFlashDigits(display_t display, uint8_t from, uint8_t to, uint16_t frecuency);
 
 void DisplayToggleDot(display_t display, uint8_t position);
@@ -0,0 +1,86 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef INFORME_H
+#define INFORME_H
+
+/** \brief Armado de los informes de texto
+ **
+ ** Funciones para escribir los campos de una linea de informe en un espacio de tamano fijo, sin usar
+ ** la biblioteca de formato. Cuando un campo no entra la funcion devuelve falso, y quien arma el
+ ** informe vuelve a la posicion del ultimo campo completo para descartarlo.
+ **
+ ** \addtogroup informe Informe
+ ** \brief Armado de los informes de texto
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/* === Public data type declarations =========================================================== */
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Agrega un texto al informe
+ *
+ * @param  texto    Puntero al espacio donde se escribe el informe
+ * @param  posicion Puntero a la posicion donde se escribe, se avanza con lo escrito
+ * @param  tamano   Cantidad de caracteres disponibles
+ * @param  valor    Texto terminado en cero que se agrega
+ * @return true     El texto se agrego completo
+ * @return false    El texto no entra, se escribe solo la parte que entra
+ */
+bool ReportAppend(char * texto, uint16_t * posicion, uint16_t tamano, const char * valor);
+
+/**
+ * @brief Agrega un numero sin signo en decimal al informe
+ *
+ * @param  texto    Puntero al espacio donde se escribe el informe
+ * @param  posicion Puntero a la posicion donde se escribe, se avanza con lo escrito
+ * @param  tamano   Cantidad de caracteres disponibles
+ * @param  valor    Numero que se agrega
+ * @return true     El numero se agrego completo
+ * @return false    El numero no entra, no se escribe nada
+ */
+bool ReportAppendNumber(char * texto, uint16_t * posicion, uint16_t tamano, uint32_t valor);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* INFORME_H */
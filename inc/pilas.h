@@ -0,0 +1,126 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef PILAS_H
+#define PILAS_H
+
+/** \brief Monitor del uso de las pilas de las tareas
+ **
+ ** Registra el menor espacio libre que tuvo la pila de cada tarea a lo largo de una ejecucion y
+ ** recomienda un tamano con un margen de seguridad sobre el uso medido. Los tamanos se expresan en
+ ** las mismas unidades que informa el sistema operativo, palabras de la pila en FreeRTOS.
+ **
+ ** El informe es una linea de texto con el formato
+ ** `$S,<tarea>,<tamano>,<usado>,<recomendado>,<tarea>,<tamano>,<usado>,<recomendado>...`.
+ **
+ ** \addtogroup pilas Pilas
+ ** \brief Monitor del uso de las pilas de las tareas
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/* === Public data type declarations =========================================================== */
+
+//! Descriptor del monitor de pilas
+typedef struct pilas_s * pilas_t;
+
+//! Espacio libre en la pila de una tarea tal como lo informa el sistema operativo
+typedef struct pila_muestra_s {
+    const char * nombre; //!< Nombre de la tarea, debe seguir siendo valido mientras se use el monitor
+    uint32_t numero;     //!< Numero que identifica a la tarea de una muestra a otra
+    uint32_t tamano;     //!< Tamano de la pila de la tarea
+    uint32_t libre;      //!< Menor espacio libre que tuvo la pila desde que se creo la tarea
+} const * pila_muestra_t;
+
+//! Uso medido y tamano recomendado para la pila de una tarea
+typedef struct pila_estado_s {
+    const char * nombre;  //!< Nombre de la tarea
+    uint32_t tamano;      //!< Tamano actual de la pila
+    uint32_t usado;       //!< Mayor uso registrado de la pila
+    uint32_t recomendado; //!< Tamano recomendado, el uso mas el margen redondeado hacia arriba
+} * pila_estado_t;
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Crea un monitor de pilas
+ *
+ * @param  margen  Margen de seguridad sobre el mayor uso registrado, en por ciento
+ * @return pilas_t Puntero al descriptor del monitor, o NULL si no quedan descriptores libres
+ */
+pilas_t StackMonitorCreate(uint8_t margen);
+
+/**
+ * @brief Registra el espacio libre actual de las pilas de las tareas
+ *
+ * Las tareas se reconocen por su numero y conservan el peor caso de todas las muestras, aunque
+ * dejen de aparecer. Las tareas que no entran en el monitor se descartan.
+ *
+ * @param  pilas    Puntero al descriptor del monitor
+ * @param  muestras Vector con el espacio libre de la pila de cada tarea
+ * @param  cantidad Cantidad de elementos del vector
+ */
+void StackMonitorSample(pilas_t pilas, pila_muestra_t muestras, uint8_t cantidad);
+
+/**
+ * @brief Consulta el uso registrado de la pila de una tarea
+ *
+ * @param  pilas    Puntero al descriptor del monitor
+ * @param  indice   Posicion de la tarea en el monitor, en el orden en que aparecieron
+ * @param  estado   Puntero a la estructura donde se devuelve el uso de la pila
+ * @return true     La posicion corresponde a una tarea registrada
+ */
+bool StackMonitorGetTask(pilas_t pilas, uint8_t indice, pila_estado_t estado);
+
+/**
+ * @brief Escribe el informe de las pilas como una linea de texto terminada en fin de linea
+ *
+ * Las tareas que no entran completas en el espacio disponible se omiten del informe.
+ *
+ * @param  pilas    Puntero al descriptor del monitor
+ * @param  texto    Puntero al espacio donde se escribe el informe, no se termina con un cero
+ * @param  tamano   Cantidad de caracteres disponibles
+ * @return uint16_t Cantidad de caracteres escritos, cero si no entra ni el encabezado
+ */
+uint16_t StackMonitorReport(pilas_t pilas, char * texto, uint16_t tamano);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* PILAS_H */
@@ -31,6 +31,7 @@ SPDX-License-Identifier: MIT
  ** @{ */
 
 /* === Headers files inclusions ================================================================ */
+#include "calendario.h"
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -48,19 +49,193 @@ typedef struct clock_s * clock_t;
 
 typedef void (*alarm_notification_t)(bool status);
 
+//! Descriptor de un evento diferido programado en un reloj
+typedef struct clock_event_s * clock_event_t;
+
+//! Funcion que se llama al vencer un evento diferido
+typedef void (*clock_event_handler_t)(clock_t reloj, void * objeto);
+
 /* === Public variable declarations ============================================================ */
 
 /* === Public function declarations ============================================================ */
 
+/**
+ * @brief Crea un reloj tomando un descriptor libre de la reserva de CLOCK_INSTANCES relojes
+ *
+ * Todos los relojes comparten una misma base de tiempo monotona, por lo que deben crearse con la
+ * misma cantidad de tics por segundo. Cada reloj mantiene su propia hora, alarma y horario de verano
+ * como un desfase sobre esa base.
+ *
+ * @param  tics_por_segundo Cantidad de llamadas a ClockUpdate que forman un segundo
+ * @param  enable_alarm     Funcion para notificar los cambios en el estado de la alarma
+ * @return clock_t          Puntero al descriptor del reloj, o NULL si no quedan descriptores libres o
+ *                          la cantidad de tics por segundo no coincide con la de la base de tiempo
+ */
 clock_t ClockCreate(int tics_por_segundo, alarm_notification_t enable_alarm);
+
+/**
+ * @brief Libera un reloj para que su descriptor pueda volver a usarse con ClockCreate
+ *
+ * Se cancelan los eventos diferidos que el reloj tenia programados, incluida la postergacion de la
+ * alarma. Los relojes que lo seguian con ClockSetZone conservan su hora como hora propia.
+ *
+ * @param  reloj Puntero al descriptor del reloj, no debe usarse despues de la llamada
+ */
+void ClockDestroy(clock_t reloj);
+
 bool ClockGetTime(clock_t reloj, uint8_t * hora, int size);
 bool ClockSetTime(clock_t reloj, const uint8_t * hora, int size);
+
+/**
+ * @brief Hace que un reloj siga la hora de otro con un desplazamiento fijo, como en una zona horaria
+ *
+ * Al cambiar la hora del reloj de referencia cambia tambien la del reloj que lo sigue. Cambiar la hora
+ * del reloj que sigue solo modifica su desplazamiento. Cada reloj conserva su regla de horario de verano.
+ *
+ * @param  reloj          Puntero al descriptor del reloj que sigue a la referencia
+ * @param  referencia     Puntero al descriptor del reloj de referencia
+ * @param  desplazamiento Segundos que se suman a la hora estandar de la referencia
+ */
+void ClockSetZone(clock_t reloj, clock_t referencia, int32_t desplazamiento);
+
+/**
+ * @brief Avanza un tic la base de tiempo compartida por todos los relojes
+ *
+ * Basta una sola llamada por tic para actualizar todos los relojes creados, sin importar con cual de
+ * ellos se realice. Solo se revisan las alarmas de cada reloj cuando vence alguno de sus plazos.
+ *
+ * @param  reloj Puntero al descriptor de cualquiera de los relojes
+ * @return true  Si el tic pertenece a la segunda mitad del segundo actual
+ */
 bool ClockUpdate(clock_t reloj);
+
+/**
+ * @brief Avanza la base de tiempo de todos los relojes una cantidad arbitraria de tics en tiempo constante
+ *
+ * Permite recuperar los tics perdidos durante un periodo de bajo consumo o cuando la tarea que
+ * llama a ClockUpdate fue demorada. Las alarmas y postergaciones cuyo vencimiento quedo dentro
+ * del intervalo se notifican una sola vez al terminar el avance.
+ *
+ * @param  reloj    Puntero al descriptor del reloj
+ * @param  tics     Cantidad de tics transcurridos
+ * @return uint32_t Cantidad de vencimientos que ocurrieron antes del final del intervalo y por lo
+ *                  tanto se notificaron con demora
+ */
+uint32_t ClockAdvance(clock_t reloj, uint32_t tics);
+
+/**
+ * @brief Consulta cuantos tics pueden pasar hasta el proximo cambio de medio segundo
+ *
+ * Mientras no cambia el medio segundo tampoco vencen alarmas ni eventos, por lo que se puede reemplazar
+ * esa cantidad de llamadas a ClockUpdate por una sola llamada a ClockAdvance sin que nada se demore.
+ * El tic en el que se produce el cambio esta incluido en la cuenta.
+ *
+ * @param  reloj    Puntero al descriptor de cualquiera de los relojes
+ * @return uint32_t Cantidad de tics hasta el proximo cambio, inclusive
+ */
+uint32_t ClockTicsToHalfSecond(clock_t reloj);
+
+/**
+ * @brief Corrige la frecuencia de la base de tiempo sin saltos en la hora
+ *
+ * La correccion se acumula en cada tic como una fraccion de tic, por lo que la hora avanza o se
+ * atrasa de forma gradual. Afecta a todos los relojes porque comparten la misma base de tiempo.
+ *
+ * @param  reloj      Puntero al descriptor de cualquiera de los relojes
+ * @param  correccion Correccion de frecuencia en partes por mil millones, positiva para adelantar
+ */
+void ClockSetRate(clock_t reloj, int32_t correccion);
+
+/**
+ * @brief Consulta la hora estandar del reloj con resolucion menor a un segundo
+ *
+ * @param  reloj    Puntero al descriptor del reloj
+ * @param  fraccion Puntero donde se devuelve la fraccion del segundo actual, en unidades de 2^-32 segundos
+ * @return uint32_t Segundos desde el 1 de enero de 2000 en la hora estandar del reloj, sin horario de verano
+ */
+uint32_t ClockGetStamp(clock_t reloj, uint32_t * fraccion);
+
+/**
+ * @brief Corrige la hora del reloj de un salto, para diferencias demasiado grandes para corregir en forma gradual
+ *
+ * La hora queda valida, como al configurarla con ClockSetTime, porque el salto la toma de una referencia.
+ *
+ * @param  reloj    Puntero al descriptor del reloj
+ * @param  ajuste   Segundos que se suman a la hora, en formato de punto fijo con 32 bits de fraccion
+ */
+void ClockStep(clock_t reloj, int64_t ajuste);
+
+/**
+ * @brief Consulta la fecha actual del reloj
+ *
+ * @param  reloj    Puntero al descriptor del reloj
+ * @param  fecha    Puntero a la estructura donde se devuelve la fecha
+ * @return true     La hora del reloj fue configurada
+ * @return false    La hora del reloj no fue configurada y la fecha no es confiable
+ */
+bool ClockGetDate(clock_t reloj, fecha_t * fecha);
+
+/**
+ * @brief Cambia la fecha del reloj manteniendo la hora del dia
+ *
+ * @param  reloj    Puntero al descriptor del reloj
+ * @param  fecha    Puntero a la fecha a configurar, entre los anios 2000 y 2135
+ * @return true     La fecha es valida y fue configurada
+ * @return false    La fecha no existe o esta fuera del rango del reloj
+ */
+bool ClockSetDate(clock_t reloj, const fecha_t * fecha);
+
+/**
+ * @brief Consulta el dia de la semana de la fecha actual del reloj
+ *
+ * @param  reloj    Puntero al descriptor del reloj
+ * @return uint8_t  Dia de la semana, 0 para domingo hasta 6 para sabado
+ */
+uint8_t ClockGetWeekday(clock_t reloj);
+
+/**
+ * @brief Selecciona la regla de horario de verano que aplica el reloj
+ *
+ * @param  reloj    Puntero al descriptor del reloj
+ * @param  regla    Regla de la tabla de horarios de verano, o DST_NINGUNO para desactivarlo
+ */
+void ClockSetDst(clock_t reloj, dst_regla_t regla);
 void AlarmGetTime(clock_t reloj, uint8_t * hora, int size);
 void AlarmSetTime(clock_t reloj, const uint8_t * hora, int size);
 void ActivateAlarm(clock_t reloj, bool status);
+
+/**
+ * @brief Define los dias de la semana en que suena la alarma
+ *
+ * @param  reloj    Puntero al descriptor del reloj
+ * @param  dias     Mascara de dias habilitados, el bit 0 es el domingo y el bit 6 el sabado
+ */
+void AlarmSetWeekdays(clock_t reloj, uint8_t dias);
 void ExtendAlarm(clock_t reloj, int minutos);
 void DisableAlarm(clock_t reloj);
+
+/**
+ * @brief Programa un evento diferido para recordatorios, tiempos de espera o postergaciones
+ *
+ * Los eventos de todos los relojes se ordenan en una rueda jerarquica de tiempos, por lo que programar,
+ * cancelar y vencer un evento lleva tiempo constante y no se realiza ningun trabajo mientras no se acerca
+ * un vencimiento. La cantidad de eventos simultaneos esta limitada por CLOCK_EVENTS.
+ *
+ * @param  reloj         Puntero al descriptor del reloj al que pertenece el evento
+ * @param  segundos      Segundos hasta el vencimiento, cero se toma como el proximo segundo
+ * @param  handler       Funcion que se llama al vencer el evento
+ * @param  objeto        Parametro que se entrega a la funcion al vencer el evento
+ * @return clock_event_t Descriptor del evento, valido hasta que vence o se cancela, o NULL si no quedan
+ *                       eventos libres
+ */
+clock_event_t ClockScheduleEvent(clock_t reloj, uint32_t segundos, clock_event_handler_t handler, void * objeto);
+
+/**
+ * @brief Cancela un evento diferido que todavia no vencio
+ *
+ * @param  evento Descriptor del evento devuelto por ClockScheduleEvent
+ */
+void ClockCancelEvent(clock_event_t evento);
 bool AlarmGetState(clock_t reloj);
 
 /* === End of documentation ==================================================================== */
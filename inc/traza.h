@@ -0,0 +1,167 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef TRAZA_H
+#define TRAZA_H
+
+/** \brief Grabacion de las entradas y la pantalla
+ **
+ ** Registra cada cambio en las entradas y en la imagen de la pantalla junto con el tic en el que
+ ** ocurrio, para poder repetir una ejecucion con la misma secuencia de entradas y comparar lo que se
+ ** muestra. Los tics no se graban uno por uno sino como la distancia al registro anterior.
+ **
+ ** Cada registro empieza con un numero de longitud variable (siete bits por byte, el bit mas alto
+ ** indica que sigue otro byte) que lleva la distancia en tics en los bits altos y el tipo en los dos
+ ** bits bajos. El primer registro es el de inicio, con la version del formato y la cantidad de
+ ** digitos, y el ultimo el de fin. Un registro de entradas tiene un byte con una entrada por bit y
+ ** uno de pantalla un byte por digito. Como el tic se lleva con 64 bits una grabacion puede durar
+ ** semanas, y un intervalo sin cambios de un dia completo ocupa cinco bytes.
+ **
+ ** \addtogroup traza Traza
+ ** \brief Grabacion de las entradas y la pantalla
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+//! Version del formato que se escribe en el registro de inicio
+#define TRACE_VERSION 1
+
+//! Cantidad maxima de digitos de la pantalla que se pueden grabar
+#define TRACE_MAX_DIGITS 8
+
+/* === Public data type declarations =========================================================== */
+
+//! Descriptor de una grabacion
+typedef struct traza_s * traza_t;
+
+//! Funcion que recibe los bytes codificados, se llama una vez por registro desde el tic
+typedef void (*traza_escribir_t)(void * objeto, const uint8_t * datos, uint16_t cantidad);
+
+//! Tipos de registro de la grabacion
+typedef enum traza_tipo_e {
+    TRAZA_ENTRADAS = 0, //!< Nuevo estado de las entradas
+    TRAZA_PANTALLA = 1, //!< Nueva imagen de la pantalla
+    TRAZA_FIN = 2,      //!< Fin de la grabacion
+    TRAZA_INICIO = 3,   //!< Inicio de la grabacion
+} traza_tipo_t;
+
+//! Registro leido de una grabacion
+typedef struct traza_registro_s {
+    traza_tipo_t tipo;               //!< Tipo de registro
+    uint64_t tic;                    //!< Tic en el que ocurrio, contando desde el inicio de la grabacion
+    uint8_t datos[TRACE_MAX_DIGITS]; //!< Estado de las entradas o segmentos de cada digito
+} * traza_registro_t;
+
+//! Lector de una grabacion guardada en memoria
+typedef struct traza_lector_s {
+    const uint8_t * datos; //!< Bytes de la grabacion
+    uint32_t tamano;       //!< Cantidad de bytes de la grabacion
+    uint32_t posicion;     //!< Posicion del proximo registro
+    uint64_t tic;          //!< Tic del ultimo registro leido
+    uint8_t digitos;       //!< Cantidad de digitos de la pantalla grabada
+} * traza_lector_t;
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Crea una grabacion y escribe el registro de inicio
+ *
+ * @param  digitos  Cantidad de digitos de la pantalla, como maximo TRACE_MAX_DIGITS
+ * @param  escribir Funcion que recibe los bytes de cada registro
+ * @param  objeto   Puntero que se pasa sin cambios a la funcion de escritura
+ * @return traza_t  Puntero al descriptor de la grabacion, o NULL si no quedan descriptores libres
+ */
+traza_t TraceCreate(uint8_t digitos, traza_escribir_t escribir, void * objeto);
+
+/**
+ * @brief Avanza el tiempo de la grabacion
+ *
+ * @param  traza    Puntero al descriptor de la grabacion
+ * @param  tics     Cantidad de tics transcurridos
+ */
+void TraceTick(traza_t traza, uint32_t tics);
+
+/**
+ * @brief Graba el estado de las entradas si cambio desde el ultimo registro
+ *
+ * @param  traza    Puntero al descriptor de la grabacion
+ * @param  entradas Estado de las entradas, una por bit
+ */
+void TraceInputs(traza_t traza, uint8_t entradas);
+
+/**
+ * @brief Graba la imagen de la pantalla si cambio desde el ultimo registro
+ *
+ * @param  traza    Puntero al descriptor de la grabacion
+ * @param  pantalla Segmentos encendidos en cada digito
+ */
+void TraceFrame(traza_t traza, const uint8_t * pantalla);
+
+/**
+ * @brief Escribe el registro de fin y libera el descriptor
+ *
+ * @param  traza    Puntero al descriptor de la grabacion
+ */
+void TraceClose(traza_t traza);
+
+/**
+ * @brief Prepara la lectura de una grabacion guardada en memoria
+ *
+ * @param  lector   Puntero al lector que se inicializa
+ * @param  datos    Bytes de la grabacion, deben seguir siendo validos mientras se lee
+ * @param  tamano   Cantidad de bytes de la grabacion
+ * @return true     El registro de inicio es valido y la version es conocida
+ * @return false    Los datos no son una grabacion que se pueda leer
+ */
+bool TraceOpen(traza_lector_t lector, const uint8_t * datos, uint32_t tamano);
+
+/**
+ * @brief Lee el proximo registro de la grabacion
+ *
+ * @param  lector   Puntero al lector
+ * @param  registro Puntero a la estructura donde se devuelve el registro
+ * @return true     Se leyo un registro completo
+ * @return false    Se termino la grabacion o el registro esta incompleto
+ */
+bool TraceRead(traza_lector_t lector, traza_registro_t registro);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* TRAZA_H */
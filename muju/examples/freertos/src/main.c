@@ -263,6 +263,10 @@ int main(void) {
     xTaskCreate(ToggleTask, "ToogleLed", 256, (void *)board, tskIDLE_PRIORITY + 1, NULL);
     xTaskCreate(SwitchTask, "SwitchLed", 256, (void *)board, tskIDLE_PRIORITY + 1, NULL);
 
+#ifdef HAL_EVENT_DEFERRED
+    /* Con eventos diferidos los manejadores se ejecutan en esta tarea y no dentro de las interrupciones */
+    HalEventStartTask(tskIDLE_PRIORITY + 3);
+#endif
     SciSetEventHandler(board->console, ConsoleEvent, (void *)board);
     GpioSetEventHandler(board->tec_4, KeyEvent, (void *)board, true, true);
 
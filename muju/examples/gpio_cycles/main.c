@@ -0,0 +1,244 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** @file
+ ** @brief Cycle count comparison of the gpio functions and the gpio fast path
+ **
+ ** Each way to change an output is repeated many times between two reads of the cycle counter of the
+ ** core, the cost of the empty loop is subtracted and the average is sent through the console in tenths
+ ** of a cycle. The measurement is repeated every second.
+ **
+ ** @addtogroup sample-gpio-cycles GPIO Cycles Sample
+ ** @ingroup samples
+ ** @brief Samples applications with MUJU Framwork
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "board.h"
+#include "hal.h"
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+#ifdef EDU_CIAA_NXP
+#define MEASURED_OUTPUT      HAL_GPIO0_14      /**< Gpio output of the led 1 on board, changed on every measurement */
+#define MEASURED_OUTPUT_FAST HAL_GPIO0_14_FAST /**< Port and bit of the measured output for the fast path */
+#elif BLUE_PILL
+#define MEASURED_OUTPUT      HAL_GPIO_PB9      /**< Gpio output of the led 2 on board, changed on every measurement */
+#define MEASURED_OUTPUT_FAST HAL_GPIO_PB9_FAST /**< Port and bit of the measured output for the fast path */
+#else
+#error "This program does not have support for the selected board"
+#endif
+
+/**
+ * @brief Number of times each operation is repeated between two reads of the cycle counter
+ */
+#define REPETITIONS 1000
+
+/**
+ * @brief Macro to measure the average cost of a statement and send it through the console
+ */
+#define MEASURE(console, name, statement)                                                          \
+    do {                                                                                           \
+        uint32_t start = DWT->CYCCNT;                                                              \
+        for (uint32_t index = 0; index < REPETITIONS; index++) {                                   \
+            statement;                                                                             \
+        }                                                                                          \
+        SendResult(console, name, DWT->CYCCNT - start);                                            \
+    } while (0)
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/**
+ * @brief Function to initialize the board, the measured output and the console
+ *
+ * @return  hal_sci_t  Pointer to structure with the serial port used as console
+ */
+static hal_sci_t BoardCreate(void);
+
+/**
+ * @brief Function to handle system timer events
+ *
+ * @param  object   Pointer to boolean variable to signal to main loop a new tick
+ */
+static void TickEvent(void * object);
+
+/**
+ * @brief Function to make a blocking sending of a string through the serial port used as console
+ *
+ * @param  console  Pointer to structure with descriptor of serial port used as console
+ * @param  message  Pointer to string to send by serial port used as console
+ */
+static void ConsoleSend(hal_sci_t console, char const * message);
+
+/**
+ * @brief Function to send the average cost of an operation through the console
+ *
+ * @param  console  Pointer to structure with descriptor of serial port used as console
+ * @param  name     Pointer to string with the name of the measured operation
+ * @param  cycles   Cycles elapsed on all the repetitions of the operation, with the loop
+ */
+static void SendResult(hal_sci_t console, char const * name, uint32_t cycles);
+
+/**
+ * @brief Function to measure and send the cost of every way to change the measured output
+ *
+ * @param  console  Pointer to structure with descriptor of serial port used as console
+ */
+static void MeasureAll(hal_sci_t console);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/**
+ * @brief Cycles elapsed on the repetitions of an empty loop, subtracted from every measurement
+ */
+static uint32_t loop_cycles = 0;
+
+/* === Private function implementation ========================================================= */
+
+static hal_sci_t BoardCreate(void) {
+    static const struct hal_sci_line_s console_config = {
+        .baud_rate = 115200,
+        .data_bits = 8,
+        .parity = HAL_SCI_NO_PARITY,
+    };
+    struct hal_sci_pins_s console_pins = {0};
+    hal_sci_t console;
+
+#ifdef EDU_CIAA_NXP
+    console = HAL_SCI_USART2;
+    console_pins.txd_pin = HAL_PIN_P7_1;
+    console_pins.rxd_pin = HAL_PIN_P7_2;
+#elif BLUE_PILL
+    console = HAL_SCI_USART1;
+    console_pins.txd_pin = HAL_PIN_PA9;
+    console_pins.rxd_pin = HAL_PIN_PA10;
+#endif
+    BoardSetup();
+
+    GpioSetDirection(MEASURED_OUTPUT, true);
+    SciSetConfig(console, &console_config, &console_pins);
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    return console;
+}
+
+static void TickEvent(void * object) {
+    *((bool *)object) = true;
+}
+
+static void ConsoleSend(hal_sci_t console, char const * message) {
+    uint8_t pending = strlen(message);
+    uint8_t sended;
+
+    while (pending) {
+        sended = SciSendData(console, message, pending);
+        message += sended;
+        pending -= sended;
+    }
+}
+
+static void SendResult(hal_sci_t console, char const * name, uint32_t cycles) {
+    char text[12];
+    uint8_t position = sizeof(text) - 1;
+    uint32_t tenths = 0;
+
+    if (cycles > loop_cycles) {
+        tenths = ((cycles - loop_cycles) * 10 + REPETITIONS / 2) / REPETITIONS;
+    }
+
+    text[position] = 0;
+    text[--position] = '0' + tenths % 10;
+    text[--position] = '.';
+    do {
+        tenths = tenths / 10;
+        text[--position] = '0' + tenths % 10;
+    } while (tenths >= 10);
+
+    ConsoleSend(console, name);
+    ConsoleSend(console, &text[position]);
+    ConsoleSend(console, " cycles\n");
+}
+
+// The descriptor is kept in a variable so the functions receive it as the other modules do
+static void MeasureAll(hal_sci_t console) {
+    hal_gpio_bit_t output = MEASURED_OUTPUT;
+    hal_gpio_port_t port = GpioGetPort(output);
+    hal_gpio_mask_t mask = GpioGetMask(output);
+    uint32_t start;
+
+    start = DWT->CYCCNT;
+    for (uint32_t index = 0; index < REPETITIONS; index++) {
+        __asm volatile("");
+    }
+    loop_cycles = DWT->CYCCNT - start;
+
+    ConsoleSend(console, "\n");
+    MEASURE(console, "GpioSetState:      ", GpioSetState(output, true));
+    MEASURE(console, "GpioBitSet:        ", GpioBitSet(output));
+    MEASURE(console, "GpioPortSet:       ", GpioPortSet(port, mask));
+    MEASURE(console, "GPIO_FAST_SET:     ", GPIO_FAST_SET(MEASURED_OUTPUT));
+    MEASURE(console, "GPIO_FAST_WRITE:   ", GPIO_FAST_WRITE(MEASURED_OUTPUT, index & 1));
+    MEASURE(console, "GpioBitToogle:     ", GpioBitToogle(output));
+    MEASURE(console, "GPIO_FAST_TOGGLE:  ", GPIO_FAST_TOGGLE(MEASURED_OUTPUT));
+    MEASURE(console, "GpioGetState:      ", (void)GpioGetState(output));
+    MEASURE(console, "GPIO_FAST_GET:     ", (void)GPIO_FAST_GET(MEASURED_OUTPUT));
+}
+
+/* === Public function implementation ========================================================= */
+
+int main(void) {
+    int divisor = 0;
+    volatile bool new_tick = false;
+    hal_sci_t console = BoardCreate();
+
+    TickStart(TickEvent, (void *)&new_tick, 1000);
+
+    while (true) {
+        while (!new_tick) {
+            __asm("NOP");
+        }
+        new_tick = false;
+
+        divisor++;
+        if (divisor == 1000) {
+            divisor = 0;
+            MeasureAll(console);
+        }
+    }
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
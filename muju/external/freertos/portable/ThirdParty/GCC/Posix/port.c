@@ -95,6 +95,16 @@ static sigset_t xAllSignals;
 static sigset_t xSchedulerOriginalSignalMask;
 static pthread_t hMainThread = ( pthread_t )NULL;
 static volatile portBASE_TYPE uxCriticalNesting;
+
+/* Simulation speed and ticks counted since the scheduler was started, for
+ * pacing the simulated time and for the threads that report the speed. */
+static unsigned long ulTimeScale = portTIME_SCALE_REAL;
+static unsigned long long ullElapsedTicks = 0;
+static unsigned long long ullTicksAtLastSignal = 0;
+
+/* Set when a tick hook asks for a context switch, so the simulated time
+ * stops handling ticks and lets the task that was made ready run. */
+static volatile BaseType_t xSimulatedYield = pdFALSE;
 /*-----------------------------------------------------------*/
 
 static portBASE_TYPE xSchedulerEnd = pdFALSE;
@@ -109,6 +119,7 @@ static void prvSuspendSelf( Thread_t * thread);
 static void prvResumeThread( Thread_t * xThreadId );
 static void vPortSystemTickHandler( int sig );
 static void vPortStartFirstTask( void );
+static void prvWaitForSimulatedTick( void );
 /*-----------------------------------------------------------*/
 
 static void prvFatalError( const char *pcCall, int iErrno )
@@ -270,6 +281,8 @@ void vPortYieldFromISR( void )
 Thread_t *xThreadToSuspend;
 Thread_t *xThreadToResume;
 
+    xSimulatedYield = pdTRUE;
+
     xThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
 
     vTaskSwitchContext();
@@ -364,6 +377,49 @@ int iRet;
 }
 /*-----------------------------------------------------------*/
 
+void vPortSetTimeScale( unsigned long ulScale )
+{
+    ulTimeScale = ulScale;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulPortGetTimeScale( void )
+{
+    return ulTimeScale;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long long ullPortGetElapsedTicks( void )
+{
+    return __atomic_load_n( &ullElapsedTicks, __ATOMIC_RELAXED );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Waits until the wall clock, scaled by the simulation speed, reaches the
+ * time of the next tick. Late ticks are not waited for, so the simulation
+ * catches up after the tasks kept the idle thread busy.
+ */
+static void prvWaitForSimulatedTick( void )
+{
+uint64_t ullTickNs;
+struct timespec xWakeUp;
+
+    if( ulTimeScale == portTIME_SCALE_VIRTUAL )
+    {
+        return;
+    }
+
+    ullTickNs = prvStartTimeNs + ( ullElapsedTicks + 1 ) * portTICK_RATE_MICROSECONDS * 1000ull / ulTimeScale;
+    if( prvGetTimeNs() < ullTickNs )
+    {
+        xWakeUp.tv_sec = ullTickNs / 1000000000ull;
+        xWakeUp.tv_nsec = ullTickNs % 1000000000ull;
+        (void)clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &xWakeUp, NULL );
+    }
+}
+/*-----------------------------------------------------------*/
+
 static void vPortSystemTickHandler( int sig )
 {
 Thread_t *pxThreadToSuspend;
@@ -372,6 +428,24 @@ Thread_t *pxThreadToResume;
 
     uxCriticalNesting++; /* Signals are blocked in this signal handler. */
 
+    /* With the simulated time the timer only ticks when the idle thread is
+     * running and did not advance the time for a whole period. The tasks
+     * take no simulated time, so the order of the events does not depend
+     * on the wall clock. */
+    if( ulTimeScale != portTIME_SCALE_REAL )
+    {
+        if( ( ullTicksAtLastSignal != ullElapsedTicks )
+#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+            || ( xTaskGetCurrentTaskHandle() != xTaskGetIdleTaskHandle() )
+#endif
+          )
+        {
+            ullTicksAtLastSignal = ullElapsedTicks;
+            uxCriticalNesting--;
+            return;
+        }
+    }
+
 #if ( configUSE_PREEMPTION == 1 )
     pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
 #endif
@@ -384,6 +458,7 @@ Thread_t *pxThreadToResume;
  *        / (portTICK_RATE_MICROSECONDS * 1000);
  * do { */
         xTaskIncrementTick();
+        __atomic_fetch_add( &ullElapsedTicks, 1, __ATOMIC_RELAXED );
 /*        prvTickCount++;
  *    } while (prvTickCount < xExpectedTicks);
 */
@@ -401,6 +476,98 @@ Thread_t *pxThreadToResume;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+/*
+ * Emulates the tickless idle of the hardware ports. The tick timer is
+ * reprogrammed to expire at the end of the expected idle time and the
+ * idle thread waits for SIGALRM with all signals blocked, as a processor
+ * waits for an interrupt with interrupts disabled. The suppressed ticks
+ * are stepped and the signal is raised again for the last one, so it is
+ * handled as a normal tick when the signals are unblocked.
+ *
+ * Only the tick ends the sleep, the emulated peripherals run in their own
+ * threads and their events are attended when the idle thread wakes up.
+ *
+ * When the time is simulated faster than real time the ticks are handled
+ * here one after the other, with the scheduler still suspended so the
+ * kernel holds them pending, until the end of the idle period or until a
+ * tick hook makes a task ready. The timer keeps the real period and only
+ * advances the time when the idle thread could not sleep for a whole
+ * period, because a task has to wake up on the next tick.
+ */
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+struct itimerval itimer;
+sigset_t xTickSignal;
+uint64_t ulSleepMicroseconds;
+TickType_t xTicks;
+int iSignal;
+
+    vPortDisableInterrupts();
+
+    sigemptyset( &xTickSignal );
+    (void)getitimer( ITIMER_REAL, &itimer );
+    (void)sigpending( &xTickSignal );
+
+    /* A pending tick or a task made ready abort the sleep. */
+    if( ( sigismember( &xTickSignal, SIGALRM ) == 1 ) || ( eTaskConfirmSleepModeStatus() == eAbortSleep ) )
+    {
+        vPortEnableInterrupts();
+        return;
+    }
+
+    if( ulTimeScale != portTIME_SCALE_REAL )
+    {
+        /* Signals are blocked as in the tick handler. */
+        uxCriticalNesting++;
+        xSimulatedYield = pdFALSE;
+        xTicks = 0;
+        do
+        {
+            prvWaitForSimulatedTick();
+            xTaskIncrementTick();
+            __atomic_fetch_add( &ullElapsedTicks, 1, __ATOMIC_RELAXED );
+            xTicks++;
+        } while( ( xTicks < xExpectedIdleTime ) && ( xSimulatedYield == pdFALSE ) );
+        uxCriticalNesting--;
+
+        /* The signals are unblocked when the scheduler is resumed, after
+         * the tasks made ready by the hook have run. */
+        return;
+    }
+
+    if( xExpectedIdleTime > 1 )
+    {
+        /* Keep the part of the current tick period that has not elapsed
+         * yet, the timer goes back to the tick period after the expiry. */
+        ulSleepMicroseconds = itimer.it_value.tv_sec * 1000000ull + itimer.it_value.tv_usec;
+        ulSleepMicroseconds += ( xExpectedIdleTime - 1 ) * ( uint64_t ) portTICK_RATE_MICROSECONDS;
+
+        itimer.it_value.tv_sec = ulSleepMicroseconds / 1000000;
+        itimer.it_value.tv_usec = ulSleepMicroseconds % 1000000;
+        itimer.it_interval.tv_sec = 0;
+        itimer.it_interval.tv_usec = portTICK_RATE_MICROSECONDS;
+        (void)setitimer( ITIMER_REAL, &itimer, NULL );
+    }
+
+    sigemptyset( &xTickSignal );
+    sigaddset( &xTickSignal, SIGALRM );
+    (void)sigwait( &xTickSignal, &iSignal );
+
+    if( xExpectedIdleTime > 1 )
+    {
+        vTaskStepTick( xExpectedIdleTime - 1 );
+        __atomic_fetch_add( &ullElapsedTicks, xExpectedIdleTime - 1, __ATOMIC_RELAXED );
+    }
+    (void)pthread_kill( pthread_self(), SIGALRM );
+
+    vPortEnableInterrupts();
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TICKLESS_IDLE */
+
 void vPortThreadDying( void *pxTaskToDelete, volatile BaseType_t *pxPendYield )
 {
 Thread_t *pxThread = prvGetThreadFromTask( pxTaskToDelete );
@@ -525,7 +692,7 @@ int iRet;
      * will be unblocked.
      */
     (void)pthread_sigmask( SIG_SETMASK, &xAllSignals,
-                           *&xSchedulerOriginalSignalMask );
+                           &xSchedulerOriginalSignalMask );
 
     /* SIG_RESUME is only used with sigwait() so doesn't need a
        handler. */
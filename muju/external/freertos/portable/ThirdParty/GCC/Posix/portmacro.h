@@ -123,9 +123,33 @@ extern void vPortCancelThread( void *pxTaskToDelete );
  */
 #define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
 
+/* Tickless idle support, emulated by reprogramming the tick timer. */
+extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+#ifndef portSUPPRESS_TICKS_AND_SLEEP
+    #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+
+/* Simulation speed, must be set before the scheduler is started. With a
+ * scale other than real time the idle thread does not wait for the timer,
+ * it handles the ticks of the idle period one after the other until a task
+ * is made ready. With a scale of N the ticks are paced to run N times
+ * faster than real time, with portTIME_SCALE_VIRTUAL as fast as the host
+ * allows. */
+#define portTIME_SCALE_VIRTUAL  0
+#define portTIME_SCALE_REAL     1
+extern void vPortSetTimeScale( unsigned long ulScale );
+extern unsigned long ulPortGetTimeScale( void );
+
+/* Ticks elapsed since the scheduler was started, safe to read from threads
+ * that are not FreeRTOS tasks. */
+extern unsigned long long ullPortGetElapsedTicks( void );
+
+/* The application may provide its own run time counter in FreeRTOSConfig.h. */
 extern unsigned long ulPortGetRunTime( void );
-#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() /* no-op */
-#define portGET_RUN_TIME_COUNTER_VALUE()         ulPortGetRunTime()
+#ifndef portGET_RUN_TIME_COUNTER_VALUE
+    #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() /* no-op */
+    #define portGET_RUN_TIME_COUNTER_VALUE()         ulPortGetRunTime()
+#endif
 
 #ifdef __cplusplus
 }
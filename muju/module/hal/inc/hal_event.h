@@ -0,0 +1,155 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef HAL_EVENT_H
+#define HAL_EVENT_H
+
+/** @file
+ ** @brief Deferred event handlers declarations
+ **
+ ** When HAL_EVENT_DEFERRED is defined, in the HAL config file or in the compiler command line, the
+ ** interrupts of the gpio terminals and serial ports do not call the event handlers. They only store
+ ** a small record of the event in a lock free queue, and the handlers are called later from a task
+ ** or from the main loop with HalEventDispatch. The time spent in the interrupts is then the same
+ ** for every handler and the handlers can use functions that are not allowed inside an interrupt.
+ **
+ ** A serial port does not raise new events until the handler of its pending event has returned,
+ ** because the line stays active until the data is read. If the queue is full the event is handled
+ ** inside the interrupt, as without deferral, so no event is lost, and it is counted as overflow.
+ **
+ ** @addtogroup hal HAL
+ ** @brief Hardware abstraction layer
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include "hal_gpio.h"
+#include "hal_sci.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Function to enable again the events of a serial port once its deferred event was handled
+ *
+ * @param  sci      Pointer to the structure with the serial port descriptor
+ */
+typedef void (*hal_event_resume_t)(hal_sci_t sci);
+
+/**
+ * @brief Structure with the counters of the deferred events
+ */
+typedef struct hal_event_statistics_s {
+    uint32_t posted;     /**< Events stored in the queue by the interrupts */
+    uint32_t dispatched; /**< Events whose handler was called from the queue */
+    uint32_t overflows;  /**< Events handled inside the interrupt because the queue was full */
+    uint16_t pending;    /**< Maximum number of events waiting in the queue at the same time */
+} * hal_event_statistics_t;
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Function to store a gpio event to call its handler later, it can be used inside an interrupt
+ *
+ * @param  handler  Function to call on the gpio bit event
+ * @param  gpio     Descriptor of the gpio terminal that raises the event
+ * @param  rising   Flag to indicate that the event was raised by a rising edge
+ * @param  object   Pointer to user data sended as parameter in handler call
+ * @return true     The event was stored in the queue
+ * @return false    The queue is full, the caller must call the handler
+ */
+bool HalEventPostGpio(hal_gpio_event_t handler, hal_gpio_bit_t gpio, bool rising, void * object);
+
+/**
+ * @brief Function to store a serial port event to call its handler later, it can be used inside an interrupt
+ *
+ * @param  handler  Function to call on the serial port event
+ * @param  sci      Pointer to the structure with the serial port descriptor
+ * @param  status   Pointer to structure with flags that raises the event, it is copied in the queue
+ * @param  object   Pointer to user data sended as parameter in handler call
+ * @param  resume   Function called after the handler to enable again the events of the serial port
+ * @return true     The event was stored in the queue
+ * @return false    The queue is full, the caller must call the handler
+ */
+bool HalEventPostSci(hal_sci_event_t handler, hal_sci_t sci, sci_status_t status, void * object,
+                     hal_event_resume_t resume);
+
+/**
+ * @brief Function to call the handlers of the events stored in the queue, in the order they were raised
+ *
+ * It must be called always from the same task or from the main loop, never inside an interrupt.
+ *
+ * @param  limit    Maximum number of handlers to call
+ * @return uint16_t Number of handlers called
+ */
+uint16_t HalEventDispatch(uint16_t limit);
+
+/**
+ * @brief Function to read the counters of the deferred events
+ *
+ * @param  result   Pointer to structure to write the counters
+ */
+void HalEventGetStatistics(hal_event_statistics_t result);
+
+#ifdef FREERTOS
+/**
+ * @brief Function to create a task that calls the handlers of the deferred events
+ *
+ * The interrupts wake the task as soon as they store an event, so the interrupts of the gpio terminals
+ * and serial ports get by default configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY, the highest priority
+ * allowed to use the FreeRTOS api. A higher priority in HAL_GPIO_NVIC_PRIORITY or HAL_SCI_NVIC_PRIORITY
+ * is rejected at compile time.
+ *
+ * If HAL_EVENT_POLL_TASK is defined the interrupts keep their priority and the task checks the queue
+ * once per tick instead. The posix board always works this way. The task then wakes the processor on
+ * every tick, which is not compatible with the tickless idle mode of FreeRTOS.
+ *
+ * @param  priority FreeRTOS priority of the task
+ * @return true     The task was created
+ * @return false    The task was not created
+ */
+bool HalEventStartTask(uint8_t priority);
+#endif
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* HAL_EVENT_H */
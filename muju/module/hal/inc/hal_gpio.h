@@ -46,6 +46,48 @@ extern "C" {
 
 /* === Public macros definitions =============================================================== */
 
+/**
+ * @brief Macro to set a gpio output without a function call, with a single register write when the SOC allows it
+ *
+ * The fast path macros take the name of a gpio terminal constant of the SOC, as HAL_GPIO0_4, not a variable,
+ * because its port and bit are resolved at compile time from the name. The functions of the SOC remain for
+ * the terminals that are only known at run time. An alias of a terminal must also define its name with the
+ * _FAST suffix, as the SOC does for its constants.
+ *
+ * @param  gpio     Name of the gpio terminal constant
+ */
+#define GPIO_FAST_SET(gpio) GpioFastSet(gpio##_FAST)
+
+/**
+ * @brief Macro to clear a gpio output without a function call, with a single register write when the SOC allows it
+ *
+ * @param  gpio     Name of the gpio terminal constant
+ */
+#define GPIO_FAST_CLEAR(gpio) GpioFastClear(gpio##_FAST)
+
+/**
+ * @brief Macro to change the state of a gpio output without a function call
+ *
+ * @param  gpio     Name of the gpio terminal constant
+ * @param  state    New state of the gpio output
+ */
+#define GPIO_FAST_WRITE(gpio, state) GpioFastWrite(gpio##_FAST, state)
+
+/**
+ * @brief Macro to invert the state of a gpio output without a function call
+ *
+ * @param  gpio     Name of the gpio terminal constant
+ */
+#define GPIO_FAST_TOGGLE(gpio) GpioFastToggle(gpio##_FAST)
+
+/**
+ * @brief Macro to read the state of a gpio terminal without a function call
+ *
+ * @param  gpio     Name of the gpio terminal constant
+ * @return bool     Current state of the gpio terminal
+ */
+#define GPIO_FAST_GET(gpio) GpioFastGet(gpio##_FAST)
+
 /* === Public data type declarations =========================================================== */
 
 /**
@@ -53,6 +95,16 @@ extern "C" {
  */
 typedef struct hal_gpio_bit_s const * hal_gpio_bit_t;
 
+/**
+ * @brief Number of a gpio port, as it is numbered by the SOC
+ */
+typedef uint8_t hal_gpio_port_t;
+
+/**
+ * @brief Mask with one bit for each terminal of a gpio port, the bit n is the terminal n
+ */
+typedef uint32_t hal_gpio_mask_t;
+
 /**
  * @brief Callback function to handle a gpio port events
  *
@@ -116,6 +168,56 @@ void GpioBitClear(hal_gpio_bit_t gpio);
  */
 void GpioBitToogle(hal_gpio_bit_t gpio);
 
+/**
+ * @brief Function to get the gpio port of a gpio terminal
+ *
+ * @param  gpio     Pointer to the structure with the gpio terminal descriptor
+ * @return          Number of the gpio port that contains the terminal
+ */
+hal_gpio_port_t GpioGetPort(hal_gpio_bit_t gpio);
+
+/**
+ * @brief Function to get the mask of a gpio terminal inside its gpio port
+ *
+ * @param  gpio     Pointer to the structure with the gpio terminal descriptor
+ * @return          Mask with only the bit of the terminal set, zero if the descriptor is not valid
+ */
+hal_gpio_mask_t GpioGetMask(hal_gpio_bit_t gpio);
+
+/**
+ * @brief Function to read the current value of several terminals of a gpio port in a single access
+ *
+ * @param  port     Number of the gpio port to read
+ * @param  mask     Mask of the terminals to read
+ * @return          Current value of the terminals in the mask, the other bits are zero
+ */
+hal_gpio_mask_t GpioPortGetState(hal_gpio_port_t port, hal_gpio_mask_t mask);
+
+/**
+ * @brief Function to update the current value of several outputs of a gpio port
+ *
+ * @param  port     Number of the gpio port to update
+ * @param  mask     Mask of the outputs to update, the other outputs of the port keep their value
+ * @param  value    Value to write to the outputs in the mask
+ */
+void GpioPortSetState(hal_gpio_port_t port, hal_gpio_mask_t mask, hal_gpio_mask_t value);
+
+/**
+ * @brief Function to set the current value to high of several outputs of a gpio port
+ *
+ * @param  port     Number of the gpio port to update
+ * @param  mask     Mask of the outputs to set
+ */
+void GpioPortSet(hal_gpio_port_t port, hal_gpio_mask_t mask);
+
+/**
+ * @brief Function to set the current value to low of several outputs of a gpio port
+ *
+ * @param  port     Number of the gpio port to update
+ * @param  mask     Mask of the outputs to clear
+ */
+void GpioPortClear(hal_gpio_port_t port, hal_gpio_mask_t mask);
+
 /**
  * @brief Function to enable gpio port interrupts and handle its as events
  *
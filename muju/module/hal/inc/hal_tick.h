@@ -68,6 +68,21 @@ typedef void (*hal_tick_event_t)(void * object);
  */
 void TickStart(hal_tick_event_t handler, void * object, uint32_t period);
 
+/**
+ * @brief Function to start a free running counter to measure execution times
+ *
+ * The counter keeps running while the processor sleeps and wraps around after 2^32 microseconds,
+ * so differences between two readings must be computed as unsigned values.
+ */
+void TickCounterStart(void);
+
+/**
+ * @brief Function to read the free running counter
+ *
+ * @return uint32_t Microseconds elapsed since the counter was started
+ */
+uint32_t TickCounterRead(void);
+
 /* === End of documentation ==================================================================== */
 
 #ifdef __cplusplus
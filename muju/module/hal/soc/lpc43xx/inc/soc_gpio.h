@@ -46,6 +46,88 @@ extern "C" {
 
 /* === Public macros definitions =============================================================== */
 
+/**
+ * @brief Address of the gpio port registers, checked against the LPCOpen definitions in soc_gpio.c
+ */
+#define HAL_GPIO_REGISTERS 0x400F4000UL
+
+/** @cond INTERNAL */
+#define HAL_GPIO_SET_OFFSET 0x2200UL /**< Offset of the registers to set the outputs of a port */
+#define HAL_GPIO_CLR_OFFSET 0x2280UL /**< Offset of the registers to clear the outputs of a port */
+#define HAL_GPIO_NOT_OFFSET 0x2300UL /**< Offset of the registers to invert the outputs of a port */
+
+/**
+ * @brief Macro to access a word register of a gpio port
+ */
+#define HAL_GPIO_REGISTER(offset, port) (*(volatile uint32_t *)(HAL_GPIO_REGISTERS + (offset) + 4 * (port)))
+
+/**
+ * @brief Macro to access the byte register of a gpio terminal, that reads and writes only that terminal
+ */
+#define HAL_GPIO_BYTE_REGISTER(port, bit) (*(volatile uint8_t *)(HAL_GPIO_REGISTERS + 32 * (port) + (bit)))
+/** @endcond */
+
+/** @cond !INTERNAL */
+#define HAL_GPIO0_0_FAST  0, 0  /**< Port and bit of Bit 0 on GPIO 0 for the fast path */
+#define HAL_GPIO0_1_FAST  0, 1  /**< Port and bit of Bit 1 on GPIO 0 for the fast path */
+#define HAL_GPIO0_2_FAST  0, 2  /**< Port and bit of Bit 2 on GPIO 0 for the fast path */
+#define HAL_GPIO0_3_FAST  0, 3  /**< Port and bit of Bit 3 on GPIO 0 for the fast path */
+#define HAL_GPIO0_4_FAST  0, 4  /**< Port and bit of Bit 4 on GPIO 0 for the fast path */
+#define HAL_GPIO0_5_FAST  0, 5  /**< Port and bit of Bit 5 on GPIO 0 for the fast path */
+#define HAL_GPIO0_7_FAST  0, 7  /**< Port and bit of Bit 7 on GPIO 0 for the fast path */
+#define HAL_GPIO0_8_FAST  0, 8  /**< Port and bit of Bit 8 on GPIO 0 for the fast path */
+#define HAL_GPIO0_9_FAST  0, 9  /**< Port and bit of Bit 9 on GPIO 0 for the fast path */
+#define HAL_GPIO0_10_FAST 0, 10 /**< Port and bit of Bit 10 on GPIO 0 for the fast path */
+#define HAL_GPIO0_11_FAST 0, 11 /**< Port and bit of Bit 11 on GPIO 0 for the fast path */
+#define HAL_GPIO0_12_FAST 0, 12 /**< Port and bit of Bit 12 on GPIO 0 for the fast path */
+#define HAL_GPIO0_13_FAST 0, 13 /**< Port and bit of Bit 13 on GPIO 0 for the fast path */
+#define HAL_GPIO0_14_FAST 0, 14 /**< Port and bit of Bit 14 on GPIO 0 for the fast path */
+#define HAL_GPIO0_15_FAST 0, 15 /**< Port and bit of Bit 15 on GPIO 0 for the fast path */
+
+#define HAL_GPIO1_8_FAST  1, 8  /**< Port and bit of Bit 8 on GPIO 1 for the fast path */
+#define HAL_GPIO1_9_FAST  1, 9  /**< Port and bit of Bit 9 on GPIO 1 for the fast path */
+#define HAL_GPIO1_11_FAST 1, 11 /**< Port and bit of Bit 11 on GPIO 1 for the fast path */
+#define HAL_GPIO1_12_FAST 1, 12 /**< Port and bit of Bit 12 on GPIO 1 for the fast path */
+
+#define HAL_GPIO2_0_FAST  2, 0  /**< Port and bit of Bit 0 on GPIO 2 for the fast path */
+#define HAL_GPIO2_1_FAST  2, 1  /**< Port and bit of Bit 1 on GPIO 2 for the fast path */
+#define HAL_GPIO2_2_FAST  2, 2  /**< Port and bit of Bit 2 on GPIO 2 for the fast path */
+#define HAL_GPIO2_3_FAST  2, 3  /**< Port and bit of Bit 3 on GPIO 2 for the fast path */
+#define HAL_GPIO2_4_FAST  2, 4  /**< Port and bit of Bit 4 on GPIO 2 for the fast path */
+#define HAL_GPIO2_5_FAST  2, 5  /**< Port and bit of Bit 5 on GPIO 2 for the fast path */
+#define HAL_GPIO2_6_FAST  2, 6  /**< Port and bit of Bit 6 on GPIO 2 for the fast path */
+#define HAL_GPIO2_8_FAST  2, 8  /**< Port and bit of Bit 8 on GPIO 2 for the fast path */
+
+#define HAL_GPIO3_0_FAST  3, 0  /**< Port and bit of Bit 0 on GPIO 3 for the fast path */
+#define HAL_GPIO3_1_FAST  3, 1  /**< Port and bit of Bit 1 on GPIO 3 for the fast path */
+#define HAL_GPIO3_2_FAST  3, 2  /**< Port and bit of Bit 2 on GPIO 3 for the fast path */
+#define HAL_GPIO3_3_FAST  3, 3  /**< Port and bit of Bit 3 on GPIO 3 for the fast path */
+#define HAL_GPIO3_4_FAST  3, 4  /**< Port and bit of Bit 4 on GPIO 3 for the fast path */
+#define HAL_GPIO3_5_FAST  3, 5  /**< Port and bit of Bit 5 on GPIO 3 for the fast path */
+#define HAL_GPIO3_6_FAST  3, 6  /**< Port and bit of Bit 6 on GPIO 3 for the fast path */
+#define HAL_GPIO3_7_FAST  3, 7  /**< Port and bit of Bit 7 on GPIO 3 for the fast path */
+#define HAL_GPIO3_12_FAST 3, 12 /**< Port and bit of Bit 12 on GPIO 3 for the fast path */
+#define HAL_GPIO3_13_FAST 3, 13 /**< Port and bit of Bit 13 on GPIO 3 for the fast path */
+#define HAL_GPIO3_14_FAST 3, 14 /**< Port and bit of Bit 14 on GPIO 3 for the fast path */
+#define HAL_GPIO3_15_FAST 3, 15 /**< Port and bit of Bit 15 on GPIO 3 for the fast path */
+
+#define HAL_GPIO4_11_FAST 4, 11 /**< Port and bit of Bit 11 on GPIO 4 for the fast path */
+
+#define HAL_GPIO5_0_FAST  5, 0  /**< Port and bit of Bit 0 on GPIO 5 for the fast path */
+#define HAL_GPIO5_1_FAST  5, 1  /**< Port and bit of Bit 1 on GPIO 5 for the fast path */
+#define HAL_GPIO5_2_FAST  5, 2  /**< Port and bit of Bit 2 on GPIO 5 for the fast path */
+#define HAL_GPIO5_3_FAST  5, 3  /**< Port and bit of Bit 3 on GPIO 5 for the fast path */
+#define HAL_GPIO5_4_FAST  5, 4  /**< Port and bit of Bit 4 on GPIO 5 for the fast path */
+#define HAL_GPIO5_8_FAST  5, 8  /**< Port and bit of Bit 8 on GPIO 5 for the fast path */
+#define HAL_GPIO5_9_FAST  5, 9  /**< Port and bit of Bit 9 on GPIO 5 for the fast path */
+#define HAL_GPIO5_12_FAST 5, 12 /**< Port and bit of Bit 12 on GPIO 5 for the fast path */
+#define HAL_GPIO5_13_FAST 5, 13 /**< Port and bit of Bit 13 on GPIO 5 for the fast path */
+#define HAL_GPIO5_14_FAST 5, 14 /**< Port and bit of Bit 14 on GPIO 5 for the fast path */
+#define HAL_GPIO5_15_FAST 5, 15 /**< Port and bit of Bit 15 on GPIO 5 for the fast path */
+#define HAL_GPIO5_16_FAST 5, 16 /**< Port and bit of Bit 16 on GPIO 5 for the fast path */
+#define HAL_GPIO5_18_FAST 5, 18 /**< Port and bit of Bit 18 on GPIO 5 for the fast path */
+/** @endcond */
+
 /* === Public data type declarations =========================================================== */
 
 /* === Public variable declarations ============================================================ */
@@ -113,6 +195,58 @@ extern const hal_gpio_bit_t HAL_GPIO5_18; /**< Constant to define Bit 18 on GPIO
 
 /* === Public function declarations ============================================================ */
 
+/**
+ * @brief Function of the fast path to set a gpio output, a single write to the set register of its port
+ *
+ * @param  port     Number of the gpio port
+ * @param  bit      Number of the gpio terminal in the port
+ */
+static inline void GpioFastSet(hal_gpio_port_t port, uint8_t bit) {
+    HAL_GPIO_REGISTER(HAL_GPIO_SET_OFFSET, port) = 1UL << bit;
+}
+
+/**
+ * @brief Function of the fast path to clear a gpio output, a single write to the clear register of its port
+ *
+ * @param  port     Number of the gpio port
+ * @param  bit      Number of the gpio terminal in the port
+ */
+static inline void GpioFastClear(hal_gpio_port_t port, uint8_t bit) {
+    HAL_GPIO_REGISTER(HAL_GPIO_CLR_OFFSET, port) = 1UL << bit;
+}
+
+/**
+ * @brief Function of the fast path to change a gpio output, a single write to the byte register of the terminal
+ *
+ * @param  port     Number of the gpio port
+ * @param  bit      Number of the gpio terminal in the port
+ * @param  state    New state of the gpio output
+ */
+static inline void GpioFastWrite(hal_gpio_port_t port, uint8_t bit, bool state) {
+    HAL_GPIO_BYTE_REGISTER(port, bit) = state;
+}
+
+/**
+ * @brief Function of the fast path to invert a gpio output, a single write to the toggle register of its port
+ *
+ * @param  port     Number of the gpio port
+ * @param  bit      Number of the gpio terminal in the port
+ */
+static inline void GpioFastToggle(hal_gpio_port_t port, uint8_t bit) {
+    HAL_GPIO_REGISTER(HAL_GPIO_NOT_OFFSET, port) = 1UL << bit;
+}
+
+/**
+ * @brief Function of the fast path to read a gpio terminal, a single read of the byte register of the terminal
+ *
+ * @param  port     Number of the gpio port
+ * @param  bit      Number of the gpio terminal in the port
+ * @return bool     Current state of the gpio terminal
+ */
+static inline bool GpioFastGet(hal_gpio_port_t port, uint8_t bit) {
+    return HAL_GPIO_BYTE_REGISTER(port, bit) != 0;
+}
+
 /* === End of documentation ==================================================================== */
 
 #ifdef __cplusplus
@@ -36,6 +36,12 @@ SPDX-License-Identifier: MIT
 
 #include "soc_gpio.h"
 #include "chip.h"
+
+#ifdef FREERTOS
+#include "FreeRTOS.h"
+#endif
+#include "hal_event.h"
+#include <stddef.h>
 #include <string.h>
 
 /**
@@ -49,6 +55,16 @@ SPDX-License-Identifier: MIT
 
 /* === Macros definitions ====================================================================== */
 
+#if defined(HAL_EVENT_DEFERRED) && defined(FREERTOS) && !defined(HAL_EVENT_POLL_TASK)
+// The interrupts wake the task of the deferred handlers, so they must be allowed to use the FreeRTOS api
+#ifndef HAL_GPIO_NVIC_PRIORITY
+#define HAL_GPIO_NVIC_PRIORITY configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+#endif
+#if HAL_GPIO_NVIC_PRIORITY < configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+#error "The deferred events notify a task, the interrupt priority must allow to use the FreeRTOS api"
+#endif
+#endif
+
 /**
  * @brief Macro to configure priority to set on NVIC for serial port interrupts
  */
@@ -56,6 +72,37 @@ SPDX-License-Identifier: MIT
 #define HAL_GPIO_NVIC_PRIORITY 0
 #endif
 
+/**
+ * @brief Macro to configure the number of gpio terminals that can handle events at the same time
+ */
+#ifndef HAL_GPIO_EVENT_HANDLERS
+#define HAL_GPIO_EVENT_HANDLERS 32
+#endif
+
+#if HAL_GPIO_EVENT_HANDLERS > 255
+#error "The gpio event handlers are indexed with a byte"
+#endif
+
+/**
+ * @brief Number of gpio ports in the chip
+ */
+#define GPIO_PORTS 8
+
+/**
+ * @brief Number of pin interrupt channels, each one serves a single gpio terminal
+ */
+#define PININT_CHANNELS 8
+
+/**
+ * @brief Group interrupt that serves the gpio terminals without a pin interrupt channel
+ */
+#define GPIO_GROUP 0
+
+/**
+ * @brief Value of the channel field for the event handlers served by the group interrupt
+ */
+#define GROUP_CHANNEL 0xFF
+
 /**
  * @brief Macro to generate the name of an descriptor from the gpio port and bit
  */
@@ -89,6 +136,7 @@ typedef struct event_handler_s {
     hal_gpio_bit_t gpio;      /**< Pointer to the structure with the gpio terminal descriptor */
     hal_gpio_event_t handler; /**< Function to call on the serial port events */
     void * object;            /**< Pointer to user data sended as parameter in handler calls */
+    uint8_t channel;          /**< Pin interrupt channel assigned or GROUP_CHANNEL */
 } * event_handler_t;
 
 /* === Private variable declarations =========================================================== */
@@ -99,10 +147,33 @@ typedef struct event_handler_s {
  * @brief Function to find the handler used by an gpio or an empty if none was assigned before
  *
  * @param  gpio         Pointer to the structure with the gpio terminal descriptor
- * @param  descriptor   Pointer to variable te return the selected descriptor
- * @return uint8_t      Index descriptor in array, used to assign the channel interrupt
+ * @return              Pointer to the descriptor, NULL if the gpio has none and all are in use
+ */
+static event_handler_t FindHandlerDescriptor(hal_gpio_bit_t gpio);
+
+/**
+ * @brief Function to disable the interrupts of a gpio terminal and release its event handler
+ *
+ * @param  descriptor   Pointer to the event handler descriptor assigned to the gpio terminal
+ */
+static void ReleaseHandlerDescriptor(event_handler_t descriptor);
+
+/**
+ * @brief Function to enable the events of a gpio terminal on the group interrupt
+ *
+ * @param  gpio     Pointer to the structure with the gpio terminal descriptor
+ * @param  rising   The rising edges of the gpio terminal raise events
+ * @param  falling  The falling edges of the gpio terminal raise events
+ */
+static void GroupEnable(hal_gpio_bit_t gpio, bool rising, bool falling);
+
+/**
+ * @brief Function to call the handler of a gpio event, or to defer it when HAL_EVENT_DEFERRED is defined
+ *
+ * @param  descriptor   Pointer to the structure with the event handler of the gpio terminal
+ * @param  rising       Flag to indicate that the event was raised by a rising edge
  */
-static uint8_t FindHandlerDescriptor(hal_gpio_bit_t gpio, event_handler_t * descriptor);
+static void GpioRaiseEvent(event_handler_t descriptor, bool rising);
 
 /**
  * @brief Function to dispatch an gpio bit event when then raises an interrupt
@@ -111,6 +182,11 @@ static uint8_t FindHandlerDescriptor(hal_gpio_bit_t gpio, event_handler_t * desc
  */
 static void GpioHandleEvent(uint8_t index);
 
+/**
+ * @brief Function to dispatch the events of all the gpio terminals that changed when the group raises an interrupt
+ */
+static void GpioHandleGroup(void);
+
 /* === Public variable definitions ============================================================= */
 
 /**
@@ -180,42 +256,168 @@ const hal_gpio_bit_t GPIO_BIT(5, 18, 4, 9, 5);  /**< Constant to define Bit 18 o
 
 /* === Private variable definitions ============================================================ */
 
+// The fast path of soc_gpio.h writes the registers by address, without the LPCOpen headers
+_Static_assert(HAL_GPIO_REGISTERS == LPC_GPIO_PORT_BASE, "Wrong address of the gpio registers");
+_Static_assert(offsetof(LPC_GPIO_T, B) == 0, "Wrong offset of the gpio byte registers");
+_Static_assert(offsetof(LPC_GPIO_T, SET) == HAL_GPIO_SET_OFFSET, "Wrong offset of the gpio set registers");
+_Static_assert(offsetof(LPC_GPIO_T, CLR) == HAL_GPIO_CLR_OFFSET, "Wrong offset of the gpio clear registers");
+_Static_assert(offsetof(LPC_GPIO_T, NOT) == HAL_GPIO_NOT_OFFSET, "Wrong offset of the gpio toggle registers");
+
+/**
+ * @brief Vector to store the event handlers of the gpio terminals
+ */
+static struct event_handler_s event_handlers[HAL_GPIO_EVENT_HANDLERS] = {0};
+
+/**
+ * @brief Position plus one in the event handlers vector of the descriptor assigned to each gpio terminal
+ */
+static uint8_t handler_index[GPIO_PORTS][32] = {0};
+
+/**
+ * @brief Position plus one in the event handlers vector of the descriptor assigned to each pin interrupt channel
+ */
+static uint8_t channel_index[PININT_CHANNELS] = {0};
+
+/**
+ * @brief Mask of the gpio ports with terminals served by the group interrupt
+ */
+static uint8_t group_ports = 0;
+
+/**
+ * @brief Masks of the terminals of each gpio port that raise events on the group interrupt on each edge
+ */
+static uint32_t group_rising[GPIO_PORTS] = {0};
+static uint32_t group_falling[GPIO_PORTS] = {0};
+
 /**
- * @brief Vector to store the event handlers of the serial ports
+ * @brief Last state of the terminals served by the group interrupt
  */
-static struct event_handler_s event_handlers[8] = {0};
+static uint32_t group_state[GPIO_PORTS] = {0};
 
 /* === Private function implementation ========================================================= */
 
-static uint8_t FindHandlerDescriptor(hal_gpio_bit_t gpio, event_handler_t * descriptor) {
-    uint8_t index;
-    *descriptor = NULL;
+static event_handler_t FindHandlerDescriptor(hal_gpio_bit_t gpio) {
+    event_handler_t descriptor = NULL;
+    uint8_t index = handler_index[gpio->gpio][gpio->bit];
 
-    for (index = 0; index < 7; index++) {
-        if (event_handlers[index].gpio == gpio) {
-            *descriptor = &event_handlers[index];
-            break;
-        }
-    }
-    if (*descriptor == NULL) {
-        for (index = 0; index < 7; index++) {
+    if (index) {
+        descriptor = &event_handlers[index - 1];
+    } else {
+        // A free descriptor is only searched when a handler is assigned, never while serving an interrupt
+        for (index = 0; index < HAL_GPIO_EVENT_HANDLERS; index++) {
             if (event_handlers[index].gpio == NULL) {
-                *descriptor = &event_handlers[index];
+                descriptor = &event_handlers[index];
+                descriptor->gpio = gpio;
+                handler_index[gpio->gpio][gpio->bit] = index + 1;
                 break;
             }
         }
     }
-    return index;
+    return descriptor;
+}
+
+static void ReleaseHandlerDescriptor(event_handler_t descriptor) {
+    hal_gpio_bit_t gpio = descriptor->gpio;
+    uint32_t mask = 1UL << gpio->bit;
+
+    if (descriptor->channel == GROUP_CHANNEL) {
+        Chip_GPIOGP_DisableGroupPins(LPC_GPIOGROUP, GPIO_GROUP, gpio->gpio, mask);
+        group_rising[gpio->gpio] &= ~mask;
+        group_falling[gpio->gpio] &= ~mask;
+        if ((group_rising[gpio->gpio] | group_falling[gpio->gpio]) == 0) {
+            group_ports &= ~(1 << gpio->gpio);
+        }
+        if (group_ports == 0) {
+            NVIC_DisableIRQ(GINT0_IRQn);
+        }
+    } else if (descriptor->channel < PININT_CHANNELS) {
+        Chip_PININT_DisableIntHigh(LPC_GPIO_PIN_INT, 1 << descriptor->channel);
+        Chip_PININT_DisableIntLow(LPC_GPIO_PIN_INT, 1 << descriptor->channel);
+        NVIC_DisableIRQ(PIN_INT0_IRQn + descriptor->channel);
+        channel_index[descriptor->channel] = 0;
+    }
+    handler_index[gpio->gpio][gpio->bit] = 0;
+    memset(descriptor, 0, sizeof(*descriptor));
+}
+
+// The active level of each terminal is the opposite of the last one read, so any change raises the interrupt
+static void GroupEnable(hal_gpio_bit_t gpio, bool rising, bool falling) {
+    uint32_t mask = 1UL << gpio->bit;
+
+    if (group_ports == 0) {
+        Chip_GPIOGP_SelectOrMode(LPC_GPIOGROUP, GPIO_GROUP);
+        Chip_GPIOGP_SelectLevelMode(LPC_GPIOGROUP, GPIO_GROUP);
+    }
+    if (rising) {
+        group_rising[gpio->gpio] |= mask;
+    }
+    if (falling) {
+        group_falling[gpio->gpio] |= mask;
+    }
+    group_ports |= 1 << gpio->gpio;
+
+    if (LPC_GPIO_PORT->PIN[gpio->gpio] & mask) {
+        group_state[gpio->gpio] |= mask;
+        Chip_GPIOGP_SelectLowLevel(LPC_GPIOGROUP, GPIO_GROUP, gpio->gpio, mask);
+    } else {
+        group_state[gpio->gpio] &= ~mask;
+        Chip_GPIOGP_SelectHighLevel(LPC_GPIOGROUP, GPIO_GROUP, gpio->gpio, mask);
+    }
+    Chip_GPIOGP_EnableGroupPins(LPC_GPIOGROUP, GPIO_GROUP, gpio->gpio, mask);
+    Chip_GPIOGP_ClearIntStatus(LPC_GPIOGROUP, GPIO_GROUP);
+    NVIC_SetPriority(GINT0_IRQn, HAL_GPIO_NVIC_PRIORITY);
+    NVIC_EnableIRQ(GINT0_IRQn);
+}
+
+// When the queue is full the handler is called here, so the event is not lost
+static void GpioRaiseEvent(event_handler_t descriptor, bool rising) {
+#ifdef HAL_EVENT_DEFERRED
+    if (HalEventPostGpio(descriptor->handler, descriptor->gpio, rising, descriptor->object)) {
+        return;
+    }
+#endif
+    descriptor->handler(descriptor->gpio, rising, descriptor->object);
 }
 
 static void GpioHandleEvent(uint8_t index) {
-    event_handler_t descriptor = &event_handlers[index];
+    uint8_t position = channel_index[index];
     bool rissing = (Chip_PININT_GetRiseStates(LPC_GPIO_PIN_INT) & (1 << index));
     Chip_PININT_ClearIntStatus(LPC_GPIO_PIN_INT, 1 << index);
 
-    if (descriptor->handler != NULL) {
-        descriptor->handler(descriptor->gpio, rissing, descriptor->object);
+    if (position) {
+        event_handler_t descriptor = &event_handlers[position - 1];
+        GpioRaiseEvent(descriptor, rissing);
+    }
+}
+
+// The cost depends on the ports in use and the terminals that changed, not on the handlers assigned
+static void GpioHandleGroup(void) {
+    uint8_t ports = group_ports;
+
+    while (ports) {
+        uint8_t port = __builtin_ctz(ports);
+        uint32_t enabled = group_rising[port] | group_falling[port];
+        uint32_t state = LPC_GPIO_PORT->PIN[port] & enabled;
+        uint32_t changed = state ^ group_state[port];
+
+        ports &= ports - 1;
+        group_state[port] = state;
+        // The active level of the terminals that are not enabled does not matter
+        LPC_GPIOGROUP[GPIO_GROUP].PORT_POL[port] = ~state;
+
+        while (changed) {
+            uint8_t bit = __builtin_ctz(changed);
+            uint32_t mask = 1UL << bit;
+
+            changed &= changed - 1;
+            if ((state & mask) ? (group_rising[port] & mask) : (group_falling[port] & mask)) {
+                event_handler_t descriptor = &event_handlers[handler_index[port][bit] - 1];
+                GpioRaiseEvent(descriptor, (state & mask) != 0);
+            }
+        }
     }
+    // In level mode the interrupt is raised again if a terminal changed while it was being served
+    Chip_GPIOGP_ClearIntStatus(LPC_GPIOGROUP, GPIO_GROUP);
 }
 
 /* === Public function implementation ========================================================== */
@@ -266,32 +468,92 @@ void GpioBitToogle(hal_gpio_bit_t gpio) {
     }
 }
 
+hal_gpio_port_t GpioGetPort(hal_gpio_bit_t gpio) {
+    hal_gpio_port_t port = 0;
+    if (gpio) {
+        port = gpio->gpio;
+    }
+    return port;
+}
+
+hal_gpio_mask_t GpioGetMask(hal_gpio_bit_t gpio) {
+    hal_gpio_mask_t mask = 0;
+    if (gpio) {
+        mask = 1UL << gpio->bit;
+    }
+    return mask;
+}
+
+hal_gpio_mask_t GpioPortGetState(hal_gpio_port_t port, hal_gpio_mask_t mask) {
+    hal_gpio_mask_t value = 0;
+    if (port < GPIO_PORTS) {
+        value = LPC_GPIO_PORT->PIN[port] & mask;
+    }
+    return value;
+}
+
+// The masked MPIN register depends on the shared MASK register, so the write uses SET and CLR
+void GpioPortSetState(hal_gpio_port_t port, hal_gpio_mask_t mask, hal_gpio_mask_t value) {
+    if (port < GPIO_PORTS) {
+        LPC_GPIO_PORT->SET[port] = value & mask;
+        LPC_GPIO_PORT->CLR[port] = ~value & mask;
+    }
+}
+
+void GpioPortSet(hal_gpio_port_t port, hal_gpio_mask_t mask) {
+    if (port < GPIO_PORTS) {
+        LPC_GPIO_PORT->SET[port] = mask;
+    }
+}
+
+void GpioPortClear(hal_gpio_port_t port, hal_gpio_mask_t mask) {
+    if (port < GPIO_PORTS) {
+        LPC_GPIO_PORT->CLR[port] = mask;
+    }
+}
+
+// The first terminals get a pin interrupt channel each, the next ones share the group interrupt
 void GpioSetEventHandler(hal_gpio_bit_t gpio, hal_gpio_event_t handler, void * object, bool rising,
                          bool falling) {
-
     event_handler_t descriptor;
-    uint8_t index = FindHandlerDescriptor(gpio, &descriptor);
+    uint8_t index;
 
-    if (descriptor != NULL) {
-        if (((rising) || (falling)) && (handler)) {
-            descriptor->gpio = gpio;
+    if (gpio == NULL) {
+        return;
+    }
+    if (handler_index[gpio->gpio][gpio->bit]) {
+        ReleaseHandlerDescriptor(&event_handlers[handler_index[gpio->gpio][gpio->bit] - 1]);
+    }
+    if (((rising) || (falling)) && (handler)) {
+        descriptor = FindHandlerDescriptor(gpio);
+        if (descriptor != NULL) {
             descriptor->handler = handler;
             descriptor->object = object;
 
-            Chip_SCU_GPIOIntPinSel(index, gpio->gpio, gpio->bit);
-            Chip_PININT_ClearIntStatus(LPC_GPIO_PIN_INT, 1 << index);
-            if (rising) {
-                Chip_PININT_EnableIntHigh(LPC_GPIO_PIN_INT, 1 << index);
+            for (index = 0; index < PININT_CHANNELS; index++) {
+                if (channel_index[index] == 0) {
+                    break;
+                }
             }
-            if (falling) {
-                Chip_PININT_EnableIntLow(LPC_GPIO_PIN_INT, 1 << index);
+            if (index < PININT_CHANNELS) {
+                descriptor->channel = index;
+                channel_index[index] = handler_index[gpio->gpio][gpio->bit];
+
+                Chip_SCU_GPIOIntPinSel(index, gpio->gpio, gpio->bit);
+                Chip_PININT_ClearIntStatus(LPC_GPIO_PIN_INT, 1 << index);
+                if (rising) {
+                    Chip_PININT_EnableIntHigh(LPC_GPIO_PIN_INT, 1 << index);
+                }
+                if (falling) {
+                    Chip_PININT_EnableIntLow(LPC_GPIO_PIN_INT, 1 << index);
+                }
+                NVIC_ClearPendingIRQ(PIN_INT0_IRQn + index);
+                NVIC_SetPriority(PIN_INT0_IRQn + index, HAL_GPIO_NVIC_PRIORITY);
+                NVIC_EnableIRQ(PIN_INT0_IRQn + index);
+            } else {
+                descriptor->channel = GROUP_CHANNEL;
+                GroupEnable(gpio, rising, falling);
             }
-            NVIC_ClearPendingIRQ(PIN_INT0_IRQn + index);
-            NVIC_SetPriority(PIN_INT0_IRQn + index, HAL_GPIO_NVIC_PRIORITY);
-            NVIC_EnableIRQ(PIN_INT0_IRQn + index);
-        } else {
-            memset(descriptor, 0, sizeof(*descriptor));
-            NVIC_EnableIRQ(PIN_INT0_IRQn + index);
         }
     }
 }
@@ -323,10 +585,15 @@ void GPIO5_IRQHandler(void) {
 void GPIO6_IRQHandler(void) {
     GpioHandleEvent(6);
 }
+
 void GPIO7_IRQHandler(void) {
     GpioHandleEvent(7);
 }
 
+void GINT0_IRQHandler(void) {
+    GpioHandleGroup();
+}
+
 /* === End of documentation ==================================================================== */
 
 /** @} End of module definition for doxygen
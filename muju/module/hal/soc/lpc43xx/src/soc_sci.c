@@ -35,9 +35,14 @@ SPDX-License-Identifier: MIT
 /* === Headers files inclusions =============================================================== */
 
 #include "soc_sci.h"
+#include "hal_event.h"
 #include "soc_pin.h"
 #include "chip.h"
 
+#ifdef FREERTOS
+#include "FreeRTOS.h"
+#endif
+
 /**
  *  @brief Include global project config file if it's defined
  */
@@ -49,6 +54,16 @@ SPDX-License-Identifier: MIT
 
 /* === Macros definitions ====================================================================== */
 
+#if defined(HAL_EVENT_DEFERRED) && defined(FREERTOS) && !defined(HAL_EVENT_POLL_TASK)
+// The interrupts wake the task of the deferred handlers, so they must be allowed to use the FreeRTOS api
+#ifndef HAL_SCI_NVIC_PRIORITY
+#define HAL_SCI_NVIC_PRIORITY configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+#endif
+#if HAL_SCI_NVIC_PRIORITY < configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+#error "The deferred events notify a task, the interrupt priority must allow to use the FreeRTOS api"
+#endif
+#endif
+
 /**
  * @brief Macro to configure priority to set on NVIC for serial port interrupts
  */
@@ -130,6 +145,23 @@ static uint32_t LineEncodeBits(hal_sci_line_t line);
  */
 static void SciHandleEvent(hal_sci_t sci);
 
+/**
+ * @brief Function to call the handler of a serial port event, or to defer it when HAL_EVENT_DEFERRED is defined
+ *
+ * @param  sci      Pointer to the structure with the serial port descriptor
+ * @param  status   Pointer to structure with flags that raises the event
+ */
+static void SciRaiseEvent(hal_sci_t sci, sci_status_t status);
+
+#ifdef HAL_EVENT_DEFERRED
+/**
+ * @brief Function to enable again the events of a serial port once the handler of its deferred event returned
+ *
+ * @param  sci      Pointer to the structure with the serial port descriptor
+ */
+static void SciResumeEvents(hal_sci_t sci);
+#endif
+
 /* === Public variable definitions ============================================================= */
 
 /**
@@ -333,6 +365,26 @@ static uint32_t LineEncodeBits(hal_sci_line_t line) {
     return config;
 }
 
+// The line stays active until the handler reads the data, so the interrupt is disabled while the event waits
+static void SciRaiseEvent(hal_sci_t sci, sci_status_t status) {
+    event_handler_t event_handler = &event_handlers[sci->index];
+
+#ifdef HAL_EVENT_DEFERRED
+    NVIC_DisableIRQ(sci->interupt);
+    if (HalEventPostSci(event_handler->handler, sci, status, event_handler->data, SciResumeEvents)) {
+        return;
+    }
+    NVIC_EnableIRQ(sci->interupt);
+#endif
+    event_handler->handler(sci, status, event_handler->data);
+}
+
+#ifdef HAL_EVENT_DEFERRED
+static void SciResumeEvents(hal_sci_t sci) {
+    NVIC_EnableIRQ(sci->interupt);
+}
+#endif
+
 static void SciHandleEvent(hal_sci_t sci) {
     if (sci) {
         event_handler_t event_handler = &event_handlers[sci->index];
@@ -342,7 +394,7 @@ static void SciHandleEvent(hal_sci_t sci) {
 
         SciReadStatus(sci, &status);
         if (event_handler->handler) {
-            event_handler->handler(sci, &status, event_handler->data);
+            SciRaiseEvent(sci, &status);
         }
     }
 }
@@ -39,6 +39,16 @@ SPDX-License-Identifier: MIT
 
 /* === Macros definitions ====================================================================== */
 
+/**
+ * @brief Timer used as free running counter, not used by any other module of the HAL
+ */
+#define COUNTER_TIMER LPC_TIMER3
+
+/**
+ * @brief Clock of the timer used as free running counter
+ */
+#define COUNTER_CLOCK CLK_MX_TIMER3
+
 /* === Private data type declarations ========================================================== */
 
 /**
@@ -82,6 +92,19 @@ void TickStart(hal_tick_event_t handler, void * object, uint32_t period) {
     __asm volatile("cpsie i");
 }
 
+void TickCounterStart(void) {
+    Chip_TIMER_Init(COUNTER_TIMER);
+    Chip_TIMER_Reset(COUNTER_TIMER);
+
+    /* Prescale the peripheral clock to count microseconds */
+    Chip_TIMER_PrescaleSet(COUNTER_TIMER, Chip_Clock_GetRate(COUNTER_CLOCK) / 1000000 - 1);
+    Chip_TIMER_Enable(COUNTER_TIMER);
+}
+
+uint32_t TickCounterRead(void) {
+    return Chip_TIMER_ReadCount(COUNTER_TIMER);
+}
+
 void SysTick_Handler(void) {
     if (instance->handler) {
         instance->handler(instance->object);
@@ -46,8 +46,41 @@ extern "C" {
 
 /* === Public macros definitions =============================================================== */
 
+/**
+ * @brief Value of the magic field once the board has initialized the shared gpio state
+ */
+#define HAL_GPIO_SHARED_MAGIC 0x4F495047
+
+/**
+ * @brief Number of emulated gpio ports in the shared gpio state
+ */
+#define HAL_GPIO_SHARED_PORTS 4
+
 /* === Public data type declarations =========================================================== */
 
+/**
+ * @brief Layout of the file that shares the emulated gpio ports with other processes
+ *
+ * The counters are also used as futex words. A process that drives the board writes the port, mask and
+ * value of an input request, increments request and wakes its futex, then waits on applied until the
+ * board stores there the same count. Only one request can be pending at a time. To wait for outputs a
+ * process increments waiters and waits on changes, that the board increments on each update of the
+ * ports and only wakes while waiters is not zero.
+ */
+struct hal_gpio_shared_s {
+    uint32_t magic;                        /**< HAL_GPIO_SHARED_MAGIC once the board initialized the file */
+    uint32_t ports;                        /**< Number of emulated gpio ports */
+    uint32_t changes;                      /**< Counter of updates of the ports, futex to wait for outputs */
+    uint32_t waiters;                      /**< Number of processes waiting on changes */
+    uint32_t request;                      /**< Counter of input requests written, futex of the board */
+    uint32_t applied;                      /**< Last input request applied, futex to wait for the board */
+    uint8_t port;                          /**< Number of the gpio port of the input request */
+    uint8_t mask;                          /**< Mask of the inputs to change in the input request */
+    uint8_t value;                         /**< New value of the inputs in the input request */
+    uint8_t reserved;                      /**< Unused, keeps the ports state aligned */
+    uint8_t state[HAL_GPIO_SHARED_PORTS];  /**< Current state of the emulated gpio ports, read only */
+};
+
 /* === Public variable declarations ============================================================ */
 
 /** @cond !INTERNAL */
@@ -86,10 +119,121 @@ extern const hal_gpio_bit_t HAL_GPIO3_4; /**< Constant to define Bit 4 on GPIO 3
 extern const hal_gpio_bit_t HAL_GPIO3_5; /**< Constant to define Bit 5 on GPIO 3 */
 extern const hal_gpio_bit_t HAL_GPIO3_6; /**< Constant to define Bit 6 on GPIO 3 */
 extern const hal_gpio_bit_t HAL_GPIO3_7; /**< Constant to define Bit 7 on GPIO 3 */
+
+#define HAL_GPIO0_0_FAST HAL_GPIO0_0 /**< Bit 0 on GPIO 0 for the fast path */
+#define HAL_GPIO0_1_FAST HAL_GPIO0_1 /**< Bit 1 on GPIO 0 for the fast path */
+#define HAL_GPIO0_2_FAST HAL_GPIO0_2 /**< Bit 2 on GPIO 0 for the fast path */
+#define HAL_GPIO0_3_FAST HAL_GPIO0_3 /**< Bit 3 on GPIO 0 for the fast path */
+#define HAL_GPIO0_4_FAST HAL_GPIO0_4 /**< Bit 4 on GPIO 0 for the fast path */
+#define HAL_GPIO0_5_FAST HAL_GPIO0_5 /**< Bit 5 on GPIO 0 for the fast path */
+#define HAL_GPIO0_6_FAST HAL_GPIO0_6 /**< Bit 6 on GPIO 0 for the fast path */
+#define HAL_GPIO0_7_FAST HAL_GPIO0_7 /**< Bit 7 on GPIO 0 for the fast path */
+
+#define HAL_GPIO1_0_FAST HAL_GPIO1_0 /**< Bit 0 on GPIO 1 for the fast path */
+#define HAL_GPIO1_1_FAST HAL_GPIO1_1 /**< Bit 1 on GPIO 1 for the fast path */
+#define HAL_GPIO1_2_FAST HAL_GPIO1_2 /**< Bit 2 on GPIO 1 for the fast path */
+#define HAL_GPIO1_3_FAST HAL_GPIO1_3 /**< Bit 3 on GPIO 1 for the fast path */
+#define HAL_GPIO1_4_FAST HAL_GPIO1_4 /**< Bit 4 on GPIO 1 for the fast path */
+#define HAL_GPIO1_5_FAST HAL_GPIO1_5 /**< Bit 5 on GPIO 1 for the fast path */
+#define HAL_GPIO1_6_FAST HAL_GPIO1_6 /**< Bit 6 on GPIO 1 for the fast path */
+#define HAL_GPIO1_7_FAST HAL_GPIO1_7 /**< Bit 7 on GPIO 1 for the fast path */
+
+#define HAL_GPIO2_0_FAST HAL_GPIO2_0 /**< Bit 0 on GPIO 2 for the fast path */
+#define HAL_GPIO2_1_FAST HAL_GPIO2_1 /**< Bit 1 on GPIO 2 for the fast path */
+#define HAL_GPIO2_2_FAST HAL_GPIO2_2 /**< Bit 2 on GPIO 2 for the fast path */
+#define HAL_GPIO2_3_FAST HAL_GPIO2_3 /**< Bit 3 on GPIO 2 for the fast path */
+#define HAL_GPIO2_4_FAST HAL_GPIO2_4 /**< Bit 4 on GPIO 2 for the fast path */
+#define HAL_GPIO2_5_FAST HAL_GPIO2_5 /**< Bit 5 on GPIO 2 for the fast path */
+#define HAL_GPIO2_6_FAST HAL_GPIO2_6 /**< Bit 6 on GPIO 2 for the fast path */
+#define HAL_GPIO2_7_FAST HAL_GPIO2_7 /**< Bit 7 on GPIO 2 for the fast path */
+
+#define HAL_GPIO3_0_FAST HAL_GPIO3_0 /**< Bit 0 on GPIO 3 for the fast path */
+#define HAL_GPIO3_1_FAST HAL_GPIO3_1 /**< Bit 1 on GPIO 3 for the fast path */
+#define HAL_GPIO3_2_FAST HAL_GPIO3_2 /**< Bit 2 on GPIO 3 for the fast path */
+#define HAL_GPIO3_3_FAST HAL_GPIO3_3 /**< Bit 3 on GPIO 3 for the fast path */
+#define HAL_GPIO3_4_FAST HAL_GPIO3_4 /**< Bit 4 on GPIO 3 for the fast path */
+#define HAL_GPIO3_5_FAST HAL_GPIO3_5 /**< Bit 5 on GPIO 3 for the fast path */
+#define HAL_GPIO3_6_FAST HAL_GPIO3_6 /**< Bit 6 on GPIO 3 for the fast path */
+#define HAL_GPIO3_7_FAST HAL_GPIO3_7 /**< Bit 7 on GPIO 3 for the fast path */
 /** @endcond */
 
 /* === Public function declarations ============================================================ */
 
+/**
+ * @brief Function to change the value of several emulated inputs of a gpio port at the same time
+ *
+ * The events of the inputs that changed are raised as the group interrupt of the hardware does,
+ * one for each changed input with an event handler for the edge.
+ *
+ * @param  port     Number of the emulated gpio port
+ * @param  mask     Mask of the inputs to change
+ * @param  value    New value of the inputs in the mask
+ */
+void GpioEmulateInputs(hal_gpio_port_t port, hal_gpio_mask_t mask, hal_gpio_mask_t value);
+
+/**
+ * @brief Function to move the emulated gpio ports to a file shared with other processes
+ *
+ * The file is created if it does not exist and a thread applies the input requests of the other
+ * processes. It must be called before the gpio terminals are configured and the threads that use
+ * them are started.
+ *
+ * @param  path     Name of the file, usually in /dev/shm
+ * @return true     The gpio ports are shared with other processes
+ * @return false    The file could not be created or mapped, the gpio ports remain private
+ */
+bool GpioShareState(const char * path);
+
+/**
+ * @brief Function of the fast path to set a gpio output
+ *
+ * The emulated ports have no registers, the fast path functions keep the descriptor of the terminal and
+ * call the functions of the SOC, so the outputs are drawn and shared as with the rest of the api.
+ *
+ * @param  gpio     Constant with the gpio terminal descriptor
+ */
+static inline void GpioFastSet(hal_gpio_bit_t gpio) {
+    GpioBitSet(gpio);
+}
+
+/**
+ * @brief Function of the fast path to clear a gpio output
+ *
+ * @param  gpio     Constant with the gpio terminal descriptor
+ */
+static inline void GpioFastClear(hal_gpio_bit_t gpio) {
+    GpioBitClear(gpio);
+}
+
+/**
+ * @brief Function of the fast path to change a gpio output
+ *
+ * @param  gpio     Constant with the gpio terminal descriptor
+ * @param  state    New state of the gpio output
+ */
+static inline void GpioFastWrite(hal_gpio_bit_t gpio, bool state) {
+    GpioSetState(gpio, state);
+}
+
+/**
+ * @brief Function of the fast path to invert a gpio output
+ *
+ * @param  gpio     Constant with the gpio terminal descriptor
+ */
+static inline void GpioFastToggle(hal_gpio_bit_t gpio) {
+    GpioBitToogle(gpio);
+}
+
+/**
+ * @brief Function of the fast path to read a gpio terminal
+ *
+ * @param  gpio     Constant with the gpio terminal descriptor
+ * @return bool     Current state of the gpio terminal
+ */
+static inline bool GpioFastGet(hal_gpio_bit_t gpio) {
+    return GpioGetState(gpio);
+}
+
 /* === End of documentation ==================================================================== */
 
 #ifdef __cplusplus
@@ -50,6 +50,9 @@ extern "C" {
 
 /* === Public variable declarations ============================================================ */
 
+extern const hal_sci_t HAL_SCI_PTY0; /**< Constant to define serial port 0, emulated with a pseudo terminal */
+extern const hal_sci_t HAL_SCI_PTY1; /**< Constant to define serial port 1, emulated with a pseudo terminal */
+
 /* === Public function declarations ============================================================ */
 
 /* === End of documentation ==================================================================== */
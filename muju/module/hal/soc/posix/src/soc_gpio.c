@@ -34,14 +34,50 @@ SPDX-License-Identifier: MIT
 
 /* === Headers files inclusions =============================================================== */
 
+#define _DEFAULT_SOURCE
+
 #include "soc_gpio.h"
+#include "hal_event.h"
 #include <stdio.h>
 #include <pthread.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
 #include <termios.h>
+#include <time.h>
 #include <unistd.h>
 
 /* === Macros definitions ====================================================================== */
 
+/**
+ * @brief Macro to configure the number of gpio terminals that can handle events at the same time
+ */
+#ifndef HAL_GPIO_EVENT_HANDLERS
+#define HAL_GPIO_EVENT_HANDLERS 32
+#endif
+
+/**
+ * @brief Macro to configure the maximum number of times per second that the emulated gpio state is drawn
+ *
+ * With a value of zero the state is never drawn, for headless runs and benchmarks.
+ */
+#ifndef HAL_GPIO_FRAME_RATE
+#define HAL_GPIO_FRAME_RATE 30
+#endif
+
+#if HAL_GPIO_EVENT_HANDLERS > 255
+#error "The gpio event handlers are indexed with a byte"
+#endif
+
+/**
+ * @brief Number of emulated gpio ports
+ */
+#define GPIO_PORTS 4
+
 /**
  * @brief Macro to generate the name of an descriptor from the gpio port and bit
  */
@@ -67,10 +103,9 @@ struct hal_gpio_bit_s {
  * @brief Structure to store a gpio bit event handler
  */
 typedef struct event_handler_s {
+    hal_gpio_bit_t gpio;      /**< Pointer to the structure with the gpio terminal descriptor */
     hal_gpio_event_t handler; /**< Function to call on the gpio bits events */
     void * object;            /**< Pointer to user data sended as parameter in handler calls */
-    bool rising : 1;          /**< Flag to indicate if rissig edge raises an event */
-    bool falling : 1;         /**< Flag to indicate if falling edge raises an event */
 } * event_handler_t;
 
 /* === Private variable declarations =========================================================== */
@@ -78,12 +113,38 @@ typedef struct event_handler_s {
 /**
  * @brief Variable to maintain the state of the emulated gpio terminals
  */
-static uint8_t gpio_emulation[4];
+static uint8_t gpio_emulation[GPIO_PORTS];
+
+/**
+ * @brief Pointer to the state of the emulated gpio terminals, private or in the file shared with other processes
+ */
+static uint8_t * gpio_state = gpio_emulation;
+
+/**
+ * @brief Pointer to the state shared with other processes, NULL while the gpio ports are private
+ */
+static struct hal_gpio_shared_s * shared = NULL;
+
+/**
+ * @brief Masks of the emulated gpio terminals of each port that changed since they were last drawn
+ */
+static uint8_t status_changes[GPIO_PORTS] = {0};
 
 /**
  * @brief Vector to store the event handlers of the gpio bits
  */
-static struct event_handler_s event_handlers[32] = {0};
+static struct event_handler_s event_handlers[HAL_GPIO_EVENT_HANDLERS] = {0};
+
+/**
+ * @brief Position plus one in the event handlers vector of the descriptor assigned to each gpio terminal
+ */
+static uint8_t handler_index[GPIO_PORTS][8] = {0};
+
+/**
+ * @brief Masks of the terminals of each gpio port that raise events on each edge
+ */
+static uint8_t events_rising[GPIO_PORTS] = {0};
+static uint8_t events_falling[GPIO_PORTS] = {0};
 
 /* === Private function declarations =========================================================== */
 
@@ -95,17 +156,79 @@ static struct event_handler_s event_handlers[32] = {0};
  */
 static void * KeyboardThread(void * _);
 
+#if HAL_GPIO_FRAME_RATE > 0
+/**
+ * @brief Function to implement a main loop of a thread to draw the changed gpio terminals at the frame rate
+ *
+ * @param _         Pointer to initial data, required by function prototype, unused
+ * @return void*    Pointer to result data, required by function prototype, unused
+ */
+static void * RenderThread(void * _);
+#endif
+
+/**
+ * @brief Function to implement a main loop of a thread to apply the input requests of other processes
+ *
+ * @param _         Pointer to initial data, required by function prototype, unused
+ * @return void*    Pointer to result data, required by function prototype, unused
+ */
+static void * SharedThread(void * _);
+
+/**
+ * @brief Function to wait until the value of a futex word in the shared state changes
+ *
+ * @param  word     Pointer to the futex word
+ * @param  value    Value of the futex word to wait to change
+ */
+static void FutexWait(uint32_t * word, uint32_t value);
+
+/**
+ * @brief Function to wake all the processes waiting on a futex word in the shared state
+ *
+ * @param  word     Pointer to the futex word
+ */
+static void FutexWake(uint32_t * word);
+
+/**
+ * @brief Function to change the state of several emulated gpio terminals of a port in a single atomic update
+ *
+ * @param  port     Number of the emulated gpio port
+ * @param  mask     Mask of the gpio terminals to change
+ * @param  value    New value of the gpio terminals in the mask
+ * @param  state    Pointer to variable to return the state of the port after the update
+ * @return          State of the port before the update
+ */
+static uint8_t WriteState(uint8_t port, uint8_t mask, uint8_t value, uint8_t * state);
+
+/**
+ * @brief Function to call the handler of a gpio event, or to defer it when HAL_EVENT_DEFERRED is defined
+ *
+ * @param  descriptor   Pointer to the structure with the event handler of the gpio terminal
+ * @param  rising       Flag to indicate that the event was raised by a rising edge
+ */
+static void GpioRaiseEvent(event_handler_t descriptor, bool rising);
+
+/**
+ * @brief Function to dispatch the events of the gpio terminals of a port that changed
+ *
+ * @param  port     Number of the emulated gpio port
+ * @param  changed  Mask of the gpio terminals that changed
+ * @param  state    State of the port left by the update that changed the terminals
+ */
+static void GpioHandleGroup(uint8_t port, uint8_t changed, uint8_t state);
+
 /**
  * @brief Function to draw on screen initial state of emulated gpio terminals
  */
 void DrawStatus(void);
 
 /**
- * @brief Function to refresh on screen current state of one emulated gpio terminal
+ * @brief Function to record that several emulated gpio terminals of a port must be drawn again
  *
- * @param  gpio     Pointer to the structure with the gpio terminal descriptor
+ * @param  gpio     Number of the emulated gpio port
+ * @param  bits     Mask of the gpio terminals to refresh
  */
-void RefreshStatus(hal_gpio_bit_t gpio);
+void RefreshStatus(uint8_t gpio, uint8_t bits);
 
 /* === Public variable definitions ============================================================= */
 
@@ -157,7 +280,6 @@ const hal_gpio_bit_t GPIO_BIT(3, 7); /**< Constant to define Bit 7 on GPIO 3 */
 
 static void * KeyboardThread(void * _) {
     struct termios ttystate;
-    struct hal_gpio_bit_s gpio = {.gpio = 0, .bit = 0};
     char key;
 
     tcgetattr(STDIN_FILENO, &ttystate);
@@ -168,27 +290,54 @@ static void * KeyboardThread(void * _) {
     while (true) {
         key = getchar();
         if ((key >= '1') && (key <= '8')) {
-            gpio.gpio = 0;
-            gpio.bit = key - '1';
-            GpioBitToogle(&gpio);
-
-            event_handler_t descriptor = &event_handlers[8 * gpio.gpio + gpio.bit];
-            if (descriptor->handler != NULL) {
-                if (GpioGetState(&gpio)) {
-                    if (descriptor->rising) {
-                        descriptor->handler(&gpio, true, descriptor->object);
-                    }
-                } else {
-                    if (descriptor->falling) {
-                        descriptor->handler(&gpio, false, descriptor->object);
-                    }
-                }
-            }
+            uint8_t mask = 1 << (key - '1');
+            uint8_t previous = __atomic_fetch_xor(&gpio_state[0], mask, __ATOMIC_RELAXED);
+
+            RefreshStatus(0, mask);
+            GpioHandleGroup(0, mask, previous ^ mask);
         }
     }
     return 0;
 }
 
+// Retries when another thread changed the port between the read and the write, so no change is lost
+static uint8_t WriteState(uint8_t port, uint8_t mask, uint8_t value, uint8_t * state) {
+    uint8_t previous = __atomic_load_n(&gpio_state[port], __ATOMIC_RELAXED);
+
+    do {
+        *state = (previous & ~mask) | (value & mask);
+    } while (!__atomic_compare_exchange_n(&gpio_state[port], &previous, *state, true, __ATOMIC_RELAXED,
+                                          __ATOMIC_RELAXED));
+    return previous;
+}
+
+// When the queue is full the handler is called here, so the event is not lost
+static void GpioRaiseEvent(event_handler_t descriptor, bool rising) {
+#ifdef HAL_EVENT_DEFERRED
+    if (HalEventPostGpio(descriptor->handler, descriptor->gpio, rising, descriptor->object)) {
+        return;
+    }
+#endif
+    descriptor->handler(descriptor->gpio, rising, descriptor->object);
+}
+
+// As the group interrupt of the lpc43xx, the cost only depends on the terminals that changed. The edges are taken
+// from the state left by the update, not read again, so each change raises exactly one event
+static void GpioHandleGroup(uint8_t port, uint8_t changed, uint8_t state) {
+    changed &= events_rising[port] | events_falling[port];
+    while (changed) {
+        uint8_t bit = __builtin_ctz(changed);
+        uint8_t mask = 1 << bit;
+        uint8_t index = handler_index[port][bit];
+
+        changed &= changed - 1;
+        if ((index) && ((state & mask) ? (events_rising[port] & mask) : (events_falling[port] & mask))) {
+            event_handler_t descriptor = &event_handlers[index - 1];
+            GpioRaiseEvent(descriptor, (state & mask) != 0);
+        }
+    }
+}
+
 void DrawStatus(void) {
     static const char DRAW_INIT[] = "\033[2J\033[1;1H";
     static const char DRAW_BIT[] = "%d=\033[1;31m%d\033[0m";
@@ -196,11 +345,14 @@ void DrawStatus(void) {
 
     int gpio, bit;
 
+    for (gpio = 0; gpio < GPIO_PORTS; gpio++) {
+        __atomic_store_n(&status_changes[gpio], 0, __ATOMIC_RELAXED);
+    }
     printf(DRAW_INIT);
-    for (gpio = 0; gpio < 4; gpio++) {
+    for (gpio = 0; gpio < GPIO_PORTS; gpio++) {
         printf("GPIO %d: ", gpio);
         for (bit = 7; bit >= 0; bit--) {
-            printf(DRAW_BIT, bit, (gpio_emulation[gpio] >> (bit)) & 0x01);
+            printf(DRAW_BIT, bit, (__atomic_load_n(&gpio_state[gpio], __ATOMIC_RELAXED) >> (bit)) & 0x01);
             if (bit > 0) {
                 printf(", ");
             }
@@ -210,15 +362,82 @@ void DrawStatus(void) {
     printf(DRAW_END);
 }
 
-void RefreshStatus(hal_gpio_bit_t gpio) {
-    static const char DRAW_BIT[] = "\033[%d;%dH\033[1;%dm%d\033[0m";
+// The outputs only change the image in memory, the screen is updated by the render thread. Other processes are
+// only woken with a system call when one of them is waiting for the outputs
+void RefreshStatus(uint8_t gpio, uint8_t bits) {
+    if ((__atomic_load_n(&status_changes[gpio], __ATOMIC_RELAXED) & bits) != bits) {
+        __atomic_fetch_or(&status_changes[gpio], bits, __ATOMIC_RELAXED);
+    }
+    if (shared && bits) {
+        __atomic_fetch_add(&shared->changes, 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&shared->waiters, __ATOMIC_SEQ_CST)) {
+            FutexWake(&shared->changes);
+        }
+    }
+}
+
+static void FutexWait(uint32_t * word, uint32_t value) {
+    syscall(SYS_futex, word, FUTEX_WAIT, value, NULL, NULL, 0);
+}
+
+static void FutexWake(uint32_t * word) {
+    syscall(SYS_futex, word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
 
-    uint8_t value = (gpio_emulation[gpio->gpio] >> (gpio->bit)) & 0x01;
+// The requests are applied as the emulated inputs of the keyboard, raising the events of the inputs that changed
+static void * SharedThread(void * _) {
+    uint32_t applied = __atomic_load_n(&shared->applied, __ATOMIC_ACQUIRE);
 
-    printf(DRAW_BIT, gpio->gpio + 1, 46 - 5 * gpio->bit, value ? 32 : 31, value);
-    fflush(stdout);
+    while (true) {
+        uint32_t request = __atomic_load_n(&shared->request, __ATOMIC_ACQUIRE);
+
+        if (request == applied) {
+            FutexWait(&shared->request, applied);
+        } else {
+            GpioEmulateInputs(shared->port, shared->mask, shared->value);
+            applied = request;
+            __atomic_store_n(&shared->applied, applied, __ATOMIC_RELEASE);
+            FutexWake(&shared->applied);
+        }
+    }
+    return 0;
 }
 
+#if HAL_GPIO_FRAME_RATE > 0
+// Several changes of a terminal between two frames are drawn once, with its last state
+static void * RenderThread(void * _) {
+    static const char DRAW_BIT[] = "\033[%d;%dH\033[1;%dm%d\033[0m";
+    static const char DRAW_END[] = "\033[5;1H";
+    const struct timespec period = {
+        .tv_sec = 1 / HAL_GPIO_FRAME_RATE,
+        .tv_nsec = 1000000000L / HAL_GPIO_FRAME_RATE % 1000000000L,
+    };
+
+    while (true) {
+        bool drawn = false;
+
+        nanosleep(&period, NULL);
+        for (int gpio = 0; gpio < GPIO_PORTS; gpio++) {
+            uint8_t bits = __atomic_exchange_n(&status_changes[gpio], 0, __ATOMIC_RELAXED);
+            uint8_t state = __atomic_load_n(&gpio_state[gpio], __ATOMIC_RELAXED);
+
+            for (int bit = 0; bits != 0; bit++, bits >>= 1) {
+                if (bits & 0x01) {
+                    uint8_t value = (state >> bit) & 0x01;
+                    printf(DRAW_BIT, gpio + 1, 46 - 5 * bit, value ? 32 : 31, value);
+                    drawn = true;
+                }
+            }
+        }
+        if (drawn) {
+            printf(DRAW_END);
+            fflush(stdout);
+        }
+    }
+    return 0;
+}
+#endif
+
 /* === Public function implementation ========================================================== */
 
 void GpioSetDirection(hal_gpio_bit_t gpio, bool output) {
@@ -226,9 +445,18 @@ void GpioSetDirection(hal_gpio_bit_t gpio, bool output) {
     static pthread_t thread;
 
     if (!initied_status) {
+        sigset_t signals, previous;
+
         initied_status = true;
-        DrawStatus();
+        // The threads inherit a mask with all signals blocked, so they never handle the emulated interrupts
+        sigfillset(&signals);
+        pthread_sigmask(SIG_SETMASK, &signals, &previous);
         pthread_create(&thread, NULL, KeyboardThread, NULL);
+#if HAL_GPIO_FRAME_RATE > 0
+        DrawStatus();
+        pthread_create(&thread, NULL, RenderThread, NULL);
+#endif
+        pthread_sigmask(SIG_SETMASK, &previous, NULL);
     }
     if (!output) {
         GpioBitSet(gpio);
@@ -238,7 +466,7 @@ void GpioSetDirection(hal_gpio_bit_t gpio, bool output) {
 bool GpioGetState(hal_gpio_bit_t gpio) {
     bool result = false;
     if (gpio) {
-        result = (gpio_emulation[gpio->gpio] & (1 << gpio->bit)) != 0;
+        result = (__atomic_load_n(&gpio_state[gpio->gpio], __ATOMIC_RELAXED) & (1 << gpio->bit)) != 0;
     }
     return result;
 }
@@ -253,35 +481,157 @@ void GpioSetState(hal_gpio_bit_t gpio, bool state) {
 
 void GpioBitSet(hal_gpio_bit_t gpio) {
     if (gpio) {
-        gpio_emulation[gpio->gpio] |= (1 << gpio->bit);
-        RefreshStatus(gpio);
+        __atomic_fetch_or(&gpio_state[gpio->gpio], 1 << gpio->bit, __ATOMIC_RELAXED);
+        RefreshStatus(gpio->gpio, 1 << gpio->bit);
     }
 }
 
 void GpioBitClear(hal_gpio_bit_t gpio) {
     if (gpio) {
-        gpio_emulation[gpio->gpio] &= ~(1 << gpio->bit);
-        RefreshStatus(gpio);
+        __atomic_fetch_and(&gpio_state[gpio->gpio], ~(1 << gpio->bit), __ATOMIC_RELAXED);
+        RefreshStatus(gpio->gpio, 1 << gpio->bit);
     }
 }
 
 void GpioBitToogle(hal_gpio_bit_t gpio) {
     if (gpio) {
-        gpio_emulation[gpio->gpio] ^= (1 << gpio->bit);
-        RefreshStatus(gpio);
+        __atomic_fetch_xor(&gpio_state[gpio->gpio], 1 << gpio->bit, __ATOMIC_RELAXED);
+        RefreshStatus(gpio->gpio, 1 << gpio->bit);
+    }
+}
+
+hal_gpio_port_t GpioGetPort(hal_gpio_bit_t gpio) {
+    hal_gpio_port_t port = 0;
+    if (gpio) {
+        port = gpio->gpio;
+    }
+    return port;
+}
+
+hal_gpio_mask_t GpioGetMask(hal_gpio_bit_t gpio) {
+    hal_gpio_mask_t mask = 0;
+    if (gpio) {
+        mask = 1UL << gpio->bit;
+    }
+    return mask;
+}
+
+hal_gpio_mask_t GpioPortGetState(hal_gpio_port_t port, hal_gpio_mask_t mask) {
+    hal_gpio_mask_t value = 0;
+    if (port < GPIO_PORTS) {
+        value = __atomic_load_n(&gpio_state[port], __ATOMIC_RELAXED) & mask;
+    }
+    return value;
+}
+
+// Only the terminals that changed are drawn again, with a single flush of the output
+void GpioPortSetState(hal_gpio_port_t port, hal_gpio_mask_t mask, hal_gpio_mask_t value) {
+    if (port < GPIO_PORTS) {
+        uint8_t state;
+        uint8_t previous = WriteState(port, mask, value, &state);
+        RefreshStatus(port, previous ^ state);
+    }
+}
+
+void GpioPortSet(hal_gpio_port_t port, hal_gpio_mask_t mask) {
+    if (port < GPIO_PORTS) {
+        uint8_t previous = __atomic_fetch_or(&gpio_state[port], mask, __ATOMIC_RELAXED);
+        RefreshStatus(port, ~previous & mask);
+    }
+}
+
+void GpioPortClear(hal_gpio_port_t port, hal_gpio_mask_t mask) {
+    if (port < GPIO_PORTS) {
+        uint8_t previous = __atomic_fetch_and(&gpio_state[port], ~mask, __ATOMIC_RELAXED);
+        RefreshStatus(port, previous & mask);
     }
 }
 
 void GpioSetEventHandler(hal_gpio_bit_t gpio, hal_gpio_event_t handler, void * object, bool rising,
                          bool falling) {
+    uint8_t mask;
+    uint8_t index;
+
+    if (gpio == NULL) {
+        return;
+    }
+    mask = 1 << gpio->bit;
+    events_rising[gpio->gpio] &= ~mask;
+    events_falling[gpio->gpio] &= ~mask;
+    index = handler_index[gpio->gpio][gpio->bit];
+    if (index) {
+        memset(&event_handlers[index - 1], 0, sizeof(event_handlers[0]));
+        handler_index[gpio->gpio][gpio->bit] = 0;
+    }
 
-    uint8_t index = 8 * gpio->gpio + gpio->bit;
-    event_handler_t descriptor = &event_handlers[index];
+    if (((rising) || (falling)) && (handler)) {
+        for (index = 0; index < HAL_GPIO_EVENT_HANDLERS; index++) {
+            if (event_handlers[index].handler == NULL) {
+                break;
+            }
+        }
+        if (index < HAL_GPIO_EVENT_HANDLERS) {
+            event_handler_t descriptor = &event_handlers[index];
+
+            descriptor->gpio = gpio;
+            descriptor->handler = handler;
+            descriptor->object = object;
+            handler_index[gpio->gpio][gpio->bit] = index + 1;
+            if (rising) {
+                events_rising[gpio->gpio] |= mask;
+            }
+            if (falling) {
+                events_falling[gpio->gpio] |= mask;
+            }
+        }
+    }
+}
+
+void GpioEmulateInputs(hal_gpio_port_t port, hal_gpio_mask_t mask, hal_gpio_mask_t value) {
+    if (port < GPIO_PORTS) {
+        uint8_t state;
+        uint8_t previous = WriteState(port, mask, value, &state);
+        RefreshStatus(port, previous ^ state);
+        GpioHandleGroup(port, previous ^ state, state);
+    }
+}
+
+bool GpioShareState(const char * path) {
+    static pthread_t thread;
+    struct hal_gpio_shared_s * mapped;
+    sigset_t signals, previous;
+    int file;
+
+    _Static_assert(HAL_GPIO_SHARED_PORTS == GPIO_PORTS, "The shared state must hold all the emulated ports");
+
+    file = open(path, O_RDWR | O_CREAT, 0600);
+    if (file < 0) {
+        return false;
+    }
+    if (ftruncate(file, sizeof(*mapped)) != 0) {
+        close(file);
+        return false;
+    }
+    mapped = mmap(NULL, sizeof(*mapped), PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    close(file);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
 
-    descriptor->handler = handler;
-    descriptor->object = object;
-    descriptor->rising = rising;
-    descriptor->falling = falling;
+    // The magic is written last, so the other processes never see a partially initialized state
+    memset(mapped, 0, sizeof(*mapped));
+    mapped->ports = GPIO_PORTS;
+    memcpy(mapped->state, gpio_emulation, sizeof(mapped->state));
+    shared = mapped;
+    gpio_state = mapped->state;
+    __atomic_store_n(&mapped->magic, HAL_GPIO_SHARED_MAGIC, __ATOMIC_RELEASE);
+
+    // The thread inherits a mask with all signals blocked, so it never handles the emulated interrupts
+    sigfillset(&signals);
+    pthread_sigmask(SIG_SETMASK, &signals, &previous);
+    pthread_create(&thread, NULL, SharedThread, NULL);
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+    return true;
 }
 
 /* === End of documentation ==================================================================== */
@@ -26,6 +26,9 @@ SPDX-License-Identifier: MIT
 /** @file
  ** @brief Serial ports on posix implementation
  **
+ ** Each serial port is emulated with a pseudo terminal. When the port is configured the name of the
+ ** slave side is printed on standard error, so other program can open it as a serial device.
+ **
  ** @addtogroup posix Posix
  ** @ingroup hal
  ** @brief Posix SOC Hardware abstraction layer
@@ -34,42 +37,251 @@ SPDX-License-Identifier: MIT
 
 /* === Headers files inclusions =============================================================== */
 
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+
 #include "soc_sci.h"
+#include "hal_event.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <termios.h>
+#include <unistd.h>
 
 /* === Macros definitions ====================================================================== */
 
+/**
+ * @brief Macro to define an serial port descriptor
+ */
+#define SCI_PORT(INDEX)                                                                            \
+    HAL_SCI_PTY##INDEX = &(struct hal_sci_s) { .index = INDEX }
+
+/**
+ * @brief Amount of serial ports emulated
+ */
+#define SCI_PORTS 2
+
 /* === Private data type declarations ========================================================== */
 
+/**
+ * @brief Structure with the serial port descriptor
+ */
+struct hal_sci_s {
+    uint8_t index; /**< Number of serial port */
+};
+
+/**
+ * @brief Structure to store the state of an emulated serial port
+ */
+typedef struct sci_emulation_s {
+    int master;              /**< File descriptor of the master side of the pseudo terminal */
+    int slave;               /**< File descriptor kept open to avoid hangups when no program uses the port */
+    hal_sci_event_t handler; /**< Function to call on the serial port events */
+    void * object;           /**< Pointer to user data sended as parameter in handler calls */
+    pthread_t thread;        /**< Thread waiting for data to raise the reception events */
+    bool pending;            /**< Flag to indicate that a deferred event has not been handled yet */
+    bool running : 1;        /**< Flag to indicate if the events thread was started */
+} * sci_emulation_t;
+
 /* === Private variable declarations =========================================================== */
 
+/**
+ * @brief Vector to store the state of the emulated serial ports
+ */
+static struct sci_emulation_s sci_emulation[SCI_PORTS] = {
+    {.master = -1, .slave = -1},
+    {.master = -1, .slave = -1},
+};
+
 /* === Private function declarations =========================================================== */
 
+/**
+ * @brief Function to implement a main loop of a thread to wait data in a serial port
+ *
+ * @param  object   Pointer to the structure with the serial port descriptor
+ * @return void*    Pointer to result data, required by function prototype, unused
+ */
+static void * EventsThread(void * object);
+
+/**
+ * @brief Function to call the handler of a serial port event, or to defer it when HAL_EVENT_DEFERRED is defined
+ *
+ * @param  sci      Pointer to the structure with the serial port descriptor
+ * @param  status   Pointer to structure with flags that raises the event
+ */
+static void SciRaiseEvent(hal_sci_t sci, sci_status_t status);
+
+#ifdef HAL_EVENT_DEFERRED
+/**
+ * @brief Function to enable again the events of a serial port once the handler of its deferred event returned
+ *
+ * @param  sci      Pointer to the structure with the serial port descriptor
+ */
+static void SciResumeEvents(hal_sci_t sci);
+#endif
+
 /* === Public variable definitions ============================================================= */
 
+/**
+ * @addtogroup posixSci SCI Constants
+ * @brief Constant for serial ports on board
+ * @{
+ */
+const hal_sci_t SCI_PORT(0); /**< Constant to define serial port 0 */
+const hal_sci_t SCI_PORT(1); /**< Constant to define serial port 1 */
+/** @} End of group posixSci */
+
 /* === Private variable definitions ============================================================ */
 
 /* === Private function implementation ========================================================= */
 
+// As the line of a serial port, the data stays pending until a handler reads it
+static void SciRaiseEvent(hal_sci_t sci, sci_status_t status) {
+    sci_emulation_t port = &sci_emulation[sci->index];
+
+#ifdef HAL_EVENT_DEFERRED
+    __atomic_store_n(&port->pending, true, __ATOMIC_RELAXED);
+    if (HalEventPostSci(port->handler, sci, status, port->object, SciResumeEvents)) {
+        return;
+    }
+    __atomic_store_n(&port->pending, false, __ATOMIC_RELAXED);
+#endif
+    port->handler(sci, status, port->object);
+}
+
+#ifdef HAL_EVENT_DEFERRED
+static void SciResumeEvents(hal_sci_t sci) {
+    __atomic_store_n(&sci_emulation[sci->index].pending, false, __ATOMIC_RELEASE);
+}
+#endif
+
+static void * EventsThread(void * object) {
+    hal_sci_t sci = object;
+    sci_emulation_t port = &sci_emulation[sci->index];
+    struct sci_status_s status;
+    struct pollfd descriptor = {.fd = port->master, .events = POLLIN};
+
+    while (true) {
+        // While a deferred event is pending no new events are raised
+        if (__atomic_load_n(&port->pending, __ATOMIC_ACQUIRE)) {
+            usleep(1000);
+            continue;
+        }
+        if ((poll(&descriptor, 1, -1) > 0) && (port->handler != NULL)) {
+            SciReadStatus(sci, &status);
+            if (status.data_ready) {
+                SciRaiseEvent(sci, &status);
+            }
+        }
+        // The handler must drain the input, otherwise give other threads a chance to do it
+        SciReadStatus(sci, &status);
+        if (status.data_ready) {
+            usleep(1000);
+        }
+    }
+    return 0;
+}
+
 /* === Public function implementation ========================================================== */
 
 bool SciSetConfig(hal_sci_t sci, hal_sci_line_t line, hal_sci_pins_t pins) {
-    return false;
+    sci_emulation_t port;
+    struct termios options;
+
+    if ((sci == NULL) || (sci->index >= SCI_PORTS)) {
+        return false;
+    }
+    port = &sci_emulation[sci->index];
+
+    if (port->master < 0) {
+        port->master = posix_openpt(O_RDWR | O_NOCTTY);
+        if ((port->master < 0) || (grantpt(port->master) != 0) || (unlockpt(port->master) != 0)) {
+            return false;
+        }
+        port->slave = open(ptsname(port->master), O_RDWR | O_NOCTTY);
+        fcntl(port->master, F_SETFL, fcntl(port->master, F_GETFL) | O_NONBLOCK);
+        fprintf(stderr, "SCI %d: %s\n", sci->index, ptsname(port->master));
+    }
+
+    // The baud rate is meaningless on a pseudo terminal, only the frame format is applied to the slave side
+    if ((port->slave >= 0) && (tcgetattr(port->slave, &options) == 0)) {
+        cfmakeraw(&options);
+        options.c_cflag &= ~(CSIZE | PARENB | PARODD);
+        options.c_cflag |= (line->data_bits == 7) ? CS7 : CS8;
+        if (line->parity != HAL_SCI_NO_PARITY) {
+            options.c_cflag |= PARENB | ((line->parity == HAL_SCI_ODD_PARITY) ? PARODD : 0);
+        }
+        tcsetattr(port->slave, TCSANOW, &options);
+    }
+    return true;
 }
 
 uint16_t SciSendData(hal_sci_t sci, void const * const data, uint16_t size) {
-    return size;
+    ssize_t result;
+
+    if ((sci == NULL) || (sci->index >= SCI_PORTS) || (sci_emulation[sci->index].master < 0)) {
+        return 0;
+    }
+    result = write(sci_emulation[sci->index].master, data, size);
+    // A serial line does not wait for the receiver, when nobody drains the pseudo terminal the old data is lost
+    if ((result < 0) && (errno == EAGAIN) && (sci_emulation[sci->index].slave >= 0)) {
+        tcflush(sci_emulation[sci->index].slave, TCIFLUSH);
+        result = write(sci_emulation[sci->index].master, data, size);
+    }
+    return (result > 0) ? result : 0;
 }
 
 uint16_t SciReceiveData(hal_sci_t sci, void * data, uint16_t size) {
-    return size;
+    ssize_t result;
+
+    if ((sci == NULL) || (sci->index >= SCI_PORTS) || (sci_emulation[sci->index].master < 0)) {
+        return 0;
+    }
+    result = read(sci_emulation[sci->index].master, data, size);
+    return (result > 0) ? result : 0;
 }
 
 void SciReadStatus(hal_sci_t sci, sci_status_t result) {
+    struct pollfd descriptor;
+
     memset(result, 0, sizeof(*result));
+    if ((sci == NULL) || (sci->index >= SCI_PORTS) || (sci_emulation[sci->index].master < 0)) {
+        return;
+    }
+
+    descriptor.fd = sci_emulation[sci->index].master;
+    descriptor.events = POLLIN | POLLOUT;
+    if (poll(&descriptor, 1, 0) > 0) {
+        result->data_ready = (descriptor.revents & POLLIN) != 0;
+        result->fifo_empty = (descriptor.revents & POLLOUT) != 0;
+        result->tramition_completed = result->fifo_empty;
+    }
 }
 
-void SciSetEventHandler(hal_sci_t sci, hal_sci_event_t handler, void * data) {
+void SciSetEventHandler(hal_sci_t sci, hal_sci_event_t handler, void * object) {
+    sci_emulation_t port;
+
+    if ((sci == NULL) || (sci->index >= SCI_PORTS)) {
+        return;
+    }
+    port = &sci_emulation[sci->index];
+    port->object = object;
+    port->handler = handler;
+    if ((handler != NULL) && !port->running && (port->master >= 0)) {
+        sigset_t signals, previous;
+
+        port->running = true;
+        // The thread inherits a mask with all signals blocked, so it never handles the emulated interrupts
+        sigfillset(&signals);
+        pthread_sigmask(SIG_SETMASK, &signals, &previous);
+        pthread_create(&port->thread, NULL, EventsThread, (void *)sci);
+        pthread_sigmask(SIG_SETMASK, &previous, NULL);
+    }
 }
 
 /* === End of documentation ==================================================================== */
@@ -34,10 +34,14 @@ SPDX-License-Identifier: MIT
 
 /* === Headers files inclusions =============================================================== */
 
+#define _DEFAULT_SOURCE
+
 #include "soc_tick.h"
 #include <pthread.h>
+#include <signal.h>
 #include <unistd.h>
 #include <stdio.h>
+#include <time.h>
 
 /* === Macros definitions ====================================================================== */
 
@@ -74,6 +78,11 @@ static void * TimerThread(void * _);
  */
 static struct hal_tick_s instance[1] = {0};
 
+/**
+ * @brief Monotonic time when the free running counter was started
+ */
+static struct timespec counter_start = {0};
+
 /* === Private function implementation ========================================================= */
 
 static void * TimerThread(void * _) {
@@ -89,10 +98,27 @@ static void * TimerThread(void * _) {
 /* === Public function implementation ========================================================== */
 
 void TickStart(hal_tick_event_t handler, void * object, uint32_t period) {
+    sigset_t signals, previous;
+
     instance->handler = handler;
     instance->object = object;
     instance->period = period;
+    // The thread inherits a mask with all signals blocked, so it never handles the emulated interrupts
+    sigfillset(&signals);
+    pthread_sigmask(SIG_SETMASK, &signals, &previous);
     pthread_create(&instance->thread, NULL, TimerThread, NULL);
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+}
+
+void TickCounterStart(void) {
+    clock_gettime(CLOCK_MONOTONIC, &counter_start);
+}
+
+uint32_t TickCounterRead(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((now.tv_sec - counter_start.tv_sec) * 1000000 + (now.tv_nsec - counter_start.tv_nsec) / 1000);
 }
 
 void SysTick_Handler(void) {
@@ -88,6 +88,86 @@ extern "C" {
 
 #define HAL_GPIO_PD0  ((hal_gpio_bit_t)HAL_PIN_PD0) /**< Constant to define Bit 0 on GPIO D */
 #define HAL_GPIO_PD1  ((hal_gpio_bit_t)HAL_PIN_PD1) /**< Constant to define Bit 1 on GPIO D */
+
+#define HAL_GPIO_PA0_FAST  HAL_PORT_A, 0  /**< Port and bit of Bit 0 on GPIO A for the fast path */
+#define HAL_GPIO_PA1_FAST  HAL_PORT_A, 1  /**< Port and bit of Bit 1 on GPIO A for the fast path */
+#define HAL_GPIO_PA2_FAST  HAL_PORT_A, 2  /**< Port and bit of Bit 2 on GPIO A for the fast path */
+#define HAL_GPIO_PA3_FAST  HAL_PORT_A, 3  /**< Port and bit of Bit 3 on GPIO A for the fast path */
+#define HAL_GPIO_PA4_FAST  HAL_PORT_A, 4  /**< Port and bit of Bit 4 on GPIO A for the fast path */
+#define HAL_GPIO_PA5_FAST  HAL_PORT_A, 5  /**< Port and bit of Bit 5 on GPIO A for the fast path */
+#define HAL_GPIO_PA6_FAST  HAL_PORT_A, 6  /**< Port and bit of Bit 6 on GPIO A for the fast path */
+#define HAL_GPIO_PA7_FAST  HAL_PORT_A, 7  /**< Port and bit of Bit 7 on GPIO A for the fast path */
+#define HAL_GPIO_PA8_FAST  HAL_PORT_A, 8  /**< Port and bit of Bit 8 on GPIO A for the fast path */
+#define HAL_GPIO_PA9_FAST  HAL_PORT_A, 9  /**< Port and bit of Bit 9 on GPIO A for the fast path */
+#define HAL_GPIO_PA10_FAST HAL_PORT_A, 10 /**< Port and bit of Bit 10 on GPIO A for the fast path */
+#define HAL_GPIO_PA11_FAST HAL_PORT_A, 11 /**< Port and bit of Bit 11 on GPIO A for the fast path */
+#define HAL_GPIO_PA12_FAST HAL_PORT_A, 12 /**< Port and bit of Bit 12 on GPIO A for the fast path */
+#define HAL_GPIO_PA13_FAST HAL_PORT_A, 13 /**< Port and bit of Bit 13 on GPIO A for the fast path */
+#define HAL_GPIO_PA14_FAST HAL_PORT_A, 14 /**< Port and bit of Bit 14 on GPIO A for the fast path */
+#define HAL_GPIO_PA15_FAST HAL_PORT_A, 15 /**< Port and bit of Bit 15 on GPIO A for the fast path */
+
+#define HAL_GPIO_PB0_FAST  HAL_PORT_B, 0  /**< Port and bit of Bit 0 on GPIO B for the fast path */
+#define HAL_GPIO_PB1_FAST  HAL_PORT_B, 1  /**< Port and bit of Bit 1 on GPIO B for the fast path */
+#define HAL_GPIO_PB2_FAST  HAL_PORT_B, 2  /**< Port and bit of Bit 2 on GPIO B for the fast path */
+#define HAL_GPIO_PB3_FAST  HAL_PORT_B, 3  /**< Port and bit of Bit 3 on GPIO B for the fast path */
+#define HAL_GPIO_PB4_FAST  HAL_PORT_B, 4  /**< Port and bit of Bit 4 on GPIO B for the fast path */
+#define HAL_GPIO_PB5_FAST  HAL_PORT_B, 5  /**< Port and bit of Bit 5 on GPIO B for the fast path */
+#define HAL_GPIO_PB6_FAST  HAL_PORT_B, 6  /**< Port and bit of Bit 6 on GPIO B for the fast path */
+#define HAL_GPIO_PB7_FAST  HAL_PORT_B, 7  /**< Port and bit of Bit 7 on GPIO B for the fast path */
+#define HAL_GPIO_PB8_FAST  HAL_PORT_B, 8  /**< Port and bit of Bit 8 on GPIO B for the fast path */
+#define HAL_GPIO_PB9_FAST  HAL_PORT_B, 9  /**< Port and bit of Bit 9 on GPIO B for the fast path */
+#define HAL_GPIO_PB10_FAST HAL_PORT_B, 10 /**< Port and bit of Bit 10 on GPIO B for the fast path */
+#define HAL_GPIO_PB11_FAST HAL_PORT_B, 11 /**< Port and bit of Bit 11 on GPIO B for the fast path */
+#define HAL_GPIO_PB12_FAST HAL_PORT_B, 12 /**< Port and bit of Bit 12 on GPIO B for the fast path */
+#define HAL_GPIO_PB13_FAST HAL_PORT_B, 13 /**< Port and bit of Bit 13 on GPIO B for the fast path */
+#define HAL_GPIO_PB14_FAST HAL_PORT_B, 14 /**< Port and bit of Bit 14 on GPIO B for the fast path */
+#define HAL_GPIO_PB15_FAST HAL_PORT_B, 15 /**< Port and bit of Bit 15 on GPIO B for the fast path */
+
+#define HAL_GPIO_PC13_FAST HAL_PORT_C, 13 /**< Port and bit of Bit 13 on GPIO C for the fast path */
+#define HAL_GPIO_PC14_FAST HAL_PORT_C, 14 /**< Port and bit of Bit 14 on GPIO C for the fast path */
+#define HAL_GPIO_PC15_FAST HAL_PORT_C, 15 /**< Port and bit of Bit 15 on GPIO C for the fast path */
+
+#define HAL_GPIO_PD0_FAST  HAL_PORT_D, 0  /**< Port and bit of Bit 0 on GPIO D for the fast path */
+#define HAL_GPIO_PD1_FAST  HAL_PORT_D, 1  /**< Port and bit of Bit 1 on GPIO D for the fast path */
+/** @endcond */
+
+/**
+ * @brief Address of the registers of the gpio port A, checked against the CMSIS definitions in soc_gpio.c
+ */
+#define HAL_GPIO_REGISTERS 0x40010800UL
+
+/**
+ * @brief Address of the peripherals region and of its bit-band alias, where each word maps a single bit
+ */
+#define HAL_GPIO_PERIPHERALS 0x40000000UL
+#define HAL_GPIO_BIT_BAND    0x42000000UL
+
+/** @cond INTERNAL */
+#define HAL_GPIO_PORT_SIZE   0x400UL /**< Distance between the registers of two consecutive gpio ports */
+#define HAL_GPIO_IDR_OFFSET  0x08UL  /**< Offset of the register to read the state of a port */
+#define HAL_GPIO_ODR_OFFSET  0x0CUL  /**< Offset of the register with the outputs of a port */
+#define HAL_GPIO_BSRR_OFFSET 0x10UL  /**< Offset of the register to set and reset the outputs of a port */
+#define HAL_GPIO_BRR_OFFSET  0x14UL  /**< Offset of the register to reset the outputs of a port */
+
+/**
+ * @brief Macro to calculate the address of a register of a gpio port
+ */
+#define HAL_GPIO_ADDRESS(offset, port) (HAL_GPIO_REGISTERS + HAL_GPIO_PORT_SIZE * (port) + (offset))
+
+/**
+ * @brief Macro to access a register of a gpio port
+ */
+#define HAL_GPIO_REGISTER(offset, port) (*(volatile uint32_t *)HAL_GPIO_ADDRESS(offset, port))
+
+/**
+ * @brief Macro to access a single bit of a register of a gpio port through its bit-band alias
+ *
+ * Reading the alias returns the bit as 0 or 1 and writing it changes only that bit, the bus does the
+ * read, modify and write of the register without being interrupted.
+ */
+#define HAL_GPIO_BIT_ALIAS(offset, port, bit)                                                      \
+    (*(volatile uint32_t *)(HAL_GPIO_BIT_BAND + 32 * (HAL_GPIO_ADDRESS(offset, port) - HAL_GPIO_PERIPHERALS) + \
+                            4 * (bit)))
 /** @endcond */
 
 /* === Public data type declarations =========================================================== */
@@ -96,6 +176,78 @@ extern "C" {
 
 /* === Public function declarations ============================================================ */
 
+/**
+ * @brief Function of the fast path to set a gpio output, a single write to the set and reset register
+ *
+ * @param  port     Number of the gpio port
+ * @param  bit      Number of the gpio terminal in the port
+ */
+static inline void GpioFastSet(hal_gpio_port_t port, uint8_t bit) {
+    HAL_GPIO_REGISTER(HAL_GPIO_BSRR_OFFSET, port) = 1UL << bit;
+}
+
+/**
+ * @brief Function of the fast path to clear a gpio output, a single write to the reset register
+ *
+ * @param  port     Number of the gpio port
+ * @param  bit      Number of the gpio terminal in the port
+ */
+static inline void GpioFastClear(hal_gpio_port_t port, uint8_t bit) {
+    HAL_GPIO_REGISTER(HAL_GPIO_BRR_OFFSET, port) = 1UL << bit;
+}
+
+/**
+ * @brief Function of the fast path to change a gpio output, a single write to the bit-band alias of the output
+ *
+ * @param  port     Number of the gpio port
+ * @param  bit      Number of the gpio terminal in the port
+ * @param  state    New state of the gpio output
+ */
+static inline void GpioFastWrite(hal_gpio_port_t port, uint8_t bit, bool state) {
+    HAL_GPIO_BIT_ALIAS(HAL_GPIO_ODR_OFFSET, port, bit) = state;
+}
+
+/**
+ * @brief Function of the fast path to invert a gpio output
+ *
+ * The port has no toggle register, the output is read through its bit-band alias and the change written
+ * to the set and reset register, so the other outputs of the port are never written.
+ *
+ * @param  port     Number of the gpio port
+ * @param  bit      Number of the gpio terminal in the port
+ */
+static inline void GpioFastToggle(hal_gpio_port_t port, uint8_t bit) {
+    uint32_t mask = 1UL << bit;
+    HAL_GPIO_REGISTER(HAL_GPIO_BSRR_OFFSET, port) =
+        HAL_GPIO_BIT_ALIAS(HAL_GPIO_ODR_OFFSET, port, bit) ? (mask << 16) : mask;
+}
+
+/**
+ * @brief Function of the fast path to read a gpio terminal, a single read of the bit-band alias of the input
+ *
+ * @param  port     Number of the gpio port
+ * @param  bit      Number of the gpio terminal in the port
+ * @return bool     Current state of the gpio terminal
+ */
+static inline bool GpioFastGet(hal_gpio_port_t port, uint8_t bit) {
+    return HAL_GPIO_BIT_ALIAS(HAL_GPIO_IDR_OFFSET, port, bit);
+}
+
+/**
+ * @brief Function to change several outputs of a gpio port with a single write to the set and reset register
+ *
+ * The high half of the register clears the outputs and the low half sets them, the outputs out of the
+ * mask are not changed.
+ *
+ * @param  port     Number of the gpio port
+ * @param  mask     Mask of the outputs to change
+ * @param  value    New value of the outputs in the mask
+ */
+static inline void GpioFastPortWrite(hal_gpio_port_t port, hal_gpio_mask_t mask, hal_gpio_mask_t value) {
+    mask &= 0xFFFF;
+    HAL_GPIO_REGISTER(HAL_GPIO_BSRR_OFFSET, port) = (value & mask) | ((~value & mask) << 16);
+}
+
 /* === End of documentation ==================================================================== */
 
 #ifdef __cplusplus
@@ -35,9 +35,15 @@ SPDX-License-Identifier: MIT
 /* === Headers files inclusions =============================================================== */
 
 #include "soc_gpio.h"
+#include "hal_event.h"
 #include "stm32f1xx_hal.h"
+#include <stddef.h>
 #include <string.h>
 
+#ifdef FREERTOS
+#include "FreeRTOS.h"
+#endif
+
 /**
  *  @brief Include global project config file if it's defined
  */
@@ -49,6 +55,16 @@ SPDX-License-Identifier: MIT
 
 /* === Macros definitions ====================================================================== */
 
+#if defined(HAL_EVENT_DEFERRED) && defined(FREERTOS) && !defined(HAL_EVENT_POLL_TASK)
+// The interrupts wake the task of the deferred handlers, so they must be allowed to use the FreeRTOS api
+#ifndef HAL_GPIO_NVIC_PRIORITY
+#define HAL_GPIO_NVIC_PRIORITY configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+#endif
+#if HAL_GPIO_NVIC_PRIORITY < configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+#error "The deferred events notify a task, the interrupt priority must allow to use the FreeRTOS api"
+#endif
+#endif
+
 /**
  * @brief Macro to configure priority to set on NVIC for serial port interrupts
  */
@@ -56,6 +72,11 @@ SPDX-License-Identifier: MIT
 #define HAL_GPIO_NVIC_PRIORITY 0
 #endif
 
+/**
+ * @brief Number of gpio ports in the chip
+ */
+#define GPIO_PORTS (sizeof(gpio_ports) / sizeof(*gpio_ports))
+
 /* === Private data type declarations ========================================================== */
 
 /** @brief Structure to store a gpio bit event handler */
@@ -69,6 +90,14 @@ typedef struct event_handler_s {
 
 /* === Private function declarations =========================================================== */
 
+/**
+ * @brief Function to call the handler of a gpio event, or to defer it when HAL_EVENT_DEFERRED is defined
+ *
+ * @param  descriptor   Pointer to the structure with the event handler of the gpio terminal
+ * @param  rising       Flag to indicate that the event was raised by a rising edge
+ */
+static void GpioRaiseEvent(event_handler_t descriptor, bool rising);
+
 /**
  * @brief Function to dispatch an gpio bit event when then raises an interrupt
  *
@@ -90,15 +119,35 @@ static struct event_handler_s event_handlers[16] = {0};
  */
 static GPIO_TypeDef * const gpio_ports[] = {GPIOA, GPIOB, GPIOC, GPIOD};
 
+// The fast path of soc_gpio.h writes the registers by address, without the CMSIS headers
+_Static_assert(HAL_GPIO_REGISTERS == GPIOA_BASE, "Wrong address of the gpio registers");
+_Static_assert(GPIOD_BASE - GPIOA_BASE == 3 * HAL_GPIO_PORT_SIZE, "Wrong distance between the gpio ports");
+_Static_assert(offsetof(GPIO_TypeDef, IDR) == HAL_GPIO_IDR_OFFSET, "Wrong offset of the gpio input register");
+_Static_assert(offsetof(GPIO_TypeDef, ODR) == HAL_GPIO_ODR_OFFSET, "Wrong offset of the gpio output register");
+_Static_assert(offsetof(GPIO_TypeDef, BSRR) == HAL_GPIO_BSRR_OFFSET, "Wrong offset of the gpio set register");
+_Static_assert(offsetof(GPIO_TypeDef, BRR) == HAL_GPIO_BRR_OFFSET, "Wrong offset of the gpio reset register");
+_Static_assert(HAL_GPIO_PERIPHERALS == PERIPH_BASE, "Wrong address of the peripherals region");
+_Static_assert(HAL_GPIO_BIT_BAND == PERIPH_BB_BASE, "Wrong address of the peripherals bit-band region");
+
 /* === Private function implementation ========================================================= */
 
+// When the queue is full the handler is called here, so the event is not lost
+static void GpioRaiseEvent(event_handler_t descriptor, bool rising) {
+#ifdef HAL_EVENT_DEFERRED
+    if (HalEventPostGpio(descriptor->handler, descriptor->gpio, rising, descriptor->object)) {
+        return;
+    }
+#endif
+    descriptor->handler(descriptor->gpio, rising, descriptor->object);
+}
+
 static void GpioHandleEvent(uint8_t index) {
     event_handler_t descriptor = &event_handlers[index];
     SET_BIT(EXTI->PR, 1 << index);
     bool rissing = GpioGetState(descriptor->gpio);
 
     if (descriptor->handler != NULL) {
-        descriptor->handler(descriptor->gpio, rissing, descriptor->object);
+        GpioRaiseEvent(descriptor, rissing);
     }
 }
 
@@ -140,11 +189,13 @@ void GpioSetDirection(hal_gpio_bit_t gpio, bool output) {
     }
 }
 
+// The bit operations use the same single register accesses of the fast path, so they can be used from
+// interrupts that change other outputs of the same port without losing their changes
 bool GpioGetState(hal_gpio_bit_t gpio) {
     bool value = false;
     if (gpio) {
         hal_chip_pin_t pin = (hal_chip_pin_t)gpio;
-        value = HAL_GPIO_ReadPin(gpio_ports[pin->port], 1 << pin->pin);
+        value = GpioFastGet(pin->port, pin->pin);
     }
     return value;
 }
@@ -152,29 +203,70 @@ bool GpioGetState(hal_gpio_bit_t gpio) {
 void GpioSetState(hal_gpio_bit_t gpio, bool state) {
     if (gpio) {
         hal_chip_pin_t output = (hal_chip_pin_t)gpio;
-        HAL_GPIO_WritePin(gpio_ports[output->port], 1 << output->pin,
-                          state ? GPIO_PIN_SET : GPIO_PIN_RESET);
+        GpioFastWrite(output->port, output->pin, state);
     }
 }
 
 void GpioBitSet(hal_gpio_bit_t gpio) {
     if (gpio) {
         hal_chip_pin_t output = (hal_chip_pin_t)gpio;
-        HAL_GPIO_WritePin(gpio_ports[output->port], 1 << output->pin, GPIO_PIN_SET);
+        GpioFastSet(output->port, output->pin);
     }
 }
 
 void GpioBitClear(hal_gpio_bit_t gpio) {
     if (gpio) {
         hal_chip_pin_t output = (hal_chip_pin_t)gpio;
-        HAL_GPIO_WritePin(gpio_ports[output->port], 1 << output->pin, GPIO_PIN_RESET);
+        GpioFastClear(output->port, output->pin);
     }
 }
 
 void GpioBitToogle(hal_gpio_bit_t gpio) {
     if (gpio) {
         hal_chip_pin_t output = (hal_chip_pin_t)gpio;
-        HAL_GPIO_TogglePin(gpio_ports[output->port], 1 << output->pin);
+        GpioFastToggle(output->port, output->pin);
+    }
+}
+
+hal_gpio_port_t GpioGetPort(hal_gpio_bit_t gpio) {
+    hal_gpio_port_t port = 0;
+    if (gpio) {
+        port = ((hal_chip_pin_t)gpio)->port;
+    }
+    return port;
+}
+
+hal_gpio_mask_t GpioGetMask(hal_gpio_bit_t gpio) {
+    hal_gpio_mask_t mask = 0;
+    if (gpio) {
+        mask = 1UL << ((hal_chip_pin_t)gpio)->pin;
+    }
+    return mask;
+}
+
+hal_gpio_mask_t GpioPortGetState(hal_gpio_port_t port, hal_gpio_mask_t mask) {
+    hal_gpio_mask_t value = 0;
+    if (port < GPIO_PORTS) {
+        value = gpio_ports[port]->IDR & mask;
+    }
+    return value;
+}
+
+void GpioPortSetState(hal_gpio_port_t port, hal_gpio_mask_t mask, hal_gpio_mask_t value) {
+    if (port < GPIO_PORTS) {
+        GpioFastPortWrite(port, mask, value);
+    }
+}
+
+void GpioPortSet(hal_gpio_port_t port, hal_gpio_mask_t mask) {
+    if (port < GPIO_PORTS) {
+        GpioFastPortWrite(port, mask, mask);
+    }
+}
+
+void GpioPortClear(hal_gpio_port_t port, hal_gpio_mask_t mask) {
+    if (port < GPIO_PORTS) {
+        GpioFastPortWrite(port, mask, 0);
     }
 }
 
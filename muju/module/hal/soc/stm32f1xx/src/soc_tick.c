@@ -39,6 +39,12 @@ SPDX-License-Identifier: MIT
 
 /* === Macros definitions ====================================================================== */
 
+/**
+ * @brief Timers chained to build the 32 bits free running counter, TIM3 counts the overflows of TIM2
+ */
+#define COUNTER_LOW  TIM2
+#define COUNTER_HIGH TIM3
+
 /* === Private data type declarations ========================================================== */
 
 /**
@@ -82,6 +88,46 @@ void TickStart(hal_tick_event_t handler, void * object, uint32_t period) {
     __asm volatile("cpsie i");
 }
 
+void TickCounterStart(void) {
+    uint32_t clock = HAL_RCC_GetPCLK1Freq();
+
+    /* Timers on APB1 run at twice the bus clock when the bus is prescaled */
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1) {
+        clock = 2 * clock;
+    }
+
+    __HAL_RCC_TIM2_CLK_ENABLE();
+    __HAL_RCC_TIM3_CLK_ENABLE();
+
+    /* The low timer counts microseconds and triggers the high one on each update */
+    COUNTER_LOW->PSC = clock / 1000000 - 1;
+    COUNTER_LOW->ARR = 0xFFFF;
+    COUNTER_LOW->CR2 = TIM_CR2_MMS_1;
+    COUNTER_LOW->EGR = TIM_EGR_UG;
+
+    /* The high timer uses the internal trigger 1, connected to TIM2, as external clock */
+    COUNTER_HIGH->PSC = 0;
+    COUNTER_HIGH->ARR = 0xFFFF;
+    COUNTER_HIGH->SMCR = TIM_SMCR_TS_0 | TIM_SMCR_SMS;
+    COUNTER_HIGH->EGR = TIM_EGR_UG;
+
+    COUNTER_HIGH->CR1 = TIM_CR1_CEN;
+    COUNTER_LOW->CR1 = TIM_CR1_CEN;
+}
+
+uint32_t TickCounterRead(void) {
+    uint32_t high;
+    uint32_t low;
+
+    /* Read again if the low timer overflowed between both readings */
+    do {
+        high = COUNTER_HIGH->CNT;
+        low = COUNTER_LOW->CNT;
+    } while (high != COUNTER_HIGH->CNT);
+
+    return (high << 16) | low;
+}
+
 void SysTick_Handler(void) {
     if (instance->handler) {
         instance->handler(instance->object);
@@ -0,0 +1,337 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** @file
+ ** @brief Deferred event handlers implementation
+ **
+ ** The queue is a bounded array where each slot has a turn counter. The interrupts, that can be nested,
+ ** reserve a slot with a compare and swap on the tail, fill it and then publish it with its turn, so
+ ** none of them waits for another. Only the task or the main loop reads the queue.
+ **
+ ** @addtogroup hal HAL
+ ** @brief Hardware abstraction layer
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "hal_event.h"
+#include <stddef.h>
+
+#ifdef FREERTOS
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+/**
+ *  @brief Include global project config file if it's defined
+ */
+#ifdef HAL_CONFIG_FILE
+#define STR(x)    #x     /**< Macro to convert the argument string to a constant string */
+#define TO_STR(x) STR(x) /**< Macro to convert the argument value to a constant string */
+#include TO_STR(HAL_CONFIG_FILE)
+#endif
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief Macro to configure the number of deferred events that can wait in the queue, a power of two
+ */
+#ifndef HAL_EVENT_QUEUE_SIZE
+#define HAL_EVENT_QUEUE_SIZE 16
+#endif
+
+#if (HAL_EVENT_QUEUE_SIZE & (HAL_EVENT_QUEUE_SIZE - 1)) != 0
+#error "The size of the deferred events queue must be a power of two"
+#endif
+
+#if HAL_EVENT_QUEUE_SIZE > 32768
+#error "The maximum number of pending events is counted with a half word"
+#endif
+
+#ifdef FREERTOS
+/**
+ * @brief Macro to configure the stack size, in words, of the task that calls the deferred handlers
+ */
+#ifndef HAL_EVENT_TASK_STACK
+#define HAL_EVENT_TASK_STACK (configMINIMAL_STACK_SIZE * 2)
+#endif
+
+// On the posix board the events are raised by threads unknown to FreeRTOS, they can not wake a task
+#if !defined(HAL_EVENT_POLL_TASK) && !defined(POSIX)
+#define NOTIFY_TASK 1
+#endif
+#endif
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Enumeration with the peripherals that raise deferred events
+ */
+typedef enum {
+    EVENT_GPIO, /**< Event of a gpio terminal */
+    EVENT_SCI,  /**< Event of a serial port */
+} event_source_t;
+
+/**
+ * @brief Structure to store a deferred event in a slot of the queue
+ */
+typedef struct event_record_s {
+    uint32_t turn;         /**< Position that can use the slot, minus the slot index, plus one when published */
+    event_source_t source; /**< Peripheral that raised the event */
+    void * object;         /**< Pointer to user data sended as parameter in handler call */
+    union {
+        struct {
+            hal_gpio_event_t handler; /**< Function to call on the gpio bit event */
+            hal_gpio_bit_t gpio;      /**< Descriptor of the gpio terminal that raised the event */
+            bool rising;              /**< Flag to indicate that the event was raised by a rising edge */
+        } gpio;                       /**< Data of an event of a gpio terminal */
+        struct {
+            hal_sci_event_t handler;    /**< Function to call on the serial port event */
+            hal_sci_t sci;              /**< Descriptor of the serial port that raised the event */
+            hal_event_resume_t resume;  /**< Function to enable again the events of the serial port */
+            struct sci_status_s status; /**< Flags of the serial port when the event was raised */
+        } sci;                          /**< Data of an event of a serial port */
+    };
+} * event_record_t;
+
+/* === Private variable declarations =========================================================== */
+
+/**
+ * @brief Slots of the queue of deferred events
+ */
+static struct event_record_s queue[HAL_EVENT_QUEUE_SIZE] = {0};
+
+/**
+ * @brief Position of the next slot to reserve by the interrupts
+ */
+static uint32_t queue_tail = 0;
+
+/**
+ * @brief Position of the next slot to read by the dispatcher
+ */
+static uint32_t queue_head = 0;
+
+/**
+ * @brief Counters of the deferred events
+ */
+static struct hal_event_statistics_s statistics = {0};
+
+#ifdef FREERTOS
+/**
+ * @brief Task that calls the handlers of the deferred events
+ */
+static TaskHandle_t dispatcher = NULL;
+#endif
+
+/* === Private function declarations =========================================================== */
+
+/**
+ * @brief Function to reserve the next free slot of the queue
+ *
+ * @param  position         Pointer to store the position of the reserved slot
+ * @return event_record_t   Pointer to the reserved slot, NULL if the queue is full
+ */
+static event_record_t QueueReserve(uint32_t * position);
+
+/**
+ * @brief Function to make a reserved slot of the queue visible to the dispatcher
+ *
+ * @param  record   Pointer to the reserved slot
+ * @param  position Position of the reserved slot
+ */
+static void QueuePublish(event_record_t record, uint32_t position);
+
+#ifdef FREERTOS
+/**
+ * @brief Function to implement the task that calls the handlers of the deferred events
+ *
+ * @param  object   Pointer to initial data, required by function prototype, unused
+ */
+static void DispatchTask(void * object);
+#endif
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+static event_record_t QueueReserve(uint32_t * position) {
+    uint32_t tail = __atomic_load_n(&queue_tail, __ATOMIC_RELAXED);
+    uint16_t pending, maximum;
+
+    while (true) {
+        uint32_t index = tail % HAL_EVENT_QUEUE_SIZE;
+        int32_t distance = (int32_t)(__atomic_load_n(&queue[index].turn, __ATOMIC_ACQUIRE) + index - tail);
+
+        if (distance == 0) {
+            // On failure the tail is reloaded, another interrupt took the slot
+            if (__atomic_compare_exchange_n(&queue_tail, &tail, tail + 1, true, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (distance < 0) {
+            // The slot still holds the event of the previous lap, the dispatcher has not read it yet
+            return NULL;
+        } else {
+            tail = __atomic_load_n(&queue_tail, __ATOMIC_RELAXED);
+        }
+    }
+
+    pending = tail + 1 - __atomic_load_n(&queue_head, __ATOMIC_RELAXED);
+    maximum = __atomic_load_n(&statistics.pending, __ATOMIC_RELAXED);
+    while ((pending > maximum) && !__atomic_compare_exchange_n(&statistics.pending, &maximum, pending, true,
+                                                               __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+
+    *position = tail;
+    return &queue[tail % HAL_EVENT_QUEUE_SIZE];
+}
+
+static void QueuePublish(event_record_t record, uint32_t position) {
+    __atomic_store_n(&record->turn, position + 1 - position % HAL_EVENT_QUEUE_SIZE, __ATOMIC_RELEASE);
+    __atomic_fetch_add(&statistics.posted, 1, __ATOMIC_RELAXED);
+
+#ifdef NOTIFY_TASK
+    if (dispatcher) {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(dispatcher, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+#endif
+}
+
+#ifdef FREERTOS
+// Woken by the interrupts that store an event, or once per tick when they can not notify the task
+static void DispatchTask(void * object) {
+    (void)object;
+
+    while (true) {
+#ifdef NOTIFY_TASK
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+#else
+        ulTaskNotifyTake(pdTRUE, 1);
+#endif
+        while (HalEventDispatch(HAL_EVENT_QUEUE_SIZE)) {
+        }
+    }
+}
+#endif
+
+/* === Public function implementation ========================================================== */
+
+bool HalEventPostGpio(hal_gpio_event_t handler, hal_gpio_bit_t gpio, bool rising, void * object) {
+    uint32_t position;
+    event_record_t record = QueueReserve(&position);
+
+    if (record == NULL) {
+        __atomic_fetch_add(&statistics.overflows, 1, __ATOMIC_RELAXED);
+        return false;
+    }
+    record->source = EVENT_GPIO;
+    record->object = object;
+    record->gpio.handler = handler;
+    record->gpio.gpio = gpio;
+    record->gpio.rising = rising;
+    QueuePublish(record, position);
+    return true;
+}
+
+bool HalEventPostSci(hal_sci_event_t handler, hal_sci_t sci, sci_status_t status, void * object,
+                     hal_event_resume_t resume) {
+    uint32_t position;
+    event_record_t record = QueueReserve(&position);
+
+    if (record == NULL) {
+        __atomic_fetch_add(&statistics.overflows, 1, __ATOMIC_RELAXED);
+        return false;
+    }
+    record->source = EVENT_SCI;
+    record->object = object;
+    record->sci.handler = handler;
+    record->sci.sci = sci;
+    record->sci.resume = resume;
+    record->sci.status = *status;
+    QueuePublish(record, position);
+    return true;
+}
+
+// The record is copied before the slot is released, so the handler can take as long as it needs
+uint16_t HalEventDispatch(uint16_t limit) {
+    uint16_t count = 0;
+
+    while (count < limit) {
+        uint32_t head = queue_head;
+        uint32_t index = head % HAL_EVENT_QUEUE_SIZE;
+        event_record_t slot = &queue[index];
+        struct event_record_s record;
+
+        if (__atomic_load_n(&slot->turn, __ATOMIC_ACQUIRE) + index != head + 1) {
+            break;
+        }
+        record = *slot;
+        __atomic_store_n(&slot->turn, head + HAL_EVENT_QUEUE_SIZE - index, __ATOMIC_RELEASE);
+        __atomic_store_n(&queue_head, head + 1, __ATOMIC_RELAXED);
+
+        if (record.source == EVENT_GPIO) {
+            record.gpio.handler(record.gpio.gpio, record.gpio.rising, record.object);
+        } else {
+            record.sci.handler(record.sci.sci, &record.sci.status, record.object);
+            if (record.sci.resume) {
+                record.sci.resume(record.sci.sci);
+            }
+        }
+        __atomic_fetch_add(&statistics.dispatched, 1, __ATOMIC_RELAXED);
+        count++;
+    }
+    return count;
+}
+
+void HalEventGetStatistics(hal_event_statistics_t result) {
+    result->posted = __atomic_load_n(&statistics.posted, __ATOMIC_RELAXED);
+    result->dispatched = __atomic_load_n(&statistics.dispatched, __ATOMIC_RELAXED);
+    result->overflows = __atomic_load_n(&statistics.overflows, __ATOMIC_RELAXED);
+    result->pending = __atomic_load_n(&statistics.pending, __ATOMIC_RELAXED);
+}
+
+#ifdef FREERTOS
+bool HalEventStartTask(uint8_t priority) {
+#if configSUPPORT_STATIC_ALLOCATION
+    static StaticTask_t task;
+    static StackType_t stack[HAL_EVENT_TASK_STACK];
+
+    dispatcher = xTaskCreateStatic(DispatchTask, "HalEvent", HAL_EVENT_TASK_STACK, NULL, priority, stack, &task);
+#else
+    if (xTaskCreate(DispatchTask, "HalEvent", HAL_EVENT_TASK_STACK, NULL, priority, &dispatcher) != pdPASS) {
+        dispatcher = NULL;
+    }
+#endif
+    return (dispatcher != NULL);
+}
+#endif
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
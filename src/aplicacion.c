@@ -0,0 +1,901 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Logica del reloj despertador
+ **
+ ** \addtogroup aplicacion Aplicacion
+ ** \brief Logica del reloj despertador
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "aplicacion.h"
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+//! Periodo de lectura de las teclas en milisegundos, tambien filtra los rebotes
+#define ESCANEO_TECLAS 10
+
+//! Tiempo sin actividad en milisegundos tras el cual se abandona un ajuste
+#define TIEMPO_INACTIVIDAD 30000
+
+//! Tiempo en milisegundos que hay que mantener una tecla para entrar en un ajuste
+#define TIEMPO_PULSACION 3000
+
+//! Minutos que se pospone la alarma
+#define MINUTOS_POSPONER 5
+
+//! Capacidad del buffer de recepcion de la referencia, debe ser una potencia de dos menor que 256
+#define RECEPCION 64
+
+/* === Private data type declarations ========================================================== */
+
+typedef enum {
+    SIN_CONFIGURAR,
+    MOSTRANDO_HORA,
+    AJUSTANDO_MINUTOS_ACTUAL,
+    AJUSTANDO_HORAS_ACTUAL,
+    AJUSTANDO_MINUTOS_ALARMA,
+    AJUSTANDO_HORAS_ALARMA,
+    MODOS,
+} modo_t;
+
+//! Sucesos que hacen avanzar la maquina de estados, los primeros coinciden con las teclas
+typedef enum {
+    SUCESO_SET_TIME = TECLA_SET_TIME,
+    SUCESO_SET_ALARM = TECLA_SET_ALARM,
+    SUCESO_DECREMENT = TECLA_DECREMENT,
+    SUCESO_INCREMENT = TECLA_INCREMENT,
+    SUCESO_ACCEPT = TECLA_ACCEPT,
+    SUCESO_CANCEL = TECLA_CANCEL,
+    SUCESO_PULSACION_HORA = TECLAS,
+    SUCESO_PULSACION_ALARMA,
+    SUCESO_INACTIVIDAD,
+    SUCESO_REFERENCIA,
+    SUCESOS,
+} suceso_t;
+
+//! Accion de una transicion, el resultado elige el modo siguiente
+typedef bool (*accion_t)(void);
+
+//! Acciones de entrada, salida y dibujo de un modo
+typedef void (*funcion_modo_t)(void);
+
+typedef struct transicion_s {
+    accion_t accion;
+    modo_t exito;
+    modo_t fallo;
+} transicion_t;
+
+typedef struct estado_s {
+    funcion_modo_t entrada;
+    funcion_modo_t salida;
+    funcion_modo_t dibujar;
+} estado_t;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static void Notificar(evento_tipo_t tipo, uint8_t dato);
+static void TeclaPresionada(tecla_t tecla);
+static void TeclaLiberada(tecla_t tecla);
+static void Resincronizar(void);
+static void ReferenciaRecibida(hal_sci_t sci, sci_status_t estado, void * objeto);
+static uint16_t LeerReferencia(char * datos, uint16_t tamano);
+static bool BuscarConsulta(const char * datos, uint16_t cantidad);
+static void Acotar(uint32_t * limite, uint32_t valor, despertar_t causa);
+static bool Vencido(uint32_t limite, uint32_t duracion);
+static void IncrementarBCD(uint8_t numero[2], const uint8_t limite[2]);
+static void DecrementarBCD(uint8_t numero[2], const uint8_t limite[2]);
+
+static void EntrarSinConfigurar(void);
+static void EntrarMostrandoHora(void);
+static void EntrarAjusteMinutos(void);
+static void EntrarAjusteHoras(void);
+static void SalirAjuste(void);
+static void DibujarHora(void);
+static void DibujarEntrada(void);
+static void DibujarEntradaAlarma(void);
+
+static bool ArmarHora(void);
+static bool ArmarAlarma(void);
+static bool CargarHora(void);
+static bool CargarAlarma(void);
+static bool LeerHora(void);
+static bool GuardarHora(void);
+static bool GuardarAlarma(void);
+static bool ActivarAlarma(void);
+static bool CancelarAlarma(void);
+static bool IncrementarMinutos(void);
+static bool DecrementarMinutos(void);
+static bool IncrementarHoras(void);
+static bool DecrementarHoras(void);
+
+static void CambiarModo(modo_t valor);
+static void Despachar(suceso_t suceso);
+
+/* === Tabla de transiciones =================================================================== */
+
+//! Destino que indica que la transicion no cambia el modo
+#define MISMO MODOS
+
+//! Transiciones posibles como ternas de accion, modo si la accion tiene exito y modo si falla
+#define IGNORAR                    (NULL, MISMO, MISMO)
+#define HACER(accion)              (accion, MISMO, MISMO)
+#define IR(accion, destino)        (accion, destino, destino)
+#define ELEGIR(accion, exito, fallo) (accion, exito, fallo)
+
+/**
+ * Cada fila tiene una columna por suceso en el orden de suceso_t: set_time, set_alarm, decrement,
+ * increment, accept, cancel, pulsacion_hora, pulsacion_alarma, inactividad y referencia. Una fila
+ * con columnas de mas o de menos no compila, y las verificaciones de abajo rechazan filas repetidas,
+ * faltantes o modos a los que no se puede llegar desde SIN_CONFIGURAR.
+ */
+// clang-format off
+#define TRANSICIONES(FILA, previo)                                                                 \
+    FILA(previo, SIN_CONFIGURAR,                                                                   \
+         HACER(ArmarHora),                                                                         \
+         HACER(ArmarAlarma),                                                                       \
+         IGNORAR,                                                                                  \
+         IGNORAR,                                                                                  \
+         IGNORAR,                                                                                  \
+         ELEGIR(LeerHora, MOSTRANDO_HORA, MISMO),                                                  \
+         IR(CargarHora, AJUSTANDO_MINUTOS_ACTUAL),                                                 \
+         IR(CargarAlarma, AJUSTANDO_MINUTOS_ALARMA),                                               \
+         IGNORAR,                                                                                  \
+         IR(NULL, MOSTRANDO_HORA))                                                                 \
+    FILA(previo, MOSTRANDO_HORA,                                                                   \
+         HACER(ArmarHora),                                                                         \
+         HACER(ArmarAlarma),                                                                       \
+         IGNORAR,                                                                                  \
+         IGNORAR,                                                                                  \
+         HACER(ActivarAlarma),                                                                     \
+         ELEGIR(CancelarAlarma, MISMO, SIN_CONFIGURAR),                                            \
+         IR(CargarHora, AJUSTANDO_MINUTOS_ACTUAL),                                                 \
+         IR(CargarAlarma, AJUSTANDO_MINUTOS_ALARMA),                                               \
+         IGNORAR,                                                                                  \
+         IGNORAR)                                                                                  \
+    FILA(previo, AJUSTANDO_MINUTOS_ACTUAL,                                                         \
+         IGNORAR,                                                                                  \
+         IGNORAR,                                                                                  \
+         HACER(DecrementarMinutos),                                                                \
+         HACER(IncrementarMinutos),                                                                \
+         IR(NULL, AJUSTANDO_HORAS_ACTUAL),                                                         \
+         ELEGIR(LeerHora, MOSTRANDO_HORA, SIN_CONFIGURAR),                                         \
+         IGNORAR,                                                                                  \
+         IGNORAR,                                                                                  \
+         ELEGIR(LeerHora, MOSTRANDO_HORA, SIN_CONFIGURAR),                                         \
+         IGNORAR)                                                                                  \
+    FILA(previo, AJUSTANDO_HORAS_ACTUAL,                                                           \
+         IGNORAR,                                                                                  \
+         IGNORAR,                                                                                  \
+         HACER(DecrementarHoras),                                                                  \
+         HACER(IncrementarHoras),                                                                  \
+         IR(GuardarHora, MOSTRANDO_HORA),                                                          \
+         ELEGIR(LeerHora, MOSTRANDO_HORA, SIN_CONFIGURAR),                                         \
+         IGNORAR,                                                                                  \
+         IGNORAR,                                                                                  \
+         ELEGIR(LeerHora, MOSTRANDO_HORA, SIN_CONFIGURAR),                                         \
+         IGNORAR)                                                                                  \
+    FILA(previo, AJUSTANDO_MINUTOS_ALARMA,                                                         \
+         IGNORAR,                                                                                  \
+         IGNORAR,                                                                                  \
+         HACER(DecrementarMinutos),                                                                \
+         HACER(IncrementarMinutos),                                                                \
+         IR(NULL, AJUSTANDO_HORAS_ALARMA),                                                         \
+         ELEGIR(LeerHora, MOSTRANDO_HORA, SIN_CONFIGURAR),                                         \
+         IGNORAR,                                                                                  \
+         IGNORAR,                                                                                  \
+         ELEGIR(LeerHora, MOSTRANDO_HORA, SIN_CONFIGURAR),                                         \
+         IGNORAR)                                                                                  \
+    FILA(previo, AJUSTANDO_HORAS_ALARMA,                                                           \
+         IGNORAR,                                                                                  \
+         IGNORAR,                                                                                  \
+         HACER(DecrementarHoras),                                                                  \
+         HACER(IncrementarHoras),                                                                  \
+         ELEGIR(GuardarAlarma, MOSTRANDO_HORA, SIN_CONFIGURAR),                                    \
+         ELEGIR(LeerHora, MOSTRANDO_HORA, SIN_CONFIGURAR),                                         \
+         IGNORAR,                                                                                  \
+         IGNORAR,                                                                                  \
+         ELEGIR(LeerHora, MOSTRANDO_HORA, SIN_CONFIGURAR),                                         \
+         IGNORAR)
+// clang-format on
+
+#define DESEMPAQUETAR(...)     __VA_ARGS__
+#define APLICAR(macro, ...)    macro(__VA_ARGS__)
+
+// Genera la fila de la tabla constante indexada por modo y suceso
+#define TRANSICION(accion, exito, fallo) {accion, exito, fallo}
+#define FILA_TABLA(previo, modo, set_time, set_alarm, decrement, increment, accept, cancel, hora, alarma,      \
+                   inactividad, referencia)                                                                    \
+    [modo] = {                                                                                                 \
+        [SUCESO_SET_TIME] = TRANSICION set_time,                                                               \
+        [SUCESO_SET_ALARM] = TRANSICION set_alarm,                                                             \
+        [SUCESO_DECREMENT] = TRANSICION decrement,                                                             \
+        [SUCESO_INCREMENT] = TRANSICION increment,                                                             \
+        [SUCESO_ACCEPT] = TRANSICION accept,                                                                   \
+        [SUCESO_CANCEL] = TRANSICION cancel,                                                                   \
+        [SUCESO_PULSACION_HORA] = TRANSICION hora,                                                             \
+        [SUCESO_PULSACION_ALARMA] = TRANSICION alarma,                                                         \
+        [SUCESO_INACTIVIDAD] = TRANSICION inactividad,                                                         \
+        [SUCESO_REFERENCIA] = TRANSICION referencia,                                                           \
+    },
+
+// Declara una constante por fila, una fila repetida es una constante redeclarada
+#define FILA_CONTAR(previo, modo, ...) FILA_##modo,
+
+// Agrega los destinos de una fila si su modo esta entre los alcanzados en el paso previo
+#define ALCANZA(previo, modo, accion, exito, fallo)                                                \
+    | ((((previo) >> (modo)) & 1u) ? ((1u << (exito)) | (1u << (fallo))) : 0u)
+#define COLUMNA_ALCANZA(previo, modo, columna) APLICAR(ALCANZA, previo, modo, DESEMPAQUETAR columna)
+#define FILA_ALCANZA(previo, modo, set_time, set_alarm, decrement, increment, accept, cancel, hora, alarma,    \
+                     inactividad, referencia)                                                                  \
+    COLUMNA_ALCANZA(previo, modo, set_time) COLUMNA_ALCANZA(previo, modo, set_alarm)                          \
+    COLUMNA_ALCANZA(previo, modo, decrement) COLUMNA_ALCANZA(previo, modo, increment)                         \
+    COLUMNA_ALCANZA(previo, modo, accept) COLUMNA_ALCANZA(previo, modo, cancel)                               \
+    COLUMNA_ALCANZA(previo, modo, hora) COLUMNA_ALCANZA(previo, modo, alarma)                                 \
+    COLUMNA_ALCANZA(previo, modo, inactividad) COLUMNA_ALCANZA(previo, modo, referencia)
+
+//! Mascara con todos los modos
+#define TODOS_LOS_MODOS ((1u << MODOS) - 1u)
+
+enum {
+    TRANSICIONES(FILA_CONTAR, 0) FILAS,
+};
+
+// Cada paso agrega los modos a los que se llega con una transicion mas, alcanza un paso por modo
+enum {
+    ALCANZADOS_0 = 1u << SIN_CONFIGURAR,
+    ALCANZADOS_1 = ALCANZADOS_0 TRANSICIONES(FILA_ALCANZA, ALCANZADOS_0),
+    ALCANZADOS_2 = ALCANZADOS_1 TRANSICIONES(FILA_ALCANZA, ALCANZADOS_1),
+    ALCANZADOS_3 = ALCANZADOS_2 TRANSICIONES(FILA_ALCANZA, ALCANZADOS_2),
+    ALCANZADOS_4 = ALCANZADOS_3 TRANSICIONES(FILA_ALCANZA, ALCANZADOS_3),
+    ALCANZADOS_5 = ALCANZADOS_4 TRANSICIONES(FILA_ALCANZA, ALCANZADOS_4),
+    ALCANZADOS_6 = ALCANZADOS_5 TRANSICIONES(FILA_ALCANZA, ALCANZADOS_5),
+    ALCANZADOS_7 = ALCANZADOS_6 TRANSICIONES(FILA_ALCANZA, ALCANZADOS_6),
+};
+
+static_assert(SUCESOS == 10, "Las filas de la tabla deben tener una columna por cada suceso");
+static_assert((int)FILAS == (int)MODOS, "La tabla de transiciones debe tener una fila por cada modo");
+static_assert(MODOS <= 8, "Agregar pasos de alcance para verificar mas de ocho modos");
+static_assert(TECLAS <= 8, "La grabacion guarda el estado de las teclas en un byte");
+static_assert((ALCANZADOS_7 & TODOS_LOS_MODOS) == TODOS_LOS_MODOS, "Hay modos a los que no se puede llegar");
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static const uint8_t LIMITE_MINUTOS[] = {5, 9};
+static const uint8_t LIMITE_HORAS[] = {2, 3};
+
+//! Tabla de transiciones, se indexa por modo y suceso
+static const transicion_t TABLA[MODOS][SUCESOS] = {TRANSICIONES(FILA_TABLA, 0)};
+
+//! Acciones de entrada y salida de cada modo y forma de mostrarlo
+static const estado_t ESTADOS[MODOS] = {
+    [SIN_CONFIGURAR] = {.entrada = EntrarSinConfigurar, .salida = NULL, .dibujar = DibujarHora},
+    [MOSTRANDO_HORA] = {.entrada = EntrarMostrandoHora, .salida = NULL, .dibujar = DibujarHora},
+    [AJUSTANDO_MINUTOS_ACTUAL] = {.entrada = EntrarAjusteMinutos, .salida = SalirAjuste, .dibujar = DibujarEntrada},
+    [AJUSTANDO_HORAS_ACTUAL] = {.entrada = EntrarAjusteHoras, .salida = SalirAjuste, .dibujar = DibujarEntrada},
+    [AJUSTANDO_MINUTOS_ALARMA] = {.entrada = EntrarAjusteMinutos,
+                                  .salida = SalirAjuste,
+                                  .dibujar = DibujarEntradaAlarma},
+    [AJUSTANDO_HORAS_ALARMA] = {.entrada = EntrarAjusteHoras, .salida = SalirAjuste, .dibujar = DibujarEntradaAlarma},
+};
+
+static board_t board;
+static clock_t reloj;
+static disciplina_t disciplina;
+static aplicacion_plataforma_t plataforma;
+static digital_input_t teclas[TECLAS];
+
+//! Estado que pertenece a la tarea de la aplicacion
+static modo_t modo;
+static uint32_t tiempo;
+static bool primera_mitad = false;
+static uint8_t entrada[4];
+
+//! Tecla que se esta manteniendo para entrar en un ajuste y momento en que se cumple la pulsacion larga
+static tecla_t tecla_pulsada = TECLAS;
+static uint32_t fin_pulsacion;
+
+//! Bandera que indica si se espera inactividad y momento en que se abandona el ajuste
+static bool esperando_inactividad = false;
+static uint32_t fin_inactividad;
+
+//! Teclas presionadas segun los eventos que proceso la tarea, una por bit, y perdidas que ya se resincronizaron
+static uint8_t teclas_vistas = 0;
+static uint32_t perdidos_atendidos = 0;
+
+//! Estado compartido con el tic, la tarea solo lo usa dentro de una seccion bloqueada
+static bool sonar_alarma = false;
+
+//! Estado de las teclas segun los cambios detectados, una por bit, y mitad del segundo en curso
+static uint8_t entradas = 0;
+static bool mitad_actual = false;
+
+//! Cantidad de eventos que la plataforma no pudo entregar a la tarea
+static uint32_t eventos_perdidos = 0;
+
+//! Estado que pertenece al tic
+static uint8_t escaneo = 0;
+
+//! Datos de la referencia que la interrupcion del puerto serie saca de la fifo para que no se pierdan en reposo
+static char recepcion[RECEPCION];
+static volatile uint8_t recepcion_escritura = 0;
+static volatile uint8_t recepcion_lectura = 0;
+
+//! Caracteres del pedido de informe de la consola reconocidos en la linea que se esta recibiendo
+static uint8_t consulta = 0;
+
+//! Contadores de reposo y motivo por el que se espera despertar del reposo en curso
+static struct reposo_s reposo = {0};
+static uint32_t tics_previstos;
+static despertar_t causa_prevista;
+
+/* === Private function implementation ========================================================= */
+
+static void Notificar(evento_tipo_t tipo, uint8_t dato) {
+    struct evento_s evento = {.tipo = tipo, .dato = dato};
+
+    if (!plataforma->Notificar(&evento)) {
+        eventos_perdidos++;
+    }
+}
+
+// Un evento de una tecla que ya estaba presionada proviene de un cambio que se atendio al resincronizar
+static void TeclaPresionada(tecla_t tecla) {
+    if (teclas_vistas & (1 << tecla)) {
+        return;
+    }
+    teclas_vistas |= (1 << tecla);
+
+    if (esperando_inactividad) {
+        fin_inactividad = tiempo + TIEMPO_INACTIVIDAD;
+        plataforma->Temporizar(ESPERA_INACTIVIDAD, TIEMPO_INACTIVIDAD);
+    }
+    Despachar((suceso_t)tecla);
+}
+
+static void TeclaLiberada(tecla_t tecla) {
+    if (!(teclas_vistas & (1 << tecla))) {
+        return;
+    }
+    teclas_vistas &= ~(1 << tecla);
+
+    if (tecla == tecla_pulsada) {
+        tecla_pulsada = TECLAS;
+        plataforma->Detener(ESPERA_PULSACION);
+    }
+}
+
+// Despues de perder eventos toma los niveles que mantiene el tic y genera los cambios de teclas que no llegaron, una
+// referencia perdida ya puso en hora el reloj y su suceso solo cambia el modo si todavia no se mostraba la hora
+static void Resincronizar(void) {
+    uint8_t presionadas;
+    uint8_t hora[6];
+    bool valida;
+
+    plataforma->Bloquear();
+    presionadas = entradas;
+    primera_mitad = mitad_actual;
+    valida = (disciplina != NULL) && ClockGetTime(reloj, hora, sizeof(hora));
+    plataforma->Liberar();
+
+    for (tecla_t tecla = 0; tecla < TECLAS; tecla++) {
+        if (!(presionadas & (1 << tecla))) {
+            TeclaLiberada(tecla);
+        }
+    }
+    for (tecla_t tecla = 0; tecla < TECLAS; tecla++) {
+        if (presionadas & (1 << tecla)) {
+            TeclaPresionada(tecla);
+        }
+    }
+    if (valida) {
+        Despachar(SUCESO_REFERENCIA);
+    }
+}
+
+// Vacia la fifo del puerto serie, la interrupcion tambien despierta al procesador si esta en reposo
+static void ReferenciaRecibida(hal_sci_t sci, sci_status_t estado, void * objeto) {
+    char datos[16];
+    uint16_t cantidad;
+
+    do {
+        cantidad = SciReceiveData(sci, datos, sizeof(datos));
+        for (uint16_t indice = 0; indice < cantidad; indice++) {
+            if ((uint8_t)(recepcion_escritura - recepcion_lectura) < RECEPCION) {
+                recepcion[recepcion_escritura % RECEPCION] = datos[indice];
+                recepcion_escritura++;
+            }
+        }
+    } while (cantidad == sizeof(datos));
+}
+
+static uint16_t LeerReferencia(char * datos, uint16_t tamano) {
+    uint16_t cantidad = 0;
+
+    while ((cantidad < tamano) && (recepcion_lectura != recepcion_escritura)) {
+        datos[cantidad] = recepcion[recepcion_lectura % RECEPCION];
+        recepcion_lectura++;
+        cantidad++;
+    }
+    return cantidad;
+}
+
+// Reconoce las lineas `$C` entre los mensajes de la referencia, sin guardar la linea completa
+static bool BuscarConsulta(const char * datos, uint16_t cantidad) {
+    static const char PEDIDO[] = "$C";
+    bool encontrada = false;
+
+    for (uint16_t indice = 0; indice < cantidad; indice++) {
+        if ((datos[indice] == '\n') || (datos[indice] == '\r')) {
+            encontrada = encontrada || (consulta == sizeof(PEDIDO) - 1);
+            consulta = 0;
+        } else if ((consulta < sizeof(PEDIDO) - 1) && (datos[indice] == PEDIDO[consulta])) {
+            consulta++;
+        } else {
+            consulta = sizeof(PEDIDO);
+        }
+    }
+    return encontrada;
+}
+
+// Reduce el limite de reposo al valor indicado y registra la causa si es el mas cercano
+static void Acotar(uint32_t * limite, uint32_t valor, despertar_t causa) {
+    if (valor < *limite) {
+        *limite = valor;
+        causa_prevista = causa;
+    }
+}
+
+// Indica si se alcanzo un limite fijado como maximo a la duracion indicada del tiempo actual
+static bool Vencido(uint32_t limite, uint32_t duracion) {
+    return (uint32_t)(tiempo - limite) <= duracion;
+}
+
+static void IncrementarBCD(uint8_t numero[2], const uint8_t limite[2]) {
+    if (numero[0] == limite[0] && numero[1] == limite[1]) {
+        numero[0] = 0;
+        numero[1] = 0;
+    } else {
+        numero[1]++;
+        if (numero[1] > 9) {
+            numero[1] = 0;
+            numero[0]++;
+            if (numero[0] > limite[0]) {
+                numero[0] = 0;
+            }
+        }
+    }
+}
+
+static void DecrementarBCD(uint8_t numero[2], const uint8_t limite[2]) {
+    if (numero[0] == 0 && numero[1] == 0) {
+        numero[0] = limite[0];
+        numero[1] = limite[1];
+    } else {
+        if (numero[1] == 0) {
+            numero[1] = 9;
+            if (numero[0] == 0) {
+                numero[0] = limite[0];
+            } else {
+                numero[0]--;
+            }
+        } else {
+            numero[1]--;
+        }
+    }
+}
+
+// Las acciones de entrada, salida y dibujo se ejecutan dentro de una seccion bloqueada
+
+static void EntrarSinConfigurar(void) {
+    DisplayFlashDigits(board->display, 0, 3, 200);
+}
+
+static void EntrarMostrandoHora(void) {
+    DisplayFlashDigits(board->display, 0, 0, 0);
+}
+
+static void EntrarAjusteMinutos(void) {
+    DisplayFlashDigits(board->display, 2, 3, 200);
+    esperando_inactividad = true;
+}
+
+static void EntrarAjusteHoras(void) {
+    DisplayFlashDigits(board->display, 0, 1, 200);
+    esperando_inactividad = true;
+}
+
+static void SalirAjuste(void) {
+    esperando_inactividad = false;
+}
+
+static void DibujarHora(void) {
+    uint8_t hora[6];
+
+    ClockGetTime(reloj, hora, sizeof(hora));
+    DisplayWriteBCD(board->display, hora, sizeof(hora));
+    if (primera_mitad) {
+        DisplayToggleDot(board->display, 1);
+    }
+    if (AlarmGetState(reloj)) {
+        DisplayToggleDot(board->display, 3);
+    }
+}
+
+static void DibujarEntrada(void) {
+    DisplayWriteBCD(board->display, entrada, sizeof(entrada));
+}
+
+static void DibujarEntradaAlarma(void) {
+    DibujarEntrada();
+    for (uint8_t punto = 0; punto < sizeof(entrada); punto++) {
+        DisplayToggleDot(board->display, punto);
+    }
+}
+
+// Las acciones de las transiciones se ejecutan en la tarea y bloquean solo para usar el reloj
+
+static bool ArmarHora(void) {
+    tecla_pulsada = TECLA_SET_TIME;
+    fin_pulsacion = tiempo + TIEMPO_PULSACION;
+    plataforma->Temporizar(ESPERA_PULSACION, TIEMPO_PULSACION);
+    return true;
+}
+
+static bool ArmarAlarma(void) {
+    tecla_pulsada = TECLA_SET_ALARM;
+    fin_pulsacion = tiempo + TIEMPO_PULSACION;
+    plataforma->Temporizar(ESPERA_PULSACION, TIEMPO_PULSACION);
+    return true;
+}
+
+static bool CargarHora(void) {
+    plataforma->Bloquear();
+    ClockGetTime(reloj, entrada, sizeof(entrada));
+    plataforma->Liberar();
+    return true;
+}
+
+static bool CargarAlarma(void) {
+    plataforma->Bloquear();
+    AlarmGetTime(reloj, entrada, sizeof(entrada));
+    plataforma->Liberar();
+    return true;
+}
+
+// Descarta lo ingresado, falla si el reloj todavia no tiene una hora valida
+static bool LeerHora(void) {
+    bool valida;
+
+    plataforma->Bloquear();
+    valida = ClockGetTime(reloj, entrada, sizeof(entrada));
+    plataforma->Liberar();
+    return valida;
+}
+
+static bool GuardarHora(void) {
+    plataforma->Bloquear();
+    ClockSetTime(reloj, entrada, sizeof(entrada));
+    plataforma->Liberar();
+    return true;
+}
+
+// Guarda la alarma y vuelve a la hora, falla si el reloj todavia no tiene una hora valida
+static bool GuardarAlarma(void) {
+    plataforma->Bloquear();
+    AlarmSetTime(reloj, entrada, sizeof(entrada));
+    plataforma->Liberar();
+    return LeerHora();
+}
+
+static bool ActivarAlarma(void) {
+    plataforma->Bloquear();
+    ActivateAlarm(reloj, true);
+    if (sonar_alarma) {
+        ExtendAlarm(reloj, MINUTOS_POSPONER);
+    }
+    plataforma->Liberar();
+    return true;
+}
+
+static bool CancelarAlarma(void) {
+    plataforma->Bloquear();
+    if (sonar_alarma) {
+        DisableAlarm(reloj);
+    } else {
+        ActivateAlarm(reloj, false);
+    }
+    plataforma->Liberar();
+    return LeerHora();
+}
+
+static bool IncrementarMinutos(void) {
+    IncrementarBCD(&entrada[2], LIMITE_MINUTOS);
+    return true;
+}
+
+static bool DecrementarMinutos(void) {
+    DecrementarBCD(&entrada[2], LIMITE_MINUTOS);
+    return true;
+}
+
+static bool IncrementarHoras(void) {
+    IncrementarBCD(entrada, LIMITE_HORAS);
+    return true;
+}
+
+static bool DecrementarHoras(void) {
+    DecrementarBCD(entrada, LIMITE_HORAS);
+    return true;
+}
+
+static void CambiarModo(modo_t valor) {
+    plataforma->Bloquear();
+    if (ESTADOS[modo].salida != NULL) {
+        ESTADOS[modo].salida();
+    }
+    modo = valor;
+    if (ESTADOS[modo].entrada != NULL) {
+        ESTADOS[modo].entrada();
+    }
+    plataforma->Liberar();
+
+    // Las esperas usan servicios del sistema operativo y se programan fuera de la seccion bloqueada
+    if (esperando_inactividad) {
+        fin_inactividad = tiempo + TIEMPO_INACTIVIDAD;
+        plataforma->Temporizar(ESPERA_INACTIVIDAD, TIEMPO_INACTIVIDAD);
+    } else {
+        plataforma->Detener(ESPERA_INACTIVIDAD);
+    }
+}
+
+static void Despachar(suceso_t suceso) {
+    const transicion_t * transicion = &TABLA[modo][suceso];
+    bool exito = true;
+    modo_t siguiente;
+
+    if (transicion->accion != NULL) {
+        exito = transicion->accion();
+    }
+    siguiente = exito ? transicion->exito : transicion->fallo;
+    if (siguiente != MISMO) {
+        CambiarModo(siguiente);
+    }
+}
+
+/* === Public function implementation ========================================================== */
+
+void ApplicationCreate(board_t placa, clock_t reloj_aplicacion, disciplina_t disciplina_aplicacion,
+                       aplicacion_plataforma_t servicios) {
+    board = placa;
+    reloj = reloj_aplicacion;
+    disciplina = disciplina_aplicacion;
+    plataforma = servicios;
+
+    teclas[TECLA_SET_TIME] = board->set_time;
+    teclas[TECLA_SET_ALARM] = board->set_alarm;
+    teclas[TECLA_DECREMENT] = board->decrement;
+    teclas[TECLA_INCREMENT] = board->increment;
+    teclas[TECLA_ACCEPT] = board->accept;
+    teclas[TECLA_CANCEL] = board->cancel;
+
+    tiempo = 0;
+    tecla_pulsada = TECLAS;
+    esperando_inactividad = false;
+
+    if ((disciplina != NULL) && (board->referencia != NULL)) {
+        SciSetEventHandler(board->referencia, ReferenciaRecibida, NULL);
+    }
+
+    plataforma->Bloquear();
+    modo = SIN_CONFIGURAR;
+    ESTADOS[modo].entrada();
+    ESTADOS[modo].dibujar();
+    plataforma->Liberar();
+}
+
+void ApplicationTick(void) {
+    static bool alarma_anterior = false;
+    bool mitad;
+    bool presionada;
+    char datos[16];
+    uint16_t cantidad;
+    uint8_t pantalla[TRACE_MAX_DIGITS];
+
+    if (board->traza != NULL) {
+        TraceTick(board->traza, 1);
+    }
+
+    mitad = ClockUpdate(reloj);
+    if (mitad != mitad_actual) {
+        mitad_actual = mitad;
+        Notificar(EVENTO_MEDIO_SEGUNDO, mitad);
+    }
+    if (sonar_alarma != alarma_anterior) {
+        alarma_anterior = sonar_alarma;
+        Notificar(EVENTO_ALARMA, alarma_anterior);
+    }
+
+    DisplayRefresh(board->display);
+    if (board->traza != NULL) {
+        DisplayGetFrame(board->display, pantalla);
+        TraceFrame(board->traza, pantalla);
+    }
+
+    escaneo++;
+    if (escaneo >= ESCANEO_TECLAS) {
+        escaneo = 0;
+        for (tecla_t tecla = 0; tecla < TECLAS; tecla++) {
+            if (DigitalInputHasChanged(teclas[tecla])) {
+                presionada = DigitalInputGetState(teclas[tecla]);
+                Notificar(presionada ? EVENTO_TECLA_PRESIONADA : EVENTO_TECLA_LIBERADA, tecla);
+                entradas = presionada ? (entradas | (1 << tecla)) : (entradas & ~(1 << tecla));
+            }
+        }
+        // Se graba lo que vio la aplicacion y no una nueva lectura, que podria haber cambiado
+        if (board->traza != NULL) {
+            TraceInputs(board->traza, entradas);
+        }
+    }
+
+    // Los mensajes de la referencia se fechan a lo sumo un tic despues de llegar
+    if ((disciplina != NULL) && (board->referencia != NULL)) {
+        cantidad = LeerReferencia(datos, sizeof(datos));
+        if ((cantidad > 0) && DisciplineReceive(disciplina, datos, cantidad)) {
+            Notificar(EVENTO_REFERENCIA, 0);
+        }
+        if ((cantidad > 0) && BuscarConsulta(datos, cantidad)) {
+            Notificar(EVENTO_CONSULTA, 0);
+        }
+    }
+}
+
+uint32_t ApplicationSleepLimit(uint32_t esperados) {
+    uint32_t limite = esperados;
+
+    causa_prevista = DESPERTAR_TAREA;
+    Acotar(&limite, (uint32_t)DisplayDarkTime(board->display) + 1, DESPERTAR_PANTALLA);
+    Acotar(&limite, ESCANEO_TECLAS - escaneo, DESPERTAR_TECLAS);
+    Acotar(&limite, ClockTicsToHalfSecond(reloj), DESPERTAR_RELOJ);
+    if (limite == 0) {
+        limite = 1;
+    }
+
+    tics_previstos = limite;
+    return limite;
+}
+
+void ApplicationResume(uint32_t tics) {
+    reposo.despertares++;
+    reposo.tics_dormido += tics;
+    reposo.causas[(tics < tics_previstos) ? DESPERTAR_INTERRUPCION : causa_prevista]++;
+    if (tics == 0) {
+        return;
+    }
+
+    // Los tics omitidos solo avanzan el tiempo, el ultimo se atiende completo para despachar lo que vence en el
+    if (tics > 1) {
+        reposo.tics_omitidos += tics - 1;
+        ClockAdvance(reloj, tics - 1);
+        DisplaySkip(board->display, tics - 1);
+        escaneo = (escaneo + tics - 1) % ESCANEO_TECLAS;
+        if (board->traza != NULL) {
+            TraceTick(board->traza, tics - 1);
+        }
+    }
+    ApplicationTick();
+}
+
+void ApplicationSleepStats(reposo_t estadisticas) {
+    plataforma->Bloquear();
+    memcpy(estadisticas, &reposo, sizeof(reposo));
+    plataforma->Liberar();
+}
+
+uint32_t ApplicationLostEvents(void) {
+    uint32_t perdidos;
+
+    plataforma->Bloquear();
+    perdidos = eventos_perdidos;
+    plataforma->Liberar();
+    return perdidos;
+}
+
+void ApplicationProcess(evento_t evento, uint32_t ahora) {
+    suceso_t suceso;
+    uint32_t perdidos;
+
+    tiempo = ahora;
+    switch (evento->tipo) {
+    case EVENTO_TECLA_PRESIONADA:
+        TeclaPresionada((tecla_t)evento->dato);
+        break;
+
+    case EVENTO_TECLA_LIBERADA:
+        TeclaLiberada((tecla_t)evento->dato);
+        break;
+
+    case EVENTO_MEDIO_SEGUNDO:
+        primera_mitad = evento->dato;
+        break;
+
+    case EVENTO_REFERENCIA:
+        Despachar(SUCESO_REFERENCIA);
+        break;
+
+    case EVENTO_TIEMPO_AGOTADO:
+        // Un vencimiento que quedo en la cola cuando la espera se cancelo o reinicio no cumple el limite
+        if ((evento->dato == ESPERA_PULSACION) && (tecla_pulsada != TECLAS) &&
+            Vencido(fin_pulsacion, TIEMPO_PULSACION)) {
+            suceso = (tecla_pulsada == TECLA_SET_TIME) ? SUCESO_PULSACION_HORA : SUCESO_PULSACION_ALARMA;
+            tecla_pulsada = TECLAS;
+            Despachar(suceso);
+        }
+        if ((evento->dato == ESPERA_INACTIVIDAD) && esperando_inactividad &&
+            Vencido(fin_inactividad, TIEMPO_INACTIVIDAD)) {
+            Despachar(SUCESO_INACTIVIDAD);
+        }
+        break;
+
+    case EVENTO_CONSULTA:
+        if (plataforma->Informar != NULL) {
+            plataforma->Informar();
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    // Una perdida ocurre con la cola llena, por lo que siempre queda un evento posterior que la atiende
+    perdidos = ApplicationLostEvents();
+    if (perdidos != perdidos_atendidos) {
+        perdidos_atendidos = perdidos;
+        Resincronizar();
+    }
+
+    // Cualquier evento puede modificar lo que se muestra, la pantalla se reescribe completa de una vez
+    plataforma->Bloquear();
+    ESTADOS[modo].dibujar();
+    plataforma->Liberar();
+}
+
+void ApplicationAlarm(bool estado) {
+    sonar_alarma = estado;
+
+    if (estado) {
+        DigitalOutputActivate(board->buzzer);
+    } else {
+        DigitalOutputDeactivate(board->buzzer);
+    }
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
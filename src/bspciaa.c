@@ -27,11 +27,15 @@ SPDX-License-Identifier: MIT
  ** \brief
  ** @{ */
 
+// La placa posix tiene su propia implementacion en bspposix.c
+#ifndef POSIX
+
 /* === Headers files inclusions =============================================================== */
 
 #include "bspciaa.h"
 #include "chip.h"
 #include "display.h"
+#include "hal.h"
 #include "poncho.h"
 
 /* === Macros definitions ====================================================================== */
@@ -48,6 +52,7 @@ void DigitsInit(void);
 void SegmentsInit(void);
 void BuzzerInit(void);
 void KeysInit(void);
+void ReferenceInit(void);
 void ScreenTurnOff(void);
 void SegmentsTurnOn(uint8_t segments);
 void DigitTurnOn(uint8_t digit);
@@ -164,6 +169,23 @@ void DigitTurnOn(uint8_t digit) {
     return;
 }
 
+void ReferenceInit(void) {
+    // Puerto USB de la placa, por el que un servidor envia la hora de referencia
+    static const struct hal_sci_line_s linea = {
+        .baud_rate = 115200,
+        .data_bits = 8,
+        .parity = HAL_SCI_NO_PARITY,
+    };
+    static const struct hal_sci_pins_s terminales = {
+        .txd_pin = HAL_PIN_P7_1,
+        .rxd_pin = HAL_PIN_P7_2,
+    };
+
+    if (SciSetConfig(HAL_SCI_USART2, &linea, &terminales)) {
+        board.referencia = HAL_SCI_USART2;
+    }
+}
+
 /* === Public function implementation ========================================================== */
 
 board_t BoardCreate(void) {
@@ -171,6 +193,7 @@ board_t BoardCreate(void) {
     SegmentsInit();
     BuzzerInit();
     KeysInit();
+    ReferenceInit();
 
     board.display = DisplayCreate(4, &(struct display_driver_s){
                                          .ScreenTurnOff = ScreenTurnOff,
@@ -194,6 +217,8 @@ void SisTick_Init(uint16_t ticks) {
 }
 /******************/
 
+#endif
+
 /* === End of documentation ==================================================================== */
 
 /** @} End of module definition for doxygen */
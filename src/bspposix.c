@@ -0,0 +1,325 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Board Hardware Support (BSP) para la placa posix
+ **
+ ** Emula la placa EDUCIAA-NXP con la capa de abstraccion posix para ejecutar la aplicacion en Linux. Las
+ ** teclas 1 a 6 del teclado alternan el estado de las entradas, la pantalla se dibuja en la terminal y la
+ ** hora de referencia llega por un pseudo terminal. Si la variable de entorno TRAZA tiene el nombre
+ ** de un archivo se graban en el las entradas y la pantalla para repetir la ejecucion en la PC.
+ **
+ ** La variable VELOCIDAD acelera la simulacion: con un numero el tic corre esa cantidad de veces mas
+ ** rapido y con `max` el tiempo avanza sin esperar cada vez que todas las tareas estan bloqueadas.
+ ** En ese caso se informa debajo de la pantalla el tiempo simulado y los segundos simulados por
+ ** segundo real.
+ **
+ ** Si la variable PUERTOS tiene el nombre de un archivo, por ejemplo en /dev/shm, los puertos emulados se
+ ** comparten en el con otros procesos que pueden operar las teclas y leer el zumbador y la pantalla, que
+ ** en ese caso tambien se escribe multiplexada en los puertos de segmentos y digitos como en la placa.
+ **
+ ** \addtogroup bsp BSP
+ ** \brief
+ ** @{ */
+
+// La placa EDUCIAA-NXP tiene su propia implementacion en bspciaa.c
+#ifdef POSIX
+
+/* === Headers files inclusions =============================================================== */
+
+#include "FreeRTOS.h"
+#include "bspciaa.h"
+#include "display.h"
+#include "hal.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* === Macros definitions ====================================================================== */
+
+//! Puerto emulado con las teclas, el teclado alterna sus bits con las teclas 1 a 8
+#define KEYS_GPIO 0
+
+#define KEY_F1_BIT     0
+#define KEY_F2_BIT     1
+#define KEY_F3_BIT     2
+#define KEY_F4_BIT     3
+#define KEY_ACCEPT_BIT 4
+#define KEY_CANCEL_BIT 5
+
+#define BUZZER_GPIO 3
+#define BUZZER_BIT  0
+
+//! Puertos emulados donde se escribe la pantalla cuando se comparten con otros procesos
+#define SEGMENTS_GPIO 1
+#define DIGITS_GPIO   2
+
+//! Cantidad de digitos de la pantalla
+#define DIGITS 4
+
+//! Fila y columna de la terminal donde se dibuja la pantalla, debajo del estado de los puertos emulados
+#define SCREEN_ROW    7
+#define SCREEN_COLUMN 3
+
+//! Columnas de la terminal que ocupa cada digito
+#define DIGIT_WIDTH 5
+
+//! Fila de la terminal donde se informa la velocidad de la simulacion
+#define SPEED_ROW (SCREEN_ROW + 5)
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+static struct board_s board = {0};
+
+//! Segmentos que se encienden con el proximo digito
+static uint8_t pending_segments;
+
+//! Segmentos dibujados en la terminal para cada digito
+static uint8_t screen[DIGITS];
+
+//! Archivo donde se graba la ejecucion
+static int trace_file = -1;
+
+//! Indica que los puertos emulados se comparten con otros procesos
+static bool shared_ports = false;
+
+/* === Private function declarations =========================================================== */
+
+void SharedInit(void);
+void BuzzerInit(void);
+void KeysInit(void);
+void ReferenceInit(void);
+void TraceInit(void);
+void SpeedInit(void);
+void ScreenInit(void);
+void ScreenTurnOff(void);
+void SegmentsTurnOn(uint8_t segments);
+void DigitTurnOn(uint8_t digit);
+static void DrawDigit(uint8_t digit, uint8_t segments);
+static void TraceWrite(void * object, const uint8_t * data, uint16_t size);
+static void * SpeedThread(void * _);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+// Debe ser lo primero, antes de configurar los terminales que quedan en el estado compartido
+void SharedInit(void) {
+    const char * name = getenv("PUERTOS");
+
+    if ((name == NULL) || (name[0] == '\0')) {
+        return;
+    }
+    shared_ports = GpioShareState(name);
+    if (!shared_ports) {
+        perror(name);
+    }
+}
+
+void BuzzerInit(void) {
+    board.buzzer = DigitalOutputCreate(BUZZER_GPIO, BUZZER_BIT, false);
+}
+
+// Como en la placa, las entradas quedan en alto y pasan a cero mientras la tecla esta pulsada
+void KeysInit(void) {
+    board.set_time = DigitalInputCreate(KEYS_GPIO, KEY_F1_BIT, false);
+    board.set_alarm = DigitalInputCreate(KEYS_GPIO, KEY_F2_BIT, false);
+    board.decrement = DigitalInputCreate(KEYS_GPIO, KEY_F3_BIT, false);
+    board.increment = DigitalInputCreate(KEYS_GPIO, KEY_F4_BIT, false);
+    board.accept = DigitalInputCreate(KEYS_GPIO, KEY_ACCEPT_BIT, false);
+    board.cancel = DigitalInputCreate(KEYS_GPIO, KEY_CANCEL_BIT, false);
+}
+
+void ReferenceInit(void) {
+    static const struct hal_sci_line_s linea = {
+        .baud_rate = 115200,
+        .data_bits = 8,
+        .parity = HAL_SCI_NO_PARITY,
+    };
+
+    if (SciSetConfig(HAL_SCI_PTY0, &linea, NULL)) {
+        board.referencia = HAL_SCI_PTY0;
+    }
+}
+
+void TraceInit(void) {
+    const char * name = getenv("TRAZA");
+
+    if ((name == NULL) || (name[0] == '\0')) {
+        return;
+    }
+    trace_file = open(name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (trace_file < 0) {
+        perror(name);
+        return;
+    }
+    board.traza = TraceCreate(DIGITS, TraceWrite, &trace_file);
+}
+
+void SpeedInit(void) {
+    const char * speed = getenv("VELOCIDAD");
+    unsigned long scale;
+    sigset_t signals, previous;
+    pthread_t thread;
+
+    if ((speed == NULL) || (speed[0] == '\0')) {
+        return;
+    }
+    scale = (strcmp(speed, "max") == 0) ? portTIME_SCALE_VIRTUAL : strtoul(speed, NULL, 10);
+    if (scale == portTIME_SCALE_REAL) {
+        return;
+    }
+    vPortSetTimeScale(scale);
+
+    // Como los hilos de la capa de abstraccion, el informe no atiende las interrupciones emuladas
+    sigfillset(&signals);
+    pthread_sigmask(SIG_SETMASK, &signals, &previous);
+    pthread_create(&thread, NULL, SpeedThread, NULL);
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+}
+
+void ScreenInit(void) {
+    static const char AYUDA[] = "Teclas: 1 hora, 2 alarma, 3 bajar, 4 subir, 5 aceptar, 6 cancelar";
+
+    printf("\033[%d;%dH%s\033[%d;1H", SCREEN_ROW + 4, SCREEN_COLUMN, AYUDA, SCREEN_ROW + 6);
+    fflush(stdout);
+    for (uint8_t digit = 0; digit < DIGITS; digit++) {
+        DrawDigit(digit, 0);
+    }
+}
+
+// Con los puertos compartidos la pantalla se escribe en los puertos emulados igual que en la placa
+void ScreenTurnOff(void) {
+    pending_segments = 0;
+    if (shared_ports) {
+        GpioPortClear(DIGITS_GPIO, (1 << DIGITS) - 1);
+        GpioPortClear(SEGMENTS_GPIO, 0xFF);
+    }
+}
+
+void SegmentsTurnOn(uint8_t segments) {
+    pending_segments = segments;
+    if (shared_ports) {
+        GpioPortSetState(SEGMENTS_GPIO, 0xFF, segments);
+    }
+}
+
+// Solo se dibujan los digitos que cambiaron, la pantalla se refresca en cada tic
+void DigitTurnOn(uint8_t digit) {
+    if (shared_ports && (digit < DIGITS)) {
+        GpioPortSet(DIGITS_GPIO, 1 << digit);
+    }
+    if ((digit < DIGITS) && (screen[digit] != pending_segments)) {
+        screen[digit] = pending_segments;
+        DrawDigit(digit, pending_segments);
+    }
+}
+
+// Se llama desde el tic, que en el puerto posix es una senal, por eso escribe sin pasar por stdio
+static void DrawDigit(uint8_t digit, uint8_t segments) {
+    char dibujo[64];
+    int columna = SCREEN_COLUMN + DIGIT_WIDTH * digit;
+    int largo;
+
+    largo = snprintf(dibujo, sizeof(dibujo), "\0337\033[%d;%dH %c \033[%d;%dH%c%c%c\033[%d;%dH%c%c%c%c\0338",
+                     SCREEN_ROW, columna, (segments & SEGMENT_A) ? '_' : ' ', SCREEN_ROW + 1, columna,
+                     (segments & SEGMENT_F) ? '|' : ' ', (segments & SEGMENT_G) ? '_' : ' ',
+                     (segments & SEGMENT_B) ? '|' : ' ', SCREEN_ROW + 2, columna, (segments & SEGMENT_E) ? '|' : ' ',
+                     (segments & SEGMENT_D) ? '_' : ' ', (segments & SEGMENT_C) ? '|' : ' ',
+                     (segments & SEGMENT_P) ? '.' : ' ');
+    if (largo > 0) {
+        (void)!write(STDOUT_FILENO, dibujo, largo);
+    }
+}
+
+// Se llama desde el tic, igual que el dibujo de la pantalla, y el archivo no se cierra porque la
+// aplicacion termina con una senal, asi que la grabacion queda sin el registro de fin
+static void TraceWrite(void * object, const uint8_t * data, uint16_t size) {
+    (void)!write(*(int *)object, data, size);
+}
+
+// Informa una vez por segundo real el tiempo simulado y cuantos segundos se simularon en ese segundo
+static void * SpeedThread(void * _) {
+    struct timespec before, now;
+    unsigned long long ticks, previous = 0;
+    unsigned long long seconds;
+    double elapsed;
+    char text[96];
+    int length;
+
+    clock_gettime(CLOCK_MONOTONIC, &before);
+    while (true) {
+        sleep(1);
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        ticks = ullPortGetElapsedTicks();
+        elapsed = (now.tv_sec - before.tv_sec) + (now.tv_nsec - before.tv_nsec) / 1e9;
+        seconds = ticks / configTICK_RATE_HZ;
+
+        length = snprintf(text, sizeof(text),
+                          "\0337\033[%d;%dHSimulado %llud %02llu:%02llu:%02llu, %.0f s/s\033[K\0338", SPEED_ROW,
+                          SCREEN_COLUMN, seconds / 86400, seconds / 3600 % 24, seconds / 60 % 60, seconds % 60,
+                          (ticks - previous) / (double)configTICK_RATE_HZ / elapsed);
+        if (length > 0) {
+            (void)!write(STDOUT_FILENO, text, length);
+        }
+        previous = ticks;
+        before = now;
+    }
+    return NULL;
+}
+
+/* === Public function implementation ========================================================== */
+
+board_t BoardCreate(void) {
+    SharedInit();
+    BuzzerInit();
+    KeysInit();
+    ScreenInit();
+    ReferenceInit();
+    TraceInit();
+    SpeedInit();
+
+    board.display = DisplayCreate(DIGITS, &(struct display_driver_s){
+                                              .ScreenTurnOff = ScreenTurnOff,
+                                              .SegmentsTurnOn = SegmentsTurnOn,
+                                              .DigitTurnOn = DigitTurnOn,
+                                          });
+    return &board;
+}
+
+// El puerto posix genera el tic con un temporizador del sistema operativo
+void SisTick_Init(uint16_t ticks) {
+    (void)ticks;
+}
+
+#endif
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,179 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Calculos de fechas del calendario civil
+ **
+ ** Las conversiones usan el algoritmo de dias desde la fecha civil de Howard Hinnant, que trabaja
+ ** con eras de 400 anios y meses contados desde marzo para evitar bucles y tablas por mes.
+ **
+ ** \addtogroup calendario Calendario
+ ** \brief Calendario gregoriano proleptico
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "calendario.h"
+#include <stddef.h>
+
+/* === Macros definitions ====================================================================== */
+
+#define SEGUNDOS_POR_DIA 86400
+#define DIAS_POR_ERA 146097
+#define DIAS_HASTA_1970 719468
+
+/* === Private data type declarations ========================================================== */
+
+//! Momento de cambio de horario, expresado en hora estandar local
+struct dst_cambio_s {
+    uint8_t mes;            //!< Mes en que ocurre el cambio
+    uint8_t semana : 3;     //!< Ocurrencia del dia de la semana en el mes, o DST_ULTIMA_SEMANA
+    uint8_t dia_semana : 3; //!< Dia de la semana, 0 para domingo
+    uint8_t hora;           //!< Hora estandar en que ocurre el cambio
+};
+
+//! Regla de horario de verano
+struct dst_regla_s {
+    struct dst_cambio_s inicio; //!< Comienzo del horario de verano
+    struct dst_cambio_s fin;    //!< Final del horario de verano
+    uint8_t minutos;            //!< Adelanto del reloj durante el horario de verano
+};
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static int32_t DiaDelCambio(int32_t anio, const struct dst_cambio_s * cambio);
+static int32_t SegundosHastaCambio(int32_t anio, const struct dst_cambio_s * cambio, int32_t dias,
+                                   uint32_t segundos);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static const struct dst_regla_s DST_REGLAS[DST_CANTIDAD] = {
+    [DST_EUROPA_CENTRAL] = {{3, DST_ULTIMA_SEMANA, 0, 2}, {10, DST_ULTIMA_SEMANA, 0, 2}, 60},
+    [DST_AMERICA_NORTE] = {{3, 2, 0, 2}, {11, 1, 0, 1}, 60},
+    [DST_AUSTRALIA_SUR] = {{10, 1, 0, 2}, {4, 1, 0, 2}, 60},
+};
+
+/* === Private function implementation ========================================================= */
+
+static int32_t DiaDelCambio(int32_t anio, const struct dst_cambio_s * cambio) {
+    int32_t dia;
+
+    if (cambio->semana == DST_ULTIMA_SEMANA) {
+        dia = CalendarDaysFromCivil(anio + (cambio->mes == 12), cambio->mes % 12 + 1, 1) - 1;
+        dia -= (CalendarWeekday(dia) + 7 - cambio->dia_semana) % 7;
+    } else {
+        dia = CalendarDaysFromCivil(anio, cambio->mes, 1);
+        dia += (cambio->dia_semana + 7 - CalendarWeekday(dia)) % 7 + 7 * (cambio->semana - 1);
+    }
+    return dia;
+}
+
+static int32_t SegundosHastaCambio(int32_t anio, const struct dst_cambio_s * cambio, int32_t dias,
+                                   uint32_t segundos) {
+    return (DiaDelCambio(anio, cambio) - dias) * SEGUNDOS_POR_DIA + cambio->hora * 3600 - (int32_t)segundos;
+}
+
+/* === Public function implementation ========================================================== */
+
+int32_t CalendarDaysFromCivil(int32_t anio, uint32_t mes, uint32_t dia) {
+    anio -= (mes <= 2);
+    int32_t era = (anio >= 0 ? anio : anio - 399) / 400;
+    uint32_t anio_era = (uint32_t)(anio - era * 400);
+    uint32_t dia_anio = (153 * (mes > 2 ? mes - 3 : mes + 9) + 2) / 5 + dia - 1;
+    uint32_t dia_era = anio_era * 365 + anio_era / 4 - anio_era / 100 + dia_anio;
+
+    return era * DIAS_POR_ERA + (int32_t)dia_era - DIAS_HASTA_1970;
+}
+
+void CalendarCivilFromDays(int32_t dias, fecha_t * fecha) {
+    dias += DIAS_HASTA_1970;
+    int32_t era = (dias >= 0 ? dias : dias - (DIAS_POR_ERA - 1)) / DIAS_POR_ERA;
+    uint32_t dia_era = (uint32_t)(dias - era * DIAS_POR_ERA);
+    uint32_t anio_era = (dia_era - dia_era / 1460 + dia_era / 36524 - dia_era / (DIAS_POR_ERA - 1)) / 365;
+    uint32_t dia_anio = dia_era - (365 * anio_era + anio_era / 4 - anio_era / 100);
+    uint32_t mes_marzo = (5 * dia_anio + 2) / 153;
+
+    fecha->dia = dia_anio - (153 * mes_marzo + 2) / 5 + 1;
+    fecha->mes = mes_marzo < 10 ? mes_marzo + 3 : mes_marzo - 9;
+    fecha->anio = (int32_t)anio_era + era * 400 + (fecha->mes <= 2);
+}
+
+uint8_t CalendarWeekday(int32_t dias) {
+    // El 1 de enero de 1970 fue jueves
+    return dias >= -4 ? (dias + 4) % 7 : (dias + 5) % 7 + 6;
+}
+
+bool CalendarIsValid(const fecha_t * fecha) {
+    uint8_t ultimo;
+    bool bisiesto = (fecha->anio % 4 == 0) && ((fecha->anio % 100 != 0) || (fecha->anio % 400 == 0));
+
+    if ((fecha->mes < 1) || (fecha->mes > 12)) {
+        return false;
+    }
+    // Los meses de 31 dias alternan con los de 30 y la secuencia se desplaza en agosto
+    ultimo = (fecha->mes == 2) ? 28 + bisiesto : 30 + ((fecha->mes + (fecha->mes >> 3)) & 1);
+    return (fecha->dia >= 1) && (fecha->dia <= ultimo);
+}
+
+int32_t CalendarDstOffset(dst_regla_t regla, int32_t dias, uint32_t segundos, uint32_t * siguiente) {
+    const struct dst_regla_s * datos;
+    fecha_t fecha;
+    int32_t cambios[4];
+    int32_t minimo = 0;
+    bool verano;
+
+    if (siguiente != NULL) {
+        *siguiente = 0;
+    }
+    if ((regla <= DST_NINGUNO) || (regla >= DST_CANTIDAD)) {
+        return 0;
+    }
+
+    datos = &DST_REGLAS[regla];
+    CalendarCivilFromDays(dias, &fecha);
+    cambios[0] = SegundosHastaCambio(fecha.anio, &datos->inicio, dias, segundos);
+    cambios[1] = SegundosHastaCambio(fecha.anio, &datos->fin, dias, segundos);
+    cambios[2] = SegundosHastaCambio(fecha.anio + 1, &datos->inicio, dias, segundos);
+    cambios[3] = SegundosHastaCambio(fecha.anio + 1, &datos->fin, dias, segundos);
+
+    if (datos->inicio.mes < datos->fin.mes) {
+        verano = (cambios[0] <= 0) && (cambios[1] > 0);
+    } else {
+        verano = (cambios[0] <= 0) || (cambios[1] > 0);
+    }
+
+    if (siguiente != NULL) {
+        for (int indice = 0; indice < 4; indice++) {
+            if ((cambios[indice] > 0) && ((minimo == 0) || (cambios[indice] < minimo))) {
+                minimo = cambios[indice];
+            }
+        }
+        *siguiente = minimo;
+    }
+    return verano ? datos->minutos * 60 : 0;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,238 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Medicion de la carga del procesador
+ **
+ ** Guarda el ultimo tiempo de ejecucion de cada tarea para calcular lo que uso en cada ventana. Las
+ ** diferencias se calculan sin signo, por lo que el contador puede dar la vuelta siempre que una
+ ** ventana sea mas corta que su periodo.
+ **
+ ** \addtogroup carga Carga
+ ** \brief Medicion de la carga del procesador
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "carga.h"
+#include "informe.h"
+#include <stddef.h>
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+#ifndef LOAD_INSTANCES
+#define LOAD_INSTANCES 1
+#endif
+
+//! Cantidad maxima de tareas que se miden, las que sobran no se informan
+#ifndef LOAD_TASKS
+#define LOAD_TASKS 8
+#endif
+
+//! Escala de los porcentajes, en decimas de por ciento
+#define ESCALA 1000
+
+/* === Private data type declarations ========================================================== */
+
+//! Medicion de una tarea
+typedef struct tarea_s {
+    bool medida;         //!< Bandera que indica si el registro esta en uso
+    bool presente;       //!< Bandera que indica si la tarea aparecio en la ultima muestra
+    const char * nombre; //!< Nombre de la tarea
+    uint32_t numero;     //!< Numero que identifica a la tarea
+    uint32_t anterior;   //!< Tiempo de ejecucion acumulado en la muestra anterior
+    uint16_t uso;        //!< Uso del procesador en la ultima ventana, en decimas de por ciento
+} * tarea_t;
+
+struct carga_s {
+    bool allocated;                    //!< Bandera que indica si el descriptor esta en uso
+    uint32_t total;                    //!< Valor del contador en la muestra anterior
+    struct carga_estado_s estado;      //!< Resultado de la ultima ventana
+    struct tarea_s tareas[LOAD_TASKS]; //!< Medicion de cada tarea
+};
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static carga_t LoadAllocate(void);
+static tarea_t BuscarTarea(carga_t carga, uint32_t numero);
+static uint16_t Proporcion(uint32_t parte, uint32_t total);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static struct carga_s instances[LOAD_INSTANCES] = {0};
+
+/* === Private function implementation ========================================================= */
+
+static carga_t LoadAllocate(void) {
+    carga_t carga = NULL;
+
+    for (int i = 0; i < LOAD_INSTANCES; i++) {
+
+        if (!instances[i].allocated) {
+
+            instances[i].allocated = true;
+            carga = &instances[i];
+            break;
+        }
+    }
+    return carga;
+}
+
+// Devuelve el registro de la tarea, o uno libre si es nueva, o NULL si no quedan registros
+static tarea_t BuscarTarea(carga_t carga, uint32_t numero) {
+    tarea_t libre = NULL;
+
+    for (int i = 0; i < LOAD_TASKS; i++) {
+        if (!carga->tareas[i].medida) {
+            if (libre == NULL) {
+                libre = &carga->tareas[i];
+            }
+        } else if (carga->tareas[i].numero == numero) {
+            return &carga->tareas[i];
+        }
+    }
+    if (libre != NULL) {
+        memset(libre, 0, sizeof(*libre));
+        libre->medida = true;
+        libre->numero = numero;
+    }
+    return libre;
+}
+
+static uint16_t Proporcion(uint32_t parte, uint32_t total) {
+    uint64_t resultado;
+
+    if (total == 0) {
+        return 0;
+    }
+    resultado = ((uint64_t)parte * ESCALA + total / 2) / total;
+    return (resultado > ESCALA) ? ESCALA : (uint16_t)resultado;
+}
+
+/* === Public function implementation ========================================================== */
+
+carga_t LoadCreate(void) {
+    carga_t self = LoadAllocate();
+
+    if (self) {
+        memset(self, 0, sizeof(*self));
+        self->allocated = true;
+    }
+    return self;
+}
+
+void LoadSample(carga_t carga, carga_muestra_t muestras, uint8_t cantidad, uint32_t total) {
+    uint32_t ventana = total - carga->total;
+    uint32_t inactivo = 0;
+    tarea_t tarea;
+
+    for (int i = 0; i < LOAD_TASKS; i++) {
+        carga->tareas[i].presente = false;
+    }
+
+    for (uint8_t indice = 0; indice < cantidad; indice++) {
+        tarea = BuscarTarea(carga, muestras[indice].numero);
+        if (tarea) {
+            uint32_t uso = muestras[indice].tiempo - tarea->anterior;
+
+            if (muestras[indice].inactiva) {
+                inactivo += uso;
+            }
+            tarea->presente = true;
+            tarea->nombre = muestras[indice].nombre;
+            tarea->anterior = muestras[indice].tiempo;
+            tarea->uso = Proporcion(uso, ventana);
+        }
+    }
+
+    // Los registros de las tareas borradas quedan libres para las que se creen despues
+    for (int i = 0; i < LOAD_TASKS; i++) {
+        if (!carga->tareas[i].presente) {
+            carga->tareas[i].medida = false;
+        }
+    }
+
+    carga->total = total;
+    carga->estado.ventana = ventana;
+    carga->estado.inactivo = Proporcion(inactivo, ventana);
+    carga->estado.carga = ESCALA - carga->estado.inactivo;
+    if ((carga->estado.ventanas == 0) || (carga->estado.carga > carga->estado.pico)) {
+        carga->estado.pico = carga->estado.carga;
+        carga->estado.ventana_pico = carga->estado.ventanas;
+    }
+    carga->estado.ventanas++;
+}
+
+void LoadSetLostEvents(carga_t carga, uint32_t perdidos) {
+    carga->estado.perdidos = perdidos;
+}
+
+void LoadGetStatus(carga_t carga, carga_estado_t estado) {
+    memcpy(estado, &carga->estado, sizeof(*estado));
+}
+
+uint16_t LoadReport(carga_t carga, char * texto, uint16_t tamano) {
+    uint16_t posicion = 0;
+    uint16_t completo;
+
+    // Se reserva el lugar del fin de linea para no tener que verificarlo al final
+    if (tamano == 0) {
+        return 0;
+    }
+    tamano--;
+
+    if (!ReportAppend(texto, &posicion, tamano, "$C,") ||
+        !ReportAppendNumber(texto, &posicion, tamano, carga->estado.ventana) ||
+        !ReportAppend(texto, &posicion, tamano, ",") ||
+        !ReportAppendNumber(texto, &posicion, tamano, carga->estado.carga) ||
+        !ReportAppend(texto, &posicion, tamano, ",") ||
+        !ReportAppendNumber(texto, &posicion, tamano, carga->estado.pico) ||
+        !ReportAppend(texto, &posicion, tamano, ",") ||
+        !ReportAppendNumber(texto, &posicion, tamano, carga->estado.perdidos)) {
+        return 0;
+    }
+
+    for (int i = 0; i < LOAD_TASKS; i++) {
+        tarea_t tarea = &carga->tareas[i];
+
+        if (!tarea->medida) {
+            continue;
+        }
+        completo = posicion;
+        if (!ReportAppend(texto, &posicion, tamano, ",") ||
+            !ReportAppend(texto, &posicion, tamano, (tarea->nombre != NULL) ? tarea->nombre : "") ||
+            !ReportAppend(texto, &posicion, tamano, ",") || !ReportAppendNumber(texto, &posicion, tamano, tarea->uso)) {
+            posicion = completo;
+            break;
+        }
+    }
+
+    texto[posicion++] = '\n';
+    return posicion;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
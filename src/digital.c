@@ -30,8 +30,14 @@ SPDX-License-Identifier: MIT
 /* === Headers files inclusions =============================================================== */
 
 #include "digital.h"
-#include "chip.h"
 #include "stdbool.h"
+#include <stddef.h>
+
+#ifdef POSIX
+#include "hal.h"
+#else
+#include "chip.h"
+#endif
 
 /* === Macros definitions ====================================================================== */
 #ifndef OUTPUT_INSTANCES
@@ -66,6 +72,11 @@ struct digital_input_s {
 digital_output_t DigitalOutputAllocate(void);
 digital_input_t DigitalInputAllocate(void);
 
+static void TerminalConfigure(uint8_t port, uint8_t pin, bool output);
+static void TerminalWrite(uint8_t port, uint8_t pin, bool state);
+static void TerminalToggle(uint8_t port, uint8_t pin);
+static bool TerminalRead(uint8_t port, uint8_t pin);
+
 /* === Public variable definitions ============================================================= */
 
 /* === Private variable definitions ============================================================ */
@@ -105,6 +116,61 @@ digital_input_t DigitalInputAllocate(void) {
     }
     return input;
 }
+
+#ifdef POSIX
+// En la placa posix los terminales se emulan con la capa de abstraccion, que los identifica con descriptores
+static hal_gpio_bit_t Terminal(uint8_t port, uint8_t pin) {
+    static const hal_gpio_bit_t * const TERMINALES[4][8] = {
+        {&HAL_GPIO0_0, &HAL_GPIO0_1, &HAL_GPIO0_2, &HAL_GPIO0_3,
+         &HAL_GPIO0_4, &HAL_GPIO0_5, &HAL_GPIO0_6, &HAL_GPIO0_7},
+        {&HAL_GPIO1_0, &HAL_GPIO1_1, &HAL_GPIO1_2, &HAL_GPIO1_3,
+         &HAL_GPIO1_4, &HAL_GPIO1_5, &HAL_GPIO1_6, &HAL_GPIO1_7},
+        {&HAL_GPIO2_0, &HAL_GPIO2_1, &HAL_GPIO2_2, &HAL_GPIO2_3,
+         &HAL_GPIO2_4, &HAL_GPIO2_5, &HAL_GPIO2_6, &HAL_GPIO2_7},
+        {&HAL_GPIO3_0, &HAL_GPIO3_1, &HAL_GPIO3_2, &HAL_GPIO3_3,
+         &HAL_GPIO3_4, &HAL_GPIO3_5, &HAL_GPIO3_6, &HAL_GPIO3_7},
+    };
+
+    return *TERMINALES[port % 4][pin % 8];
+}
+
+// Las salidas emuladas arrancan apagadas y las entradas en alto, como con las resistencias de la placa
+static void TerminalConfigure(uint8_t port, uint8_t pin, bool output) {
+    GpioSetDirection(Terminal(port, pin), output);
+}
+
+static void TerminalWrite(uint8_t port, uint8_t pin, bool state) {
+    GpioSetState(Terminal(port, pin), state);
+}
+
+static void TerminalToggle(uint8_t port, uint8_t pin) {
+    GpioBitToogle(Terminal(port, pin));
+}
+
+static bool TerminalRead(uint8_t port, uint8_t pin) {
+    return GpioGetState(Terminal(port, pin));
+}
+#else
+static void TerminalConfigure(uint8_t port, uint8_t pin, bool output) {
+    if (output) {
+        Chip_GPIO_SetPinState(LPC_GPIO_PORT, port, pin, false);
+    }
+    Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, port, pin, output);
+}
+
+static void TerminalWrite(uint8_t port, uint8_t pin, bool state) {
+    Chip_GPIO_SetPinState(LPC_GPIO_PORT, port, pin, state);
+}
+
+static void TerminalToggle(uint8_t port, uint8_t pin) {
+    Chip_GPIO_SetPinToggle(LPC_GPIO_PORT, port, pin);
+}
+
+static bool TerminalRead(uint8_t port, uint8_t pin) {
+    return Chip_GPIO_ReadPortBit(LPC_GPIO_PORT, port, pin);
+}
+#endif
+
 /* === Public function implementation ========================================================== */
 
 /* SALIDAS */
@@ -118,20 +184,19 @@ digital_output_t DigitalOutputCreate(uint8_t port, uint8_t pin, bool inverted) {
         output->pin = pin;
         output->inverted = inverted;
 
-        Chip_GPIO_SetPinState(LPC_GPIO_PORT, output->port, output->pin, false);
-        Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, output->port, output->pin, true);
+        TerminalConfigure(output->port, output->pin, true);
     }
 
     return output;
 }
 void DigitalOutputActivate(digital_output_t output) {
-    Chip_GPIO_SetPinState(LPC_GPIO_PORT, output->port, output->pin, output->inverted ^ true);
+    TerminalWrite(output->port, output->pin, output->inverted ^ true);
 }
 void DigitalOutputDeactivate(digital_output_t output) {
-    Chip_GPIO_SetPinState(LPC_GPIO_PORT, output->port, output->pin, output->inverted ^ false);
+    TerminalWrite(output->port, output->pin, output->inverted ^ false);
 }
 void DigitalOutputToggle(digital_output_t output) {
-    Chip_GPIO_SetPinToggle(LPC_GPIO_PORT, output->port, output->pin);
+    TerminalToggle(output->port, output->pin);
 }
 
 /* ENTRADAS */
@@ -145,14 +210,14 @@ digital_input_t DigitalInputCreate(uint8_t port, uint8_t pin, bool inverted) {
         input->pin = pin;
         input->inverted = inverted;
 
-        Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, input->port, input->pin, false);
+        TerminalConfigure(input->port, input->pin, false);
     }
 
     return input;
 }
 bool DigitalInputGetState(digital_input_t input) {
 
-    return input->inverted ^ Chip_GPIO_ReadPortBit(LPC_GPIO_PORT, input->port, input->pin);
+    return input->inverted ^ TerminalRead(input->port, input->pin);
 }
 bool DigitalInputHasChanged(digital_input_t input) {
 
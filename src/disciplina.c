@@ -0,0 +1,299 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Disciplina del reloj contra una referencia de tiempo externa
+ **
+ ** El lazo combina un PLL de segundo orden, que corrige el desfase y estima la frecuencia en forma
+ ** integral, con un FLL que mide la frecuencia directamente cuando los mensajes llegan muy espaciados
+ ** y el ruido del desfase pesa poco frente a la deriva acumulada.
+ **
+ ** \addtogroup disciplina Disciplina
+ ** \brief Disciplina del reloj contra una referencia externa
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "disciplina.h"
+#include <stddef.h>
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+#ifndef DISCIPLINE_INSTANCES
+#define DISCIPLINE_INSTANCES 1
+#endif
+
+//! Longitud maxima de un mensaje de la referencia
+#define LARGO_MENSAJE 32
+
+//! Desfase a partir del cual la hora se corrige de un salto, medio segundo en punto fijo de 32 bits
+#define UMBRAL_SALTO (1LL << 31)
+
+//! Constante de tiempo minima del PLL en segundos, usada para enganchar rapido la referencia
+#define CONSTANTE_MINIMA 32
+
+//! Constante de tiempo maxima del PLL en segundos, usada para filtrar el ruido una vez enganchado
+#define CONSTANTE_MAXIMA 1024
+
+//! Balance de muestras que hace duplicar o reducir a la mitad la constante de tiempo
+#define ESTABILIDAD_LIMITE 8
+
+//! Intervalo entre mensajes a partir del cual se mide la frecuencia con el FLL, en segundos
+#define INTERVALO_FLL 256
+
+//! Correccion de frecuencia maxima aplicada al reloj, en partes por mil millones
+#define CORRECCION_MAXIMA 500000
+
+//! Desfase por debajo del cual se considera que el reloj sigue a la referencia, en microsegundos
+#define DESFASE_SINCRONIZADO 2000
+
+//! Diferencia minima con la muestra anterior para considerar una muestra como pico aislado, en microsegundos
+#define PICO_MINIMO 10000
+
+//! Cantidad maxima de picos consecutivos descartados antes de aceptar el cambio como real
+#define PICOS_MAXIMOS 2
+
+/* === Private data type declarations ========================================================== */
+
+struct disciplina_s {
+    bool allocated;              //!< Bandera que indica si el descriptor esta en uso
+    clock_t reloj;               //!< Reloj que se corrige
+    char mensaje[LARGO_MENSAJE]; //!< Mensaje de la referencia que se esta recibiendo
+    uint8_t largo;               //!< Cantidad de caracteres recibidos del mensaje
+    uint8_t muestras;            //!< Muestras aceptadas desde la ultima correccion de un salto
+    uint8_t picos;               //!< Picos consecutivos descartados
+    uint32_t ultima;             //!< Segundo del reloj en que se tomo la ultima muestra
+    int32_t desfase;             //!< Desfase de la ultima muestra aceptada, en microsegundos
+    int32_t frecuencia;          //!< Error de frecuencia estimado, en partes por mil millones
+    int32_t correccion;          //!< Correccion de frecuencia aplicada al reloj, en partes por mil millones
+    int32_t constante;           //!< Constante de tiempo del PLL, en segundos
+    int8_t estabilidad;          //!< Balance de muestras dentro y fuera del nivel de ruido
+    uint32_t jitter;             //!< Variacion promedio del desfase entre muestras, en microsegundos
+    uint32_t saltos;             //!< Cantidad de correcciones de un salto
+};
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static disciplina_t DisciplineAllocate(void);
+static bool ProcesarMensaje(disciplina_t disciplina);
+static bool LeerNumero(const char ** texto, uint32_t * valor);
+static int32_t Limitar(int64_t valor, int32_t limite);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static struct disciplina_s instances[DISCIPLINE_INSTANCES] = {0};
+
+/* === Private function implementation ========================================================= */
+
+static disciplina_t DisciplineAllocate(void) {
+    disciplina_t disciplina = NULL;
+
+    for (int i = 0; i < DISCIPLINE_INSTANCES; i++) {
+
+        if (!instances[i].allocated) {
+
+            instances[i].allocated = true;
+            disciplina = &instances[i];
+            break;
+        }
+    }
+    return disciplina;
+}
+
+static bool ProcesarMensaje(disciplina_t disciplina) {
+    const char * texto = disciplina->mensaje;
+    uint32_t segundos;
+    uint32_t microsegundos;
+
+    if (strncmp(texto, "$T,", 3) != 0) {
+        return false;
+    }
+    texto += 3;
+    if (!LeerNumero(&texto, &segundos) || (*texto++ != ',')) {
+        return false;
+    }
+    if (!LeerNumero(&texto, &microsegundos) || (*texto != 0) || (microsegundos >= 1000000)) {
+        return false;
+    }
+    DisciplineSample(disciplina, segundos, microsegundos);
+    return true;
+}
+
+static bool LeerNumero(const char ** texto, uint32_t * valor) {
+    const char * inicio = *texto;
+
+    *valor = 0;
+    while ((**texto >= '0') && (**texto <= '9')) {
+        *valor = 10 * *valor + (**texto - '0');
+        (*texto)++;
+    }
+    return *texto != inicio;
+}
+
+static int32_t Limitar(int64_t valor, int32_t limite) {
+    if (valor > limite) {
+        valor = limite;
+    } else if (valor < -limite) {
+        valor = -limite;
+    }
+    return valor;
+}
+
+/* === Public function implementation ========================================================== */
+
+disciplina_t DisciplineCreate(clock_t reloj) {
+    disciplina_t self = DisciplineAllocate();
+
+    if (self) {
+        memset(self, 0, sizeof(*self));
+        self->allocated = true;
+        self->reloj = reloj;
+    }
+    return self;
+}
+
+bool DisciplineReceive(disciplina_t disciplina, const char * datos, uint16_t cantidad) {
+    bool procesado = false;
+
+    for (uint16_t indice = 0; indice < cantidad; indice++) {
+        char caracter = datos[indice];
+
+        if ((caracter == '\n') || (caracter == '\r')) {
+            if (disciplina->largo) {
+                disciplina->mensaje[disciplina->largo] = 0;
+                procesado = ProcesarMensaje(disciplina) || procesado;
+            }
+            disciplina->largo = 0;
+        } else if (disciplina->largo < LARGO_MENSAJE - 1) {
+            disciplina->mensaje[disciplina->largo++] = caracter;
+        }
+    }
+    return procesado;
+}
+
+bool DisciplineSample(disciplina_t disciplina, uint32_t segundos, uint32_t microsegundos) {
+    uint32_t fraccion;
+    uint32_t local = ClockGetStamp(disciplina->reloj, &fraccion);
+    int64_t diferencia = ((int64_t)(int32_t)(segundos - local) << 32) +
+                         (int64_t)((((uint64_t)microsegundos << 32) / 1000000) - fraccion);
+    int32_t desfase;
+    int32_t variacion;
+    int32_t intervalo;
+    int64_t constante;
+
+    if ((disciplina->muestras == 0 && disciplina->saltos == 0) || (diferencia >= UMBRAL_SALTO) ||
+        (diferencia <= -UMBRAL_SALTO)) {
+        // Un desfase grande no se puede corregir en forma gradual en un tiempo razonable
+        ClockStep(disciplina->reloj, diferencia);
+        disciplina->saltos++;
+        disciplina->muestras = 0;
+        disciplina->picos = 0;
+        disciplina->desfase = 0;
+        disciplina->constante = CONSTANTE_MINIMA;
+        disciplina->estabilidad = 0;
+        disciplina->ultima = ClockGetStamp(disciplina->reloj, &fraccion);
+        return true;
+    }
+
+    desfase = (diferencia * 1000000) >> 32;
+    variacion = desfase - disciplina->desfase;
+    intervalo = local - disciplina->ultima;
+    if (intervalo <= 0) {
+        intervalo = 1;
+    }
+
+    // Un desfase que se aparta mucho del anterior se descarta salvo que se repita
+    if ((disciplina->muestras > 0) && (disciplina->picos < PICOS_MAXIMOS) &&
+        ((uint32_t)(variacion < 0 ? -variacion : variacion) > 4 * disciplina->jitter + PICO_MINIMO)) {
+        disciplina->picos++;
+        return false;
+    }
+    disciplina->picos = 0;
+
+    if (disciplina->muestras > 0) {
+        disciplina->jitter += ((int32_t)(variacion < 0 ? -variacion : variacion) - (int32_t)disciplina->jitter) / 8;
+
+        // Si el desfase se mantiene en el nivel del ruido la constante crece para filtrarlo, si se aparta se achica
+        if ((uint32_t)(desfase < 0 ? -desfase : desfase) < 2 * disciplina->jitter) {
+            disciplina->estabilidad++;
+        } else if ((uint32_t)(desfase < 0 ? -desfase : desfase) > 4 * disciplina->jitter) {
+            disciplina->estabilidad -= 2;
+        }
+        if (disciplina->estabilidad >= ESTABILIDAD_LIMITE) {
+            disciplina->constante *= 2;
+            disciplina->estabilidad = 0;
+        } else if (disciplina->estabilidad <= -ESTABILIDAD_LIMITE) {
+            disciplina->constante /= 2;
+            disciplina->estabilidad = 0;
+        }
+    }
+    // La constante de tiempo debe abarcar varios mensajes para que el lazo sea estable
+    disciplina->constante = Limitar(disciplina->constante, CONSTANTE_MAXIMA);
+    if (disciplina->constante < CONSTANTE_MINIMA) {
+        disciplina->constante = CONSTANTE_MINIMA;
+    }
+    if (disciplina->constante < 4 * intervalo) {
+        disciplina->constante = 4 * intervalo;
+    }
+    constante = disciplina->constante;
+
+    if (disciplina->muestras > 0) {
+        if (intervalo >= INTERVALO_FLL) {
+            // FLL: la variacion del desfase mas la correccion aplicada es el error de frecuencia del reloj
+            int64_t medida = (int64_t)variacion * 1000 / intervalo + disciplina->correccion;
+
+            disciplina->frecuencia += (medida - disciplina->frecuencia) / 4;
+        } else {
+            // PLL: la frecuencia se estima integrando el desfase, con amortiguamiento critico
+            disciplina->frecuencia += (int64_t)desfase * 1000 * intervalo / (4 * constante * constante);
+        }
+        disciplina->frecuencia = Limitar(disciplina->frecuencia, CORRECCION_MAXIMA);
+    }
+
+    disciplina->correccion = Limitar(disciplina->frecuencia + (int64_t)desfase * 1000 / constante, CORRECCION_MAXIMA);
+    ClockSetRate(disciplina->reloj, disciplina->correccion);
+
+    disciplina->desfase = desfase;
+    disciplina->ultima = local;
+    if (disciplina->muestras < UINT8_MAX) {
+        disciplina->muestras++;
+    }
+    return true;
+}
+
+void DisciplineGetStatus(disciplina_t disciplina, disciplina_estado_t estado) {
+    estado->desfase = disciplina->desfase;
+    estado->frecuencia = disciplina->frecuencia;
+    estado->jitter = disciplina->jitter;
+    estado->saltos = disciplina->saltos;
+    // El desfase medido no puede ser menor que el ruido de la referencia
+    estado->sincronizado = (disciplina->muestras > 4) &&
+                           ((uint32_t)(disciplina->desfase < 0 ? -disciplina->desfase : disciplina->desfase) <
+                            DESFASE_SINCRONIZADO + 2 * disciplina->jitter);
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
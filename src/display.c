@@ -30,6 +30,7 @@ SPDX-License-Identifier: MIT
 /* === Headers files inclusions =============================================================== */
 
 #include "display.h"
+#include <stdbool.h>
 #include <string.h>
 
 /* === Macros definitions ====================================================================== */
@@ -130,6 +131,51 @@ void DisplayRefresh(display_t display) {
     return;
 }
 
+uint16_t DisplayDarkTime(display_t display) {
+    bool flashing = false;
+    uint32_t refrescos;
+
+    for (uint8_t digit = 0; digit < display->digits; digit++) {
+        if (display->memory[digit] == 0) {
+            continue;
+        }
+        if (display->flashing_factor && (digit >= display->flashing_from) && (digit <= display->flashing_to) &&
+            (display->flashing_count > (display->flashing_factor / 2))) {
+            flashing = true;
+        } else {
+            return 0;
+        }
+    }
+    if (!flashing) {
+        return UINT16_MAX;
+    }
+
+    // Los digitos se encienden cuando el contador del parpadeo vuelve a cero al pasar por el primer digito
+    refrescos = (display->digits - display->active_digit) +
+                (uint32_t)(display->flashing_factor - 1 - display->flashing_count) * display->digits;
+    return (refrescos - 1 < UINT16_MAX) ? refrescos - 1 : UINT16_MAX;
+}
+
+void DisplaySkip(display_t display, uint16_t refrescos) {
+    uint32_t total = display->active_digit + refrescos;
+
+    display->active_digit = total % display->digits;
+    if (display->flashing_factor) {
+        display->flashing_count = (display->flashing_count + total / display->digits) % display->flashing_factor;
+    }
+}
+
+void DisplayGetFrame(display_t display, uint8_t * frame) {
+    bool apagados = display->flashing_factor && (display->flashing_count > (display->flashing_factor / 2));
+
+    for (uint8_t digit = 0; digit < display->digits; digit++) {
+        frame[digit] = display->memory[digit];
+        if (apagados && (digit >= display->flashing_from) && (digit <= display->flashing_to)) {
+            frame[digit] = 0;
+        }
+    }
+}
+
 void DisplayFlashDigits(display_t display, uint8_t from, uint8_t to, uint16_t frecuency) {
     display->flashing_count = 0;
     display->flashing_factor = frecuency;
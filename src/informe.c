@@ -0,0 +1,78 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Armado de los informes de texto
+ **
+ ** \addtogroup informe Informe
+ ** \brief Armado de los informes de texto
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "informe.h"
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/* === Public function implementation ========================================================== */
+
+bool ReportAppend(char * texto, uint16_t * posicion, uint16_t tamano, const char * valor) {
+    while (*valor) {
+        if (*posicion >= tamano) {
+            return false;
+        }
+        texto[(*posicion)++] = *valor++;
+    }
+    return true;
+}
+
+// Los digitos se arman de atras para adelante y se copian solo si entran todos
+bool ReportAppendNumber(char * texto, uint16_t * posicion, uint16_t tamano, uint32_t valor) {
+    char digitos[11];
+    uint8_t cantidad = 0;
+
+    do {
+        digitos[sizeof(digitos) - 1 - cantidad++] = '0' + valor % 10;
+        valor /= 10;
+    } while (valor);
+    if (*posicion + cantidad > tamano) {
+        return false;
+    }
+    memcpy(&texto[*posicion], &digitos[sizeof(digitos) - cantidad], cantidad);
+    *posicion += cantidad;
+    return true;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
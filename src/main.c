@@ -41,289 +41,418 @@
 /* === Headers files inclusions =============================================================== */
 
 #include "FreeRTOS.h"
+#include "aplicacion.h"
 #include "bspciaa.h"
-#include "chip.h"
+#include "carga.h"
+#include "disciplina.h"
+#include "hal_tick.h"
+#include "pilas.h"
+#include "queue.h"
 #include "reloj.h"
 #include "task.h"
-#include <digital.h>
+#include "timers.h"
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 
 /* === Macros definitions ====================================================================== */
 
-// Tamaño de pila para tareas
-#define STACK_SYSTICK 256
-#define STACK_DISPLAY 256
-#define STACK_KEYS 512
+// Tamaño de pila para tareas, proporcional al minimo del puerto para que alcance tambien en la placa posix
+#define STACK_DISPATCHER (4 * configMINIMAL_STACK_SIZE)
+#define STACK_CARGA      (2 * configMINIMAL_STACK_SIZE)
 
 // Prioridades de las tareas
-#define PRIORIDAD_SYSTICK (tskIDLE_PRIORITY + 1)
-#define PRIORIDAD_DISPLAY (tskIDLE_PRIORITY)
-#define PRIORIDAD_KEYS (tskIDLE_PRIORITY + 2)
+#define PRIORIDAD_DISPATCHER (tskIDLE_PRIORITY + 1)
+#define PRIORIDAD_CARGA      (tskIDLE_PRIORITY + 1)
+
+// Cantidad de eventos que pueden esperar en la cola a ser procesados
+#define COLA_EVENTOS 16
+
+// Avisos a la tarea de la aplicacion, un bit por cada espera vencida y uno por los eventos enviados a la cola
+#define AVISO_VENCIMIENTO(espera) (1u << (espera))
+#define AVISO_COLA                (1u << ESPERAS)
+
+// Duracion de cada ventana de medicion de la carga, en milisegundos
+#define VENTANA_CARGA 1000
+
+// Cantidad de ventanas entre los informes de carga que se envian sin pedido por la consola
+#define INFORME_CARGA 10
+
+// Cantidad maxima de tareas del sistema operativo que se miden
+#define TAREAS_MEDIDAS 6
+
+// Margen de seguridad de los tamanos de pila recomendados, en por ciento
+#define MARGEN_PILAS 25
+
+// Numero con el que se mide el tic junto a las tareas, el sistema operativo las numera desde uno
+#define NUMERO_TIC 0
 
 /* === Private data type declarations ========================================================== */
-typedef enum {
-    SIN_CONFIGURAR,
-    MOSTRANDO_HORA,
-    AJUSTANDO_MINUTOS_ACTUAL,
-    AJUSTANDO_HORAS_ACTUAL,
-    AJUSTANDO_MINUTOS_ALARMA,
-    AJUSTANDO_HORAS_ALARMA,
-} modo_t;
 
 /* === Private variable declarations =========================================================== */
 
 /* === Private function declarations =========================================================== */
 
-void ActivarAlarma(bool reloj);
-
-static void TaskSysTick(void * pvParameters);
-static void TaskDisplayRefresh(void * pvParameters);
-static void TaskKeys(void * pvParameters);
+static void Bloquear(void);
+static void Liberar(void);
+static bool Notificar(evento_t evento);
+static void Temporizar(espera_t espera, uint32_t milisegundos);
+static void Detener(espera_t espera);
+static void Vencimiento(TimerHandle_t temporizador);
+static void Informar(void);
+static uint32_t TamanoPila(TaskHandle_t tarea);
+static void Muestrear(void);
+static void Transmitir(const char * texto, uint16_t largo, bool ceder);
+static void EnviarInforme(void);
+static void TaskDispatcher(void * pvParameters);
+static void TaskCarga(void * pvParameters);
 
 /* === Public variable definitions ============================================================= */
 
-static board_t board;
-static clock_t reloj;
-
-static modo_t modo;
-static bool sonar_alarma = false;
-static uint32_t tiempo_pulsacion = 0;
-static uint32_t timeout = 0;
-
 /* === Private variable definitions ============================================================ */
 
-static const uint8_t LIMITE_MINUTOS[] = {5, 9};
-static const uint8_t LIMITE_HORAS[] = {2, 3};
+static QueueHandle_t eventos;
+
+//! Temporizadores del servicio del sistema operativo para cada espera de la aplicacion
+static TimerHandle_t temporizadores[ESPERAS];
+
+static const char * const NOMBRES_ESPERAS[ESPERAS] = {
+    [ESPERA_PULSACION] = "Pulsacion",
+    [ESPERA_INACTIVIDAD] = "Inactividad",
+};
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+//! Memoria de los objetos del sistema operativo, reservada al compilar para que el arranque no use el heap
+static StaticQueue_t cola_eventos;
+static uint8_t almacenamiento_eventos[COLA_EVENTOS * sizeof(struct evento_s)];
+static StaticTimer_t temporizadores_reservados[ESPERAS];
+static StaticTask_t tarea_dispatcher;
+static StackType_t pila_dispatcher[STACK_DISPATCHER];
+static StaticTask_t tarea_carga;
+static StackType_t pila_carga[STACK_CARGA];
+static StaticTask_t tarea_inactiva;
+static StackType_t pila_inactiva[configMINIMAL_STACK_SIZE];
+static StaticTask_t tarea_temporizadores;
+static StackType_t pila_temporizadores[configTIMER_TASK_STACK_DEPTH];
+#endif
+
+//! Bandera que indica si un evento enviado desde el tic desperto a una tarea de mayor prioridad
+static BaseType_t despertar;
+
+//! Bandera que indica que el procesador esta en reposo y cantidad de tics que llegaron mientras tanto
+static volatile bool durmiendo = false;
+static volatile uint32_t tics_en_reposo;
+
+//! Tareas de la aplicacion, medicion de la carga y de las pilas, y puerto por el que se informa
+static TaskHandle_t dispatcher;
+static TaskHandle_t medicion;
+static carga_t carga;
+static pilas_t pilas;
+static hal_sci_t consola;
+
+//! Tiempo de ejecucion del gancho del tic, en total y el que le quito a la tarea inactiva
+static volatile uint32_t tiempo_tic;
+static volatile uint32_t tiempo_tic_inactiva;
+
+//! Estado de las tareas y muestras de la medicion, reservadas fuera de la pila de la tarea
+static TaskStatus_t estados[TAREAS_MEDIDAS];
+static struct carga_muestra_s muestras[TAREAS_MEDIDAS + 1];
+static struct pila_muestra_s muestras_pilas[TAREAS_MEDIDAS];
+static char informe[128];
+
+static const struct aplicacion_plataforma_s plataforma = {
+    .Bloquear = Bloquear,
+    .Liberar = Liberar,
+    .Notificar = Notificar,
+    .Temporizar = Temporizar,
+    .Detener = Detener,
+    .Informar = Informar,
+};
 
 /* === Private function implementation ========================================================= */
-void SonarAlarma(bool reloj) {
-    sonar_alarma = reloj;
 
-    if (reloj) {
+static void Bloquear(void) {
+    taskENTER_CRITICAL();
+}
 
-        DigitalOutputActivate(board->buzzer);
+static void Liberar(void) {
+    taskEXIT_CRITICAL();
+}
 
-    } else {
+// Con la cola llena tambien se avisa a la tarea, que vacia la cola y se resincroniza con el estado del tic
+static bool Notificar(evento_t evento) {
+    BaseType_t resultado = xQueueSendFromISR(eventos, evento, NULL);
 
-        DigitalOutputDeactivate(board->buzzer);
-    }
+    xTaskNotifyFromISR(dispatcher, AVISO_COLA, eSetBits, &despertar);
+    return (resultado == pdPASS);
 }
 
-void CambiarModo(modo_t valor) {
-    modo = valor;
-    switch (modo) {
-    case SIN_CONFIGURAR:
-        DisplayFlashDigits(board->display, 0, 3, 200);
-        break;
-    case MOSTRANDO_HORA:
-        DisplayFlashDigits(board->display, 0, 0, 0);
-        break;
-    case AJUSTANDO_MINUTOS_ACTUAL:
-        DisplayFlashDigits(board->display, 2, 3, 200);
-        break;
-    case AJUSTANDO_HORAS_ACTUAL:
-        DisplayFlashDigits(board->display, 0, 1, 200);
-        break;
-    case AJUSTANDO_MINUTOS_ALARMA:
-        DisplayFlashDigits(board->display, 2, 3, 200);
-        DisplayToggleDot(board->display, 0);
-        DisplayToggleDot(board->display, 1);
-        DisplayToggleDot(board->display, 2);
-        DisplayToggleDot(board->display, 3);
-        break;
-    case AJUSTANDO_HORAS_ALARMA:
-        DisplayFlashDigits(board->display, 0, 1, 200);
-        DisplayToggleDot(board->display, 0);
-        DisplayToggleDot(board->display, 1);
-        DisplayToggleDot(board->display, 2);
-        DisplayToggleDot(board->display, 3);
-        break;
-    default:
-        break;
-    }
+// El servicio de temporizadores tiene mayor prioridad y no se bloquea en los vencimientos, por lo que vacia su cola de
+// comandos en cuanto la aplicacion espera lugar. Un comando perdido dejaria un vencimiento sin cancelar o sin iniciar
+static void Temporizar(espera_t espera, uint32_t milisegundos) {
+    // Cambiar el periodo tambien inicia el temporizador, o lo reinicia si ya estaba corriendo
+    BaseType_t resultado = xTimerChangePeriod(temporizadores[espera], pdMS_TO_TICKS(milisegundos), portMAX_DELAY);
+
+    configASSERT(resultado == pdPASS);
 }
 
-void IncrementarBCD(uint8_t numero[2], const uint8_t limite[2]) {
-    if (numero[0] == limite[0] && numero[1] == limite[1]) {
-        numero[0] = 0;
-        numero[1] = 0;
-    } else {
-        numero[1]++;
-        if (numero[1] > 9) {
-            numero[1] = 0;
-            numero[0]++;
-            if (numero[0] > limite[0]) {
-                numero[0] = 0;
-            }
-        }
+static void Detener(espera_t espera) {
+    BaseType_t resultado = xTimerStop(temporizadores[espera], portMAX_DELAY);
+
+    configASSERT(resultado == pdPASS);
+}
+
+// Se ejecuta en la tarea del servicio de temporizadores y no puede bloquearse, el aviso por notificacion no se pierde
+// aunque la cola de eventos este llena y dos vencimientos de la misma espera se avisan juntos
+static void Vencimiento(TimerHandle_t temporizador) {
+    xTaskNotify(dispatcher, AVISO_VENCIMIENTO((uintptr_t)pvTimerGetTimerID(temporizador)), eSetBits);
+}
+
+// El informe se envia desde la tarea de medicion para no demorar a la aplicacion mientras se transmite
+static void Informar(void) {
+    xTaskNotifyGive(medicion);
+}
+
+static uint32_t TamanoPila(TaskHandle_t tarea) {
+    if (tarea == dispatcher) {
+        return STACK_DISPATCHER;
+    }
+    if (tarea == medicion) {
+        return STACK_CARGA;
+    }
+    if (tarea == xTimerGetTimerDaemonTaskHandle()) {
+        return configTIMER_TASK_STACK_DEPTH;
     }
+    return configMINIMAL_STACK_SIZE;
 }
 
-void DecrementarBCD(uint8_t numero[2], const uint8_t limite[2]) {
-    if (numero[0] == 0 && numero[1] == 0) {
-        numero[0] = limite[0];
-        numero[1] = limite[1];
-    } else {
-        if (numero[1] == 0) {
-            numero[1] = 9;
-            if (numero[0] == 0) {
-                numero[0] = limite[0];
-            } else {
-                numero[0]--;
-            }
-        } else {
-            numero[1]--;
+// Toma el tiempo de ejecucion y el espacio libre en la pila de todas las tareas en una sola consulta
+static void Muestrear(void) {
+    TaskHandle_t inactiva = xTaskGetIdleTaskHandle();
+    UBaseType_t cantidad;
+    uint32_t total;
+
+    cantidad = uxTaskGetSystemState(estados, TAREAS_MEDIDAS, &total);
+    for (UBaseType_t indice = 0; indice < cantidad; indice++) {
+        muestras[indice].nombre = estados[indice].pcTaskName;
+        muestras[indice].numero = estados[indice].xTaskNumber;
+        muestras[indice].tiempo = estados[indice].ulRunTimeCounter;
+        muestras[indice].inactiva = (estados[indice].xHandle == inactiva);
+        // El sistema operativo le cuenta el tic a la tarea interrumpida, pero no es tiempo libre
+        if (muestras[indice].inactiva) {
+            muestras[indice].tiempo -= tiempo_tic_inactiva;
         }
+
+        muestras_pilas[indice].nombre = estados[indice].pcTaskName;
+        muestras_pilas[indice].numero = estados[indice].xTaskNumber;
+        muestras_pilas[indice].tamano = TamanoPila(estados[indice].xHandle);
+        muestras_pilas[indice].libre = estados[indice].usStackHighWaterMark;
     }
+    muestras[cantidad].nombre = "Tic";
+    muestras[cantidad].numero = NUMERO_TIC;
+    muestras[cantidad].tiempo = tiempo_tic;
+    muestras[cantidad].inactiva = false;
+
+    LoadSample(carga, muestras, cantidad + 1, total);
+    LoadSetLostEvents(carga, ApplicationLostEvents());
+    StackMonitorSample(pilas, muestras_pilas, cantidad);
 }
 
-static void TaskSysTick(void * pvParameters) {
-    TickType_t last_value = xTaskGetTickCount();
-    bool current_value;
-    uint8_t hora[6];
+// La fifo del puerto es chica, lo que no entra se envia en los tics siguientes o esperando si no se puede ceder
+static void Transmitir(const char * texto, uint16_t largo, bool ceder) {
+    uint16_t enviados = 0;
 
-    while (true) {
-        current_value = ClockUpdate(reloj);
-
-        if (modo <= MOSTRANDO_HORA) {
-            ClockGetTime(reloj, hora, sizeof(hora));
-            DisplayWriteBCD(board->display, hora, sizeof(hora));
-            if (DigitalInputGetState(board->set_time) || DigitalInputGetState(board->set_alarm)) {
-                tiempo_pulsacion++;
-            } else {
-                tiempo_pulsacion = 0;
-            }
-            if (current_value) {
-                DisplayToggleDot(board->display, 1);
-            }
-            if (AlarmGetState(reloj)) {
-                DisplayToggleDot(board->display, 3);
-            }
-        }
-        timeout++;
-        if ((timeout > 30000) && (modo > MOSTRANDO_HORA)) {
-            if (ClockGetTime(reloj, hora, sizeof(hora))) {
-                CambiarModo(MOSTRANDO_HORA);
-            } else {
-                CambiarModo(SIN_CONFIGURAR);
-            }
-            timeout = 0;
+    if (consola == NULL) {
+        return;
+    }
+    while (enviados < largo) {
+        enviados += SciSendData(consola, &texto[enviados], largo - enviados);
+        if (ceder && (enviados < largo)) {
+            vTaskDelay(1);
         }
-        vTaskDelayUntil(&last_value, pdMS_TO_TICKS(1));
     }
 }
 
-static void TaskDisplayRefresh(void * pvParameters) {
-    while (true) {
-        DisplayRefresh(board->display);
-        vTaskDelay(pdMS_TO_TICKS(1));
-    }
+static void EnviarInforme(void) {
+    Transmitir(informe, LoadReport(carga, informe, sizeof(informe)), true);
+    Transmitir(informe, StackMonitorReport(pilas, informe, sizeof(informe)), true);
 }
 
-static void TaskKeys(void * pvParameters) {
-    uint8_t entrada[4];
+// Unica tarea de la aplicacion, queda bloqueada hasta que llega un evento del tic o vence un temporizador
+static void TaskDispatcher(void * pvParameters) {
+    struct evento_s evento;
+    uint32_t avisos;
+
     while (true) {
-        if (DigitalInputHasActivated(board->accept)) {
-            if (modo == MOSTRANDO_HORA) {
-                ActivateAlarm(reloj, true);
+        xTaskNotifyWait(0, UINT32_MAX, &avisos, portMAX_DELAY);
 
-                if (sonar_alarma) {
-                    ExtendAlarm(reloj, 5);
-                }
-            }
-            if (modo == AJUSTANDO_MINUTOS_ACTUAL) {
-                CambiarModo(AJUSTANDO_HORAS_ACTUAL);
-            } else if (modo == AJUSTANDO_HORAS_ACTUAL) {
-                ClockSetTime(reloj, entrada, sizeof(entrada));
-                CambiarModo(MOSTRANDO_HORA);
-            }
-            if (modo == AJUSTANDO_MINUTOS_ALARMA) {
-                CambiarModo(AJUSTANDO_HORAS_ALARMA);
-            } else if (modo == AJUSTANDO_HORAS_ALARMA) {
-                AlarmSetTime(reloj, entrada, sizeof(entrada));
-                CambiarModo(MOSTRANDO_HORA);
-            }
-            timeout = 0;
+        // La cola se vacia primero porque la aplicacion descarta los vencimientos que ya no corresponden
+        while (xQueueReceive(eventos, &evento, 0) == pdPASS) {
+            ApplicationProcess(&evento, xTaskGetTickCount() * portTICK_PERIOD_MS);
         }
-
-        if (DigitalInputHasActivated(board->cancel)) {
-            if (modo == MOSTRANDO_HORA) {
-
-                if (sonar_alarma) {
-                    DisableAlarm(reloj);
-                } else {
-                    ActivateAlarm(reloj, false);
-                }
+        for (espera_t espera = 0; espera < ESPERAS; espera++) {
+            if (avisos & AVISO_VENCIMIENTO(espera)) {
+                evento.tipo = EVENTO_TIEMPO_AGOTADO;
+                evento.dato = espera;
+                ApplicationProcess(&evento, xTaskGetTickCount() * portTICK_PERIOD_MS);
             }
-            if (ClockGetTime(reloj, entrada, sizeof(entrada))) {
-                CambiarModo(MOSTRANDO_HORA);
-            } else {
-                CambiarModo(SIN_CONFIGURAR);
-            };
         }
+    }
+}
 
-        if (DigitalInputGetState(board->set_time)) {
-            if ((tiempo_pulsacion > 3000) && (modo <= MOSTRANDO_HORA)) {
-                CambiarModo(AJUSTANDO_MINUTOS_ACTUAL);
-                ClockGetTime(reloj, entrada, sizeof(entrada));
-                DisplayWriteBCD(board->display, entrada, sizeof(entrada));
-                tiempo_pulsacion = 0;
-            }
-            timeout = 0;
-        }
+// Cierra una ventana de medicion cada VENTANA_CARGA milisegundos y envia el informe cuando se pide
+static void TaskCarga(void * pvParameters) {
+    TickType_t proxima = xTaskGetTickCount() + pdMS_TO_TICKS(VENTANA_CARGA);
+    TickType_t restante;
+    uint32_t ventanas = 0;
+    bool enviar;
 
-        if (DigitalInputGetState(board->set_alarm)) {
-            if ((tiempo_pulsacion > 3000) && (modo <= MOSTRANDO_HORA)) {
-                CambiarModo(AJUSTANDO_MINUTOS_ALARMA);
-                AlarmGetTime(reloj, entrada, sizeof(entrada));
-                DisplayWriteBCD(board->display, entrada, sizeof(entrada));
-            }
-            timeout = 0;
+    while (true) {
+        restante = proxima - xTaskGetTickCount();
+        if (restante > pdMS_TO_TICKS(VENTANA_CARGA)) {
+            restante = 0;
         }
+        enviar = (ulTaskNotifyTake(pdTRUE, restante) > 0);
 
-        if (DigitalInputHasActivated(board->decrement)) {
-            if (modo == AJUSTANDO_MINUTOS_ACTUAL || modo == AJUSTANDO_MINUTOS_ALARMA) {
-                DecrementarBCD(&entrada[2], LIMITE_MINUTOS);
-            } else if (modo == AJUSTANDO_HORAS_ACTUAL || modo == AJUSTANDO_HORAS_ALARMA) {
-                DecrementarBCD(entrada, LIMITE_HORAS);
-            }
-            DisplayWriteBCD(board->display, entrada, sizeof(entrada));
-            timeout = 0;
+        if ((TickType_t)(xTaskGetTickCount() - proxima) <= pdMS_TO_TICKS(VENTANA_CARGA)) {
+            Muestrear();
+            proxima += pdMS_TO_TICKS(VENTANA_CARGA);
+            ventanas++;
+            enviar = enviar || (ventanas % INFORME_CARGA == 0);
         }
-
-        if (DigitalInputHasActivated(board->increment)) {
-            if (modo == AJUSTANDO_MINUTOS_ACTUAL || modo == AJUSTANDO_MINUTOS_ALARMA) {
-                IncrementarBCD(&entrada[2], LIMITE_MINUTOS);
-            } else if (modo == AJUSTANDO_HORAS_ACTUAL || modo == AJUSTANDO_HORAS_ALARMA) {
-                IncrementarBCD(entrada, LIMITE_HORAS);
-            }
-            DisplayWriteBCD(board->display, entrada, sizeof(entrada));
-            timeout = 0;
+        if (enviar) {
+            EnviarInforme();
         }
-        vTaskDelay(pdMS_TO_TICKS(1));
     }
 }
 
 /* === Public function implementation ========================================================= */
 
-int main(void) {
+void vApplicationTickHook(void) {
+    uint32_t inicio = TickCounterRead();
+    uint32_t duracion;
+
+    despertar = pdFALSE;
+    // Los tics que llegan durante el reposo se atienden todos juntos al despertar
+    if (durmiendo) {
+        tics_en_reposo++;
+    } else {
+        ApplicationTick();
+    }
+
+    duracion = TickCounterRead() - inicio;
+    tiempo_tic += duracion;
+    if (xTaskGetCurrentTaskHandle() == xTaskGetIdleTaskHandle()) {
+        tiempo_tic_inactiva += duracion;
+    }
+    portYIELD_FROM_ISR(despertar);
+}
 
-    reloj = ClockCreate(1000, SonarAlarma);
+// Se llama desde la tarea inactiva, con el planificador detenido, cuando ninguna tarea tiene que ejecutarse
+void vApplicationSleep(uint32_t xExpectedIdleTime) {
+    TickType_t inicio;
+    uint32_t limite;
 
-    board = BoardCreate();
+#ifdef portTIME_SCALE_VIRTUAL
+    // Con el tiempo simulado el puerto atiende cada tic completo sin esperarlo, no hay reposo que acotar
+    if (ulPortGetTimeScale() != portTIME_SCALE_REAL) {
+        vPortSuppressTicksAndSleep(xExpectedIdleTime);
+        return;
+    }
+#endif
+
+    taskENTER_CRITICAL();
+    durmiendo = true;
+    tics_en_reposo = 0;
+    inicio = xTaskGetTickCount();
+    limite = ApplicationSleepLimit(xExpectedIdleTime);
+    taskEXIT_CRITICAL();
+
+    // Con un limite de un tic el puerto solo duerme hasta el proximo tic sin suprimir ninguno
+    vPortSuppressTicksAndSleep(limite);
+
+    taskENTER_CRITICAL();
+    durmiendo = false;
+    despertar = pdFALSE;
+    // La cuenta del sistema operativo incluye los tics suprimidos pero no los que quedaron pendientes
+    ApplicationResume((xTaskGetTickCount() - inicio) + tics_en_reposo);
+    taskEXIT_CRITICAL();
+}
 
-    modo = SIN_CONFIGURAR;
+// Con la pila desbordada el sistema no puede seguir, se informa la tarea sin usar el sistema operativo
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char * pcTaskName) {
+    static const char AVISO[] = "$D,";
 
-    SisTick_Init(1000);
+    taskDISABLE_INTERRUPTS();
+    Transmitir(AVISO, sizeof(AVISO) - 1, false);
+    Transmitir(pcTaskName, strlen(pcTaskName), false);
+    Transmitir("\n", 1, false);
+    while (true) {
+    }
+}
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+void vApplicationGetIdleTaskMemory(StaticTask_t ** ppxIdleTaskTCBBuffer, StackType_t ** ppxIdleTaskStackBuffer,
+                                   uint32_t * pulIdleTaskStackSize) {
+    *ppxIdleTaskTCBBuffer = &tarea_inactiva;
+    *ppxIdleTaskStackBuffer = pila_inactiva;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
 
-    CambiarModo(SIN_CONFIGURAR);
+void vApplicationGetTimerTaskMemory(StaticTask_t ** ppxTimerTaskTCBBuffer, StackType_t ** ppxTimerTaskStackBuffer,
+                                    uint32_t * pulTimerTaskStackSize) {
+    *ppxTimerTaskTCBBuffer = &tarea_temporizadores;
+    *ppxTimerTaskStackBuffer = pila_temporizadores;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+#endif
+
+int main(void) {
+    clock_t reloj = ClockCreate(1000, ApplicationAlarm);
+    disciplina_t disciplina = DisciplineCreate(reloj);
+    board_t board = BoardCreate();
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    eventos = xQueueCreateStatic(COLA_EVENTOS, sizeof(struct evento_s), almacenamiento_eventos, &cola_eventos);
+    for (espera_t espera = 0; espera < ESPERAS; espera++) {
+        temporizadores[espera] = xTimerCreateStatic(NOMBRES_ESPERAS[espera], 1, pdFALSE, (void *)(uintptr_t)espera,
+                                                    Vencimiento, &temporizadores_reservados[espera]);
+    }
+    dispatcher = xTaskCreateStatic(TaskDispatcher, "TareaEventos", STACK_DISPATCHER, NULL, PRIORIDAD_DISPATCHER,
+                                   pila_dispatcher, &tarea_dispatcher);
+    medicion = xTaskCreateStatic(TaskCarga, "TareaCarga", STACK_CARGA, NULL, PRIORIDAD_CARGA, pila_carga,
+                                 &tarea_carga);
+#else
+    eventos = xQueueCreate(COLA_EVENTOS, sizeof(struct evento_s));
+    for (espera_t espera = 0; espera < ESPERAS; espera++) {
+        temporizadores[espera] =
+            xTimerCreate(NOMBRES_ESPERAS[espera], 1, pdFALSE, (void *)(uintptr_t)espera, Vencimiento);
+    }
+    if (xTaskCreate(TaskDispatcher, "TareaEventos", STACK_DISPATCHER, NULL, PRIORIDAD_DISPATCHER, &dispatcher) !=
+        pdPASS) {
+        dispatcher = NULL;
+    }
+    if (xTaskCreate(TaskCarga, "TareaCarga", STACK_CARGA, NULL, PRIORIDAD_CARGA, &medicion) != pdPASS) {
+        medicion = NULL;
+    }
+#endif
 
-    xTaskCreate(TaskSysTick, "TareaSysTick", STACK_SYSTICK, NULL, PRIORIDAD_SYSTICK, NULL);
+    // Sin alguno de los objetos la aplicacion no puede funcionar, la falla se detiene en configASSERT
+    configASSERT(eventos != NULL);
+    for (espera_t espera = 0; espera < ESPERAS; espera++) {
+        configASSERT(temporizadores[espera] != NULL);
+    }
+    configASSERT(dispatcher != NULL);
+    configASSERT(medicion != NULL);
 
-    xTaskCreate(TaskDisplayRefresh, "TareaRefrescoDisplay", STACK_DISPLAY, NULL, PRIORIDAD_DISPLAY, NULL);
+    carga = LoadCreate();
+    pilas = StackMonitorCreate(MARGEN_PILAS);
+    consola = board->referencia;
 
-    xTaskCreate(TaskKeys, "TareaTeclasPrincipal", STACK_KEYS, NULL, PRIORIDAD_KEYS, NULL);
+    ApplicationCreate(board, reloj, disciplina, &plataforma);
+
+    SisTick_Init(1000);
 
     vTaskStartScheduler();
 
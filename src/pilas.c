@@ -0,0 +1,196 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Monitor del uso de las pilas de las tareas
+ **
+ ** El sistema operativo mide el espacio libre buscando el patron con que llena la pila al crear la
+ ** tarea, por lo que cada muestra ya es el peor caso desde la creacion. El monitor conserva ademas
+ ** el peor caso de las tareas que se borran y se vuelven a crear durante la ejecucion.
+ **
+ ** \addtogroup pilas Pilas
+ ** \brief Monitor del uso de las pilas de las tareas
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "pilas.h"
+#include "informe.h"
+#include <stddef.h>
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+#ifndef STACK_MONITOR_INSTANCES
+#define STACK_MONITOR_INSTANCES 1
+#endif
+
+//! Cantidad maxima de tareas que se registran
+#ifndef STACK_MONITOR_TASKS
+#define STACK_MONITOR_TASKS 8
+#endif
+
+//! Multiplo al que se redondean los tamanos recomendados, mantiene la alineacion de las pilas
+#define REDONDEO 8
+
+/* === Private data type declarations ========================================================== */
+
+//! Registro de la pila de una tarea
+typedef struct registro_s {
+    bool usado;          //!< Bandera que indica si el registro esta en uso
+    uint32_t numero;     //!< Numero que identifica a la tarea
+    const char * nombre; //!< Nombre de la tarea
+    uint32_t tamano;     //!< Tamano de la pila
+    uint32_t libre;      //!< Menor espacio libre registrado
+} * registro_t;
+
+struct pilas_s {
+    bool allocated;                                   //!< Bandera que indica si el descriptor esta en uso
+    uint8_t margen;                                   //!< Margen de seguridad, en por ciento
+    struct registro_s registros[STACK_MONITOR_TASKS]; //!< Registro de cada tarea
+};
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static pilas_t StackMonitorAllocate(void);
+static registro_t BuscarRegistro(pilas_t pilas, uint32_t numero);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static struct pilas_s instances[STACK_MONITOR_INSTANCES] = {0};
+
+/* === Private function implementation ========================================================= */
+
+static pilas_t StackMonitorAllocate(void) {
+    pilas_t pilas = NULL;
+
+    for (int i = 0; i < STACK_MONITOR_INSTANCES; i++) {
+
+        if (!instances[i].allocated) {
+
+            instances[i].allocated = true;
+            pilas = &instances[i];
+            break;
+        }
+    }
+    return pilas;
+}
+
+// Devuelve el registro de la tarea, o uno libre si es nueva, o NULL si no quedan registros
+static registro_t BuscarRegistro(pilas_t pilas, uint32_t numero) {
+    for (int i = 0; i < STACK_MONITOR_TASKS; i++) {
+        if (!pilas->registros[i].usado) {
+            pilas->registros[i].usado = true;
+            pilas->registros[i].numero = numero;
+            pilas->registros[i].libre = UINT32_MAX;
+            return &pilas->registros[i];
+        }
+        if (pilas->registros[i].numero == numero) {
+            return &pilas->registros[i];
+        }
+    }
+    return NULL;
+}
+
+/* === Public function implementation ========================================================== */
+
+pilas_t StackMonitorCreate(uint8_t margen) {
+    pilas_t self = StackMonitorAllocate();
+
+    if (self) {
+        memset(self, 0, sizeof(*self));
+        self->allocated = true;
+        self->margen = margen;
+    }
+    return self;
+}
+
+void StackMonitorSample(pilas_t pilas, pila_muestra_t muestras, uint8_t cantidad) {
+    for (uint8_t indice = 0; indice < cantidad; indice++) {
+        registro_t registro = BuscarRegistro(pilas, muestras[indice].numero);
+
+        if (registro) {
+            registro->nombre = muestras[indice].nombre;
+            registro->tamano = muestras[indice].tamano;
+            if (muestras[indice].libre < registro->libre) {
+                registro->libre = muestras[indice].libre;
+            }
+        }
+    }
+}
+
+bool StackMonitorGetTask(pilas_t pilas, uint8_t indice, pila_estado_t estado) {
+    registro_t registro;
+    uint64_t recomendado;
+
+    if ((indice >= STACK_MONITOR_TASKS) || !pilas->registros[indice].usado) {
+        return false;
+    }
+    registro = &pilas->registros[indice];
+
+    estado->nombre = registro->nombre;
+    estado->tamano = registro->tamano;
+    estado->usado = (registro->libre < registro->tamano) ? registro->tamano - registro->libre : 0;
+    recomendado = ((uint64_t)estado->usado * (100 + pilas->margen) + 99) / 100;
+    estado->recomendado = (uint32_t)((recomendado + REDONDEO - 1) / REDONDEO * REDONDEO);
+    return true;
+}
+
+uint16_t StackMonitorReport(pilas_t pilas, char * texto, uint16_t tamano) {
+    struct pila_estado_s estado;
+    uint16_t posicion = 0;
+    uint16_t completo;
+
+    // Se reserva el lugar del fin de linea para no tener que verificarlo al final
+    if (tamano == 0) {
+        return 0;
+    }
+    tamano--;
+
+    if (!ReportAppend(texto, &posicion, tamano, "$S")) {
+        return 0;
+    }
+
+    for (uint8_t indice = 0; StackMonitorGetTask(pilas, indice, &estado); indice++) {
+        completo = posicion;
+        if (!ReportAppend(texto, &posicion, tamano, ",") ||
+            !ReportAppend(texto, &posicion, tamano, (estado.nombre != NULL) ? estado.nombre : "") ||
+            !ReportAppend(texto, &posicion, tamano, ",") ||
+            !ReportAppendNumber(texto, &posicion, tamano, estado.tamano) ||
+            !ReportAppend(texto, &posicion, tamano, ",") ||
+            !ReportAppendNumber(texto, &posicion, tamano, estado.usado) ||
+            !ReportAppend(texto, &posicion, tamano, ",") ||
+            !ReportAppendNumber(texto, &posicion, tamano, estado.recomendado)) {
+            posicion = completo;
+            break;
+        }
+    }
+
+    texto[posicion++] = '\n';
+    return posicion;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
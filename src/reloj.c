@@ -30,6 +30,7 @@ SPDX-License-Identifier: MIT
 /* === Headers files inclusions =============================================================== */
 
 #include "reloj.h"
+#include <stddef.h>
 #include <string.h>
 
 /* === Macros definitions ====================================================================== */
@@ -40,140 +41,746 @@ SPDX-License-Identifier: MIT
 #define HOURS_UNITS 1
 #define HOURS_TENS 0
 
+#ifndef CLOCK_INSTANCES
+#define CLOCK_INSTANCES 4
+#endif
+
+#define SEGUNDOS_POR_DIA 86400u
+
+//! Dias desde el 1 de enero de 1970 hasta el 1 de enero de 2000, origen de la hora local del reloj
+#define DIAS_EPOCA 10957
+
+//! Mascara con todos los dias de la semana habilitados para la alarma
+#define TODOS_LOS_DIAS 0x7F
+
+#ifndef CLOCK_EVENTS
+#define CLOCK_EVENTS 8
+#endif
+
+//! Cantidad de niveles de la rueda de tiempos, cubren 2^24 segundos (unos 194 dias)
+#define RUEDA_NIVELES 4
+
+//! Cantidad de bits del tiempo que resuelve cada nivel de la rueda
+#define RUEDA_BITS 6
+
+//! Cantidad de ranuras en cada nivel de la rueda
+#define RUEDA_RANURAS (1 << RUEDA_BITS)
+
+//! Indice que marca el final de una lista de eventos
+#define NINGUNO 0xFFFF
+
 /* === Private data type declarations ========================================================== */
 
+//! Base de tiempo monotona compartida por todos los relojes
+struct base_tiempo_s {
+    uint32_t segundos;         //!< Segundos transcurridos desde la creacion del primer reloj
+    uint16_t tics_por_segundo; //!< Cantidad de tics que forman un segundo
+    uint16_t tics;             //!< Tics que faltan para completar el segundo actual
+    uint32_t vencimiento;      //!< Segundo en que vence el primero de los plazos de todos los relojes
+    uint32_t fraccion;         //!< Fraccion de tic acumulada por la correccion, en unidades de 2^-32 tics
+    int32_t correccion;        //!< Fraccion de tic que se suma en cada tic para corregir la frecuencia
+};
+
+//! Evento diferido programado en la rueda de tiempos
+struct clock_event_s {
+    uint16_t siguiente;             //!< Indice del siguiente evento en la misma ranura o en la lista de libres
+    uint16_t anterior;              //!< Indice del evento anterior en la misma ranura
+    uint16_t ranura;                //!< Ranura de la rueda que ocupa el evento, NINGUNO si esta libre
+    uint32_t vencimiento;           //!< Segundo de la base de tiempo en que vence el evento
+    clock_t reloj;                  //!< Reloj al que pertenece el evento
+    clock_event_handler_t handler;  //!< Funcion que se llama al vencer el evento
+    void * objeto;                  //!< Parametro que se entrega a la funcion al vencer el evento
+};
+
+//! Rueda jerarquica de tiempos que ordena los eventos diferidos de todos los relojes
+struct rueda_s {
+    uint32_t actual;                                   //!< Ultimo segundo procesado por la rueda
+    uint32_t proximo;                                  //!< Proximo segundo en que la rueda tiene trabajo
+    uint16_t pendientes;                               //!< Cantidad de eventos programados
+    uint16_t libres;                                   //!< Primer evento de la lista de eventos libres
+    uint16_t demorados;                                //!< Eventos que vencieron antes del final de un avance
+    bool avanzando;                                    //!< Bandera que indica que la rueda esta llamando manejadores
+    uint64_t ocupadas[RUEDA_NIVELES];                  //!< Mapa de bits de las ranuras no vacias
+    uint16_t ranuras[RUEDA_NIVELES * RUEDA_RANURAS];   //!< Primer evento de cada ranura
+};
+
+struct clock_s {
+    bool allocated;                   //!< Bandera que indica si el descriptor esta en uso
+    clock_t referencia;               //!< Reloj del que se toma la hora estandar, el mismo si es propia
+    uint32_t desfase;                 //!< Diferencia entre la hora estandar y la base de tiempo
+    int32_t desplazamiento;           //!< Segundos sumados a la hora del reloj de referencia
+    int32_t horario_verano;           //!< Segundos que se suman a la hora estandar por horario de verano
+    dst_regla_t regla_dst;            //!< Regla de horario de verano aplicada
+    uint32_t vencimiento_dst;         //!< Segundo de la base de tiempo en que cambia el horario de verano
+    bool valida;                      //!< Bandera que indica si la hora fue configurada
+    alarm_notification_t EnableAlarm; //!< Funcion para notificar los cambios de la alarma
+    uint32_t hora_alarma;             //!< Hora de la alarma en segundos desde la medianoche
+    uint32_t vencimiento_alarma;      //!< Proximo segundo de la base de tiempo en que vence la alarma
+    uint8_t dias_alarma;              //!< Dias de la semana en que suena la alarma, bit 0 es domingo
+    bool activate_alarm;              //!< Bandera que indica si la alarma esta activa
+    clock_event_t pospuesta;          //!< Evento que reanuda la alarma pospuesta, NULL si no esta pospuesta
+    bool sonar_pospuesta;             //!< Bandera que indica que la alarma pospuesta debe sonar
+};
+
 /* === Private variable declarations =========================================================== */
 
 /* === Private function declarations =========================================================== */
 
+static clock_t ClockAllocate(void);
+static uint32_t BcdToSeconds(const uint8_t hora[6]);
+static void SecondsToBcd(uint32_t segundos, uint8_t hora[6]);
+static uint32_t HoraEstandar(clock_t reloj);
+static uint32_t HoraLocal(clock_t reloj);
+static void FijarHoraLocal(clock_t reloj, uint32_t hora);
+static void AjustarDesfase(clock_t reloj, uint32_t hora);
+static void ActualizarHorarioVerano(clock_t reloj);
+static void ReprogramarAlarma(clock_t reloj);
+static uint32_t ProximoVencimiento(clock_t reloj, uint32_t hora);
+static bool Vencido(uint32_t ahora, uint32_t vencimiento);
+static void ProgramarVencimiento(uint32_t vencimiento);
+static uint32_t VencimientosDiarios(uint32_t * vencimiento, uint32_t ahora);
+static uint32_t VencimientosHabilitados(clock_t reloj, uint32_t ultimo, uint32_t cantidad);
+static void AlarmaCheck(clock_t reloj);
+static uint32_t AlarmaAdvance(clock_t reloj);
+static void RevisarVencimientos(void);
+static void ContarTic(void);
+static void FinPostergacion(clock_t reloj, void * objeto);
+static void RuedaInsertar(uint16_t indice);
+static void RuedaQuitar(uint16_t indice);
+static void RuedaCalcularProximo(void);
+static void RuedaAvanzar(uint32_t hasta);
+
 /* === Public variable definitions ============================================================= */
 
 /* === Private variable definitions ============================================================ */
 
+static struct base_tiempo_s base = {0};
+
+static struct clock_s instances[CLOCK_INSTANCES] = {0};
+
+static struct clock_event_s eventos[CLOCK_EVENTS];
+
+static struct rueda_s rueda;
+
 /* === Private function implementation ========================================================= */
 
-/* === Public function implementation ========================================================== */
+static clock_t ClockAllocate(void) {
+    clock_t reloj = NULL;
 
-struct clock_s {
-    uint8_t hora_actual[6];
-    bool valida;
-    uint8_t tics_por_segundo;
-    uint8_t tics;
-    uint8_t hora_alarma_fijada[6];
-    alarm_notification_t EnableAlarm;
-    bool activate_alarm;
-    uint16_t segundos_pospuestos;
-    bool alarma_pospuesta;
-};
+    for (int i = 0; i < CLOCK_INSTANCES; i++) {
 
-clock_t ClockCreate(int tics_por_segundo, alarm_notification_t EnableAlarm) {
-    static struct clock_s self[1];
+        if (!instances[i].allocated) {
 
-    memset(self, 0, sizeof(self));
-    self->tics_por_segundo = tics_por_segundo;
-    self->tics = tics_por_segundo;
-    self->EnableAlarm = EnableAlarm;
-    return self;
+            instances[i].allocated = true;
+            reloj = &instances[i];
+            break;
+        }
+    }
+    return reloj;
 }
 
-bool ClockGetTime(clock_t reloj, uint8_t * hora, int size) {
-    memcpy(hora, reloj->hora_actual, size);
-    return reloj->valida;
+static uint32_t BcdToSeconds(const uint8_t hora[6]) {
+    uint32_t horas = 10 * hora[HOURS_TENS] + hora[HOURS_UNITS];
+    uint32_t minutos = 10 * hora[MINUTES_TENS] + hora[MINUTES_UNITS];
+    uint32_t segundos = 10 * hora[SECONDS_TENS] + hora[SECONDS_UNITS];
+
+    return ((horas * 60 + minutos) * 60 + segundos) % SEGUNDOS_POR_DIA;
 }
 
-bool ClockSetTime(clock_t reloj, const uint8_t * hora, int size) {
-    memcpy(reloj->hora_actual, hora, size);
-    reloj->valida = true;
-    return true;
+static void SecondsToBcd(uint32_t segundos, uint8_t hora[6]) {
+    uint32_t horas = segundos / 3600;
+    uint32_t minutos = (segundos / 60) % 60;
+
+    segundos = segundos % 60;
+    hora[HOURS_TENS] = horas / 10;
+    hora[HOURS_UNITS] = horas % 10;
+    hora[MINUTES_TENS] = minutos / 10;
+    hora[MINUTES_UNITS] = minutos % 10;
+    hora[SECONDS_TENS] = segundos / 10;
+    hora[SECONDS_UNITS] = segundos % 10;
 }
 
-void Increment(clock_t reloj) {
-    reloj->hora_actual[SECONDS_UNITS]++;
+// Hora estandar en segundos desde el 1 de enero de 2000, sin horario de verano
+static uint32_t HoraEstandar(clock_t reloj) {
+    return base.segundos + reloj->referencia->desfase + reloj->desplazamiento;
+}
 
-    if (reloj->hora_actual[SECONDS_UNITS] >= 10) {
-        reloj->hora_actual[SECONDS_UNITS] = 0;
-        reloj->hora_actual[SECONDS_TENS]++;
+// Hora local en segundos desde el 1 de enero de 2000, incluido el horario de verano
+static uint32_t HoraLocal(clock_t reloj) {
+    return HoraEstandar(reloj) + reloj->horario_verano;
+}
 
-        if (reloj->hora_actual[SECONDS_TENS] >= 6) {
-            reloj->hora_actual[SECONDS_TENS] = 0;
-            reloj->hora_actual[MINUTES_UNITS]++;
+static void FijarHoraLocal(clock_t reloj, uint32_t hora) {
+    // El horario de verano depende de la hora estandar, que a su vez depende del horario de verano
+    AjustarDesfase(reloj, hora);
+    ActualizarHorarioVerano(reloj);
+    AjustarDesfase(reloj, hora);
+    ActualizarHorarioVerano(reloj);
+
+    // Los relojes que siguen a este cambian su hora junto con el
+    for (int i = 0; i < CLOCK_INSTANCES; i++) {
+        if (instances[i].allocated && (instances[i].referencia == reloj) && (&instances[i] != reloj)) {
+            ActualizarHorarioVerano(&instances[i]);
+            ReprogramarAlarma(&instances[i]);
+        }
+    }
+    ReprogramarAlarma(reloj);
+}
+
+// Un reloj que sigue a otro solo ajusta su desplazamiento, sin mover la hora de su referencia
+static void AjustarDesfase(clock_t reloj, uint32_t hora) {
+    if (reloj->referencia == reloj) {
+        reloj->desfase = hora - base.segundos - reloj->horario_verano;
+    } else {
+        reloj->desplazamiento = hora - base.segundos - reloj->referencia->desfase - reloj->horario_verano;
+    }
+}
+
+static void ActualizarHorarioVerano(clock_t reloj) {
+    uint32_t estandar = HoraEstandar(reloj);
+    uint32_t faltan;
 
-            if (reloj->hora_actual[MINUTES_UNITS] >= 10) {
-                reloj->hora_actual[MINUTES_UNITS] = 0;
-                reloj->hora_actual[MINUTES_TENS]++;
+    reloj->horario_verano = CalendarDstOffset(reloj->regla_dst, DIAS_EPOCA + estandar / SEGUNDOS_POR_DIA,
+                                              estandar % SEGUNDOS_POR_DIA, &faltan);
+    reloj->vencimiento_dst = base.segundos + faltan;
+    if (reloj->regla_dst != DST_NINGUNO) {
+        ProgramarVencimiento(reloj->vencimiento_dst);
+    }
+}
 
-                if (reloj->hora_actual[MINUTES_TENS] >= 6) {
-                    reloj->hora_actual[MINUTES_TENS] = 0;
-                    reloj->hora_actual[HOURS_UNITS]++;
+static void ReprogramarAlarma(clock_t reloj) {
+    reloj->vencimiento_alarma = ProximoVencimiento(reloj, reloj->hora_alarma);
+    ProgramarVencimiento(reloj->vencimiento_alarma);
+}
 
-                    if (reloj->hora_actual[HOURS_UNITS] >= 10) {
-                        reloj->hora_actual[HOURS_UNITS] = 0;
-                        reloj->hora_actual[HOURS_TENS]++;
+// Devuelve el primer segundo de la base de tiempo posterior al actual en que el reloj marca la hora indicada
+static uint32_t ProximoVencimiento(clock_t reloj, uint32_t hora) {
+    uint32_t actual = HoraLocal(reloj) % SEGUNDOS_POR_DIA;
+    uint32_t faltan = (hora + SEGUNDOS_POR_DIA - actual) % SEGUNDOS_POR_DIA;
 
-                        if (reloj->hora_actual[HOURS_TENS] >= 2 && reloj->hora_actual[HOURS_UNITS] >= 4) {
-                            reloj->hora_actual[HOURS_TENS] = 0;
-                            reloj->hora_actual[HOURS_UNITS] = 0;
-                        }
-                    }
-                }
+    if (faltan == 0) {
+        faltan = SEGUNDOS_POR_DIA;
+    }
+    return base.segundos + faltan;
+}
+
+// Compara contra el contador de segundos tolerando el desborde de 32 bits
+static bool Vencido(uint32_t ahora, uint32_t vencimiento) {
+    return (int32_t)(ahora - vencimiento) >= 0;
+}
+
+// Adelanta el proximo vencimiento de la base de tiempo si el nuevo plazo es anterior
+static void ProgramarVencimiento(uint32_t vencimiento) {
+    if ((int32_t)(vencimiento - base.vencimiento) < 0) {
+        base.vencimiento = vencimiento;
+    }
+}
+
+// Cuenta los vencimientos diarios alcanzados hasta ahora y reprograma el siguiente, en tiempo constante
+static uint32_t VencimientosDiarios(uint32_t * vencimiento, uint32_t ahora) {
+    uint32_t cantidad = 0;
+
+    if (Vencido(ahora, *vencimiento)) {
+        cantidad = (ahora - *vencimiento) / SEGUNDOS_POR_DIA + 1;
+        *vencimiento += cantidad * SEGUNDOS_POR_DIA;
+    }
+    return cantidad;
+}
+
+// Cuenta cuantos de los ultimos vencimientos diarios cayeron en dias habilitados para la alarma
+static uint32_t VencimientosHabilitados(clock_t reloj, uint32_t ultimo, uint32_t cantidad) {
+    uint32_t dia = (HoraLocal(reloj) - (base.segundos - ultimo)) / SEGUNDOS_POR_DIA + DIAS_EPOCA;
+    uint32_t habilitados = (cantidad / 7) * __builtin_popcount(reloj->dias_alarma);
+
+    for (uint32_t resto = cantidad % 7; resto > 0; resto--, dia--) {
+        habilitados += (reloj->dias_alarma >> CalendarWeekday(dia)) & 1;
+    }
+    return habilitados;
+}
+
+static void AlarmaCheck(clock_t reloj) {
+    bool sonar = false;
+
+    if ((reloj->regla_dst != DST_NINGUNO) && Vencido(base.segundos, reloj->vencimiento_dst)) {
+        ActualizarHorarioVerano(reloj);
+        reloj->vencimiento_alarma = ProximoVencimiento(reloj, reloj->hora_alarma);
+    }
+
+    if (reloj->pospuesta) {
+        // La alarma diaria no suena mientras esta pospuesta
+        VencimientosDiarios(&reloj->vencimiento_alarma, base.segundos);
+    } else if (VencimientosDiarios(&reloj->vencimiento_alarma, base.segundos)) {
+        sonar = reloj->activate_alarm && VencimientosHabilitados(reloj, base.segundos, 1);
+    }
+    if (reloj->sonar_pospuesta) {
+        reloj->sonar_pospuesta = false;
+        sonar = true;
+    }
+    if (sonar) {
+        reloj->EnableAlarm(true);
+    }
+}
+
+static uint32_t AlarmaAdvance(clock_t reloj) {
+    uint32_t ahora = base.segundos;
+    uint32_t perdidas = 0;
+    uint32_t vencidas;
+    bool sonar = false;
+
+    if (reloj->pospuesta) {
+        VencimientosDiarios(&reloj->vencimiento_alarma, ahora);
+    }
+    if (reloj->sonar_pospuesta) {
+        reloj->sonar_pospuesta = false;
+        sonar = true;
+    }
+
+    vencidas = VencimientosDiarios(&reloj->vencimiento_alarma, ahora);
+    if (vencidas && reloj->activate_alarm) {
+        uint32_t ultima = reloj->vencimiento_alarma - SEGUNDOS_POR_DIA;
+        uint32_t habilitadas = VencimientosHabilitados(reloj, ultima, vencidas);
+
+        sonar = sonar || (habilitadas > 0);
+        // Solo el vencimiento que coincide con el ultimo segundo avanzado se atiende a tiempo
+        perdidas += habilitadas - ((ultima == ahora) && VencimientosHabilitados(reloj, ultima, 1));
+    }
+
+    if ((reloj->regla_dst != DST_NINGUNO) && Vencido(ahora, reloj->vencimiento_dst)) {
+        ActualizarHorarioVerano(reloj);
+        reloj->vencimiento_alarma = ProximoVencimiento(reloj, reloj->hora_alarma);
+    }
+    if (sonar) {
+        reloj->EnableAlarm(true);
+    }
+    return perdidas;
+}
+
+// Recalcula el primer plazo pendiente entre todos los relojes y la rueda de eventos
+static void RevisarVencimientos(void) {
+    base.vencimiento = base.segundos + SEGUNDOS_POR_DIA;
+    if (rueda.pendientes) {
+        ProgramarVencimiento(rueda.proximo);
+    }
+
+    for (int i = 0; i < CLOCK_INSTANCES; i++) {
+        clock_t reloj = &instances[i];
+
+        if (reloj->allocated) {
+            ProgramarVencimiento(reloj->vencimiento_alarma);
+            if (reloj->regla_dst != DST_NINGUNO) {
+                ProgramarVencimiento(reloj->vencimiento_dst);
+            }
+        }
+    }
+}
+
+// Reanuda la alarma al vencer la postergacion, descartando los vencimientos diarios que ocurrieron mientras tanto
+static void FinPostergacion(clock_t reloj, void * objeto) {
+    VencimientosDiarios(&reloj->vencimiento_alarma, rueda.actual);
+    reloj->pospuesta = NULL;
+    reloj->sonar_pospuesta = reloj->activate_alarm;
+}
+
+// Ubica el evento en el nivel mas bajo cuyas ranuras distinguen su vencimiento del segundo actual de la rueda
+static void RuedaInsertar(uint16_t indice) {
+    struct clock_event_s * evento = &eventos[indice];
+    uint32_t vencimiento = evento->vencimiento;
+    uint32_t diferencia = vencimiento ^ rueda.actual;
+    uint32_t nivel = 0;
+    uint32_t ranura;
+
+    while ((nivel < RUEDA_NIVELES - 1) && (diferencia >> (RUEDA_BITS * (nivel + 1)))) {
+        nivel++;
+    }
+    if ((vencimiento - rueda.actual) >> (RUEDA_BITS * RUEDA_NIVELES)) {
+        // Los eventos mas alla del alcance de la rueda esperan en la ultima ranura de la vuelta del ultimo nivel
+        ranura = ((rueda.actual >> (RUEDA_BITS * nivel)) - 1) & (RUEDA_RANURAS - 1);
+    } else {
+        ranura = (vencimiento >> (RUEDA_BITS * nivel)) & (RUEDA_RANURAS - 1);
+    }
+
+    evento->ranura = nivel * RUEDA_RANURAS + ranura;
+    evento->anterior = NINGUNO;
+    evento->siguiente = rueda.ranuras[evento->ranura];
+    if (evento->siguiente != NINGUNO) {
+        eventos[evento->siguiente].anterior = indice;
+    }
+    rueda.ranuras[evento->ranura] = indice;
+    rueda.ocupadas[nivel] |= (uint64_t)1 << ranura;
+}
+
+static void RuedaQuitar(uint16_t indice) {
+    struct clock_event_s * evento = &eventos[indice];
+
+    if (evento->anterior != NINGUNO) {
+        eventos[evento->anterior].siguiente = evento->siguiente;
+    } else {
+        rueda.ranuras[evento->ranura] = evento->siguiente;
+        if (evento->siguiente == NINGUNO) {
+            rueda.ocupadas[evento->ranura / RUEDA_RANURAS] &= ~((uint64_t)1 << (evento->ranura % RUEDA_RANURAS));
+        }
+    }
+    if (evento->siguiente != NINGUNO) {
+        eventos[evento->siguiente].anterior = evento->anterior;
+    }
+}
+
+// Busca en cada nivel la primera ranura ocupada posterior a la actual, sin recorrer las ranuras vacias
+static void RuedaCalcularProximo(void) {
+    uint32_t proximo = rueda.actual;
+    uint32_t distancia = 0;
+
+    for (uint32_t nivel = 0; nivel < RUEDA_NIVELES; nivel++) {
+        uint32_t desplazamiento = RUEDA_BITS * nivel;
+        uint32_t indice = (rueda.actual >> desplazamiento) & (RUEDA_RANURAS - 1);
+        uint64_t ocupadas = rueda.ocupadas[nivel];
+
+        if (ocupadas) {
+            uint32_t giro = (indice + 1) & (RUEDA_RANURAS - 1);
+            uint64_t rotadas = (ocupadas >> giro) | (giro ? (ocupadas << (RUEDA_RANURAS - giro)) : 0);
+            uint32_t pasos = __builtin_ctzll(rotadas) + 1;
+            uint32_t bloque = rueda.actual & ~((1u << (desplazamiento + RUEDA_BITS)) - 1);
+            uint32_t tiempo = bloque + ((indice + pasos) << desplazamiento);
+
+            if ((distancia == 0) || ((tiempo - rueda.actual) < distancia)) {
+                distancia = tiempo - rueda.actual;
+                proximo = tiempo;
             }
         }
     }
+    rueda.proximo = proximo;
 }
 
-void AlarmaCheck(clock_t reloj) {
+// Avanza la rueda hasta el segundo indicado saltando directamente de un segundo con trabajo al siguiente
+static void RuedaAvanzar(uint32_t hasta) {
+    struct clock_event_s * evento;
+    uint32_t ranura;
+
+    rueda.avanzando = true;
+    while (rueda.pendientes && Vencido(hasta, rueda.proximo)) {
+        rueda.actual = rueda.proximo;
+
+        // Al comenzar un bloque de un nivel superior sus eventos bajan a los niveles inferiores
+        for (uint32_t nivel = RUEDA_NIVELES - 1; nivel > 0; nivel--) {
+            if ((rueda.actual & ((1u << (RUEDA_BITS * nivel)) - 1)) == 0) {
+                ranura = nivel * RUEDA_RANURAS + ((rueda.actual >> (RUEDA_BITS * nivel)) & (RUEDA_RANURAS - 1));
+                while (rueda.ranuras[ranura] != NINGUNO) {
+                    uint16_t indice = rueda.ranuras[ranura];
 
-    if (reloj->activate_alarm) {
-        if (reloj->alarma_pospuesta) {
-            if (reloj->segundos_pospuestos == 0) {
-                reloj->EnableAlarm(true);
-                reloj->alarma_pospuesta = 0;
+                    RuedaQuitar(indice);
+                    RuedaInsertar(indice);
+                }
             }
+        }
+
+        ranura = rueda.actual & (RUEDA_RANURAS - 1);
+        while (rueda.ranuras[ranura] != NINGUNO) {
+            uint16_t indice = rueda.ranuras[ranura];
+
+            evento = &eventos[indice];
+            RuedaQuitar(indice);
+            evento->ranura = NINGUNO;
+            evento->siguiente = rueda.libres;
+            rueda.libres = indice;
+            rueda.pendientes--;
+            rueda.demorados += (rueda.actual != hasta);
+            evento->handler(evento->reloj, evento->objeto);
+        }
+        RuedaCalcularProximo();
+    }
+    rueda.actual = hasta;
+    rueda.avanzando = false;
+}
 
-        } else {
-            if (memcmp(reloj->hora_actual, reloj->hora_alarma_fijada, sizeof(reloj->hora_actual)) == 0) {
-                reloj->EnableAlarm(true);
+static void ContarTic(void) {
+    base.tics--;
+
+    if (base.tics == 0) {
+        base.tics = base.tics_por_segundo;
+        base.segundos++;
+        // Mientras ningun plazo vence el segundo nuevo no requiere trabajo en ninguno de los relojes
+        if (Vencido(base.segundos, base.vencimiento)) {
+            RuedaAvanzar(base.segundos);
+            for (int i = 0; i < CLOCK_INSTANCES; i++) {
+                if (instances[i].allocated) {
+                    AlarmaCheck(&instances[i]);
+                }
             }
+            RevisarVencimientos();
         }
     }
 }
 
+/* === Public function implementation ========================================================== */
+
+clock_t ClockCreate(int tics_por_segundo, alarm_notification_t EnableAlarm) {
+    clock_t self;
+
+    if (base.tics_por_segundo == 0) {
+        base.tics_por_segundo = tics_por_segundo;
+        base.tics = tics_por_segundo;
+        base.vencimiento = base.segundos + SEGUNDOS_POR_DIA;
+        rueda.actual = base.segundos;
+        memset(rueda.ranuras, 0xFF, sizeof(rueda.ranuras));
+        for (uint16_t indice = 0; indice < CLOCK_EVENTS; indice++) {
+            eventos[indice].ranura = NINGUNO;
+            eventos[indice].siguiente = indice + 1;
+        }
+        eventos[CLOCK_EVENTS - 1].siguiente = NINGUNO;
+    } else if (base.tics_por_segundo != tics_por_segundo) {
+        return NULL;
+    }
+
+    self = ClockAllocate();
+    if (self) {
+        memset(self, 0, sizeof(*self));
+        self->allocated = true;
+        self->referencia = self;
+        self->desfase = -base.segundos;
+        self->EnableAlarm = EnableAlarm;
+        self->dias_alarma = TODOS_LOS_DIAS;
+        ReprogramarAlarma(self);
+    }
+    return self;
+}
+
+// Los eventos del reloj se buscan en toda la reserva porque la rueda no los agrupa por reloj
+void ClockDestroy(clock_t reloj) {
+    for (uint16_t indice = 0; indice < CLOCK_EVENTS; indice++) {
+        if ((eventos[indice].ranura != NINGUNO) && (eventos[indice].reloj == reloj)) {
+            ClockCancelEvent(&eventos[indice]);
+        }
+    }
+
+    for (int i = 0; i < CLOCK_INSTANCES; i++) {
+        clock_t seguidor = &instances[i];
+
+        // Los relojes que seguian a este conservan su hora, que pasa a ser propia
+        if (seguidor->allocated && (seguidor != reloj) && (seguidor->referencia == reloj)) {
+            seguidor->referencia = seguidor;
+            seguidor->desfase = reloj->desfase + seguidor->desplazamiento;
+            seguidor->desplazamiento = 0;
+            seguidor->valida = seguidor->valida || reloj->valida;
+        }
+    }
+    reloj->allocated = false;
+}
+
+void ClockSetZone(clock_t reloj, clock_t referencia, int32_t desplazamiento) {
+    if (referencia->referencia == reloj) {
+        reloj->desfase += referencia->desplazamiento + desplazamiento;
+    } else {
+        reloj->referencia = referencia->referencia;
+        reloj->desplazamiento = referencia->desplazamiento + desplazamiento;
+    }
+    reloj->valida = referencia->valida;
+
+    for (int i = 0; i < CLOCK_INSTANCES; i++) {
+        clock_t seguidor = &instances[i];
+
+        // Los relojes que seguian a este pasan a seguir a su nueva referencia sin cambiar su hora
+        if (seguidor->allocated && (seguidor != reloj) && (seguidor->referencia == reloj)) {
+            seguidor->referencia = reloj->referencia;
+            seguidor->desplazamiento += reloj->desplazamiento;
+        }
+        if (seguidor->allocated && (seguidor->referencia->referencia == reloj)) {
+            ActualizarHorarioVerano(seguidor);
+            ReprogramarAlarma(seguidor);
+        }
+    }
+}
+
+bool ClockGetTime(clock_t reloj, uint8_t * hora, int size) {
+    uint8_t actual[6];
+
+    SecondsToBcd(HoraLocal(reloj) % SEGUNDOS_POR_DIA, actual);
+    memcpy(hora, actual, size);
+    return reloj->valida || reloj->referencia->valida;
+}
+
+bool ClockSetTime(clock_t reloj, const uint8_t * hora, int size) {
+    uint8_t nueva[6];
+    uint32_t dia = HoraLocal(reloj) / SEGUNDOS_POR_DIA;
+
+    ClockGetTime(reloj, nueva, sizeof(nueva));
+    memcpy(nueva, hora, size);
+    FijarHoraLocal(reloj, dia * SEGUNDOS_POR_DIA + BcdToSeconds(nueva));
+    reloj->valida = true;
+    return true;
+}
+
+bool ClockGetDate(clock_t reloj, fecha_t * fecha) {
+    CalendarCivilFromDays(DIAS_EPOCA + HoraLocal(reloj) / SEGUNDOS_POR_DIA, fecha);
+    return reloj->valida || reloj->referencia->valida;
+}
+
+bool ClockSetDate(clock_t reloj, const fecha_t * fecha) {
+    int32_t dia;
+
+    if (!CalendarIsValid(fecha) || (fecha->anio < 2000) || (fecha->anio > 2135)) {
+        return false;
+    }
+    dia = CalendarDaysFromCivil(fecha->anio, fecha->mes, fecha->dia) - DIAS_EPOCA;
+    FijarHoraLocal(reloj, dia * SEGUNDOS_POR_DIA + HoraLocal(reloj) % SEGUNDOS_POR_DIA);
+    return true;
+}
+
+uint8_t ClockGetWeekday(clock_t reloj) {
+    return CalendarWeekday(DIAS_EPOCA + HoraLocal(reloj) / SEGUNDOS_POR_DIA);
+}
+
+void ClockSetDst(clock_t reloj, dst_regla_t regla) {
+    uint32_t hora = HoraLocal(reloj);
+
+    reloj->regla_dst = regla;
+    reloj->horario_verano = 0;
+    FijarHoraLocal(reloj, hora);
+}
+
 void ActivateAlarm(clock_t reloj, bool status) {
     reloj->activate_alarm = status;
 }
 
 bool ClockUpdate(clock_t reloj) {
-    reloj->tics--;
-
-    if (reloj->tics == 0) {
-        Increment(reloj);
-        reloj->tics = reloj->tics_por_segundo;
-        reloj->segundos_pospuestos--;
-        AlarmaCheck(reloj);
-        if (reloj->hora_actual[0] == 2 && reloj->hora_actual[1] == 4) {
-            reloj->hora_actual[0] = 0;
-            reloj->hora_actual[1] = 0;
+    uint32_t anterior = base.fraccion;
+
+    // El acumulador de fase cuenta un tic extra o saltea uno cada vez que la correccion completa un tic entero
+    base.fraccion += base.correccion;
+    if ((base.correccion >= 0) || (base.fraccion < anterior)) {
+        ContarTic();
+        if ((base.correccion > 0) && (base.fraccion < anterior)) {
+            ContarTic();
         }
     }
-    if (reloj->tics < (reloj->tics_por_segundo / 2)) {
+
+    if (base.tics < (base.tics_por_segundo / 2)) {
         return true;
     } else {
         return false;
     }
 }
+uint32_t ClockAdvance(clock_t reloj, uint32_t tics) {
+    int64_t acumulado = (int64_t)base.correccion * tics + base.fraccion;
+    uint64_t corregidos = tics + (acumulado >> 32);
+    uint32_t transcurridos = (base.tics_por_segundo - base.tics) + (corregidos % base.tics_por_segundo);
+    uint32_t segundos = corregidos / base.tics_por_segundo + transcurridos / base.tics_por_segundo;
+    uint32_t perdidas = 0;
+
+    base.fraccion = (uint32_t)acumulado;
+    base.tics = base.tics_por_segundo - (transcurridos % base.tics_por_segundo);
+    if (segundos == 0) {
+        return 0;
+    }
+
+    base.segundos += segundos;
+    rueda.demorados = 0;
+    RuedaAvanzar(base.segundos);
+    perdidas = rueda.demorados;
+    for (int i = 0; i < CLOCK_INSTANCES; i++) {
+        if (instances[i].allocated) {
+            perdidas += AlarmaAdvance(&instances[i]);
+        }
+    }
+    RevisarVencimientos();
+    return perdidas;
+}
+
+uint32_t ClockTicsToHalfSecond(clock_t reloj) {
+    uint32_t mitad = base.tics_por_segundo / 2;
+
+    // ClockUpdate informa la segunda mitad cuando quedan menos de la mitad de los tics del segundo
+    if (base.tics >= mitad) {
+        return base.tics - mitad + 1;
+    } else {
+        return base.tics;
+    }
+}
+
+void ClockSetRate(clock_t reloj, int32_t correccion) {
+    base.correccion = ((int64_t)correccion << 32) / 1000000000;
+}
+
+uint32_t ClockGetStamp(clock_t reloj, uint32_t * fraccion) {
+    uint64_t transcurrido = ((uint64_t)(base.tics_por_segundo - base.tics) << 32) + base.fraccion;
+
+    *fraccion = transcurrido / base.tics_por_segundo;
+    return HoraEstandar(reloj);
+}
+
+void ClockStep(clock_t reloj, int64_t ajuste) {
+    uint32_t tics = ((ajuste & 0xFFFFFFFF) * base.tics_por_segundo) >> 32;
+    uint32_t transcurridos = (base.tics_por_segundo - base.tics) + tics;
+    int32_t segundos = (int32_t)(ajuste >> 32) + transcurridos / base.tics_por_segundo;
+
+    // La fraccion de segundo mueve la fase de los tics, los segundos enteros solo cambian la hora mostrada
+    base.tics = base.tics_por_segundo - (transcurridos % base.tics_por_segundo);
+    FijarHoraLocal(reloj, HoraLocal(reloj) + segundos);
+    reloj->valida = true;
+}
 
 void AlarmGetTime(clock_t reloj, uint8_t * hora, int size) {
-    memcpy(hora, reloj->hora_alarma_fijada, size);
+    uint8_t alarma[6];
+
+    SecondsToBcd(reloj->hora_alarma, alarma);
+    memcpy(hora, alarma, size);
 }
 
 void AlarmSetTime(clock_t reloj, const uint8_t * hora, int size) {
-    memcpy(reloj->hora_alarma_fijada, hora, size);
+    uint8_t nueva[6];
+
+    AlarmGetTime(reloj, nueva, sizeof(nueva));
+    memcpy(nueva, hora, size);
+    reloj->hora_alarma = BcdToSeconds(nueva);
+    ReprogramarAlarma(reloj);
+}
+
+void AlarmSetWeekdays(clock_t reloj, uint8_t dias) {
+    reloj->dias_alarma = dias & TODOS_LOS_DIAS;
 }
 
 void ExtendAlarm(clock_t reloj, int minutos) {
-    reloj->segundos_pospuestos = minutos * 60;
+    if (reloj->pospuesta) {
+        ClockCancelEvent(reloj->pospuesta);
+    }
+    reloj->pospuesta = ClockScheduleEvent(reloj, minutos * 60, FinPostergacion, NULL);
     reloj->EnableAlarm(false);
-    reloj->alarma_pospuesta = 1;
+}
+
+clock_event_t ClockScheduleEvent(clock_t reloj, uint32_t segundos, clock_event_handler_t handler, void * objeto) {
+    clock_event_t evento = NULL;
+    uint16_t indice = rueda.libres;
+
+    if (indice != NINGUNO) {
+        evento = &eventos[indice];
+        rueda.libres = evento->siguiente;
+        // Durante un avance la rueda todavia recorre segundos anteriores, mover su posicion ubicaria el evento
+        // en la ranura que se esta vaciando y venceria en el momento
+        if ((rueda.pendientes == 0) && !rueda.avanzando) {
+            rueda.actual = base.segundos;
+        }
+        // El segundo actual ya fue procesado, el vencimiento mas cercano posible es el siguiente
+        evento->vencimiento = base.segundos + (segundos ? segundos : 1);
+        evento->reloj = reloj;
+        evento->handler = handler;
+        evento->objeto = objeto;
+        RuedaInsertar(indice);
+        rueda.pendientes++;
+        RuedaCalcularProximo();
+        ProgramarVencimiento(rueda.proximo);
+    }
+    return evento;
+}
+
+void ClockCancelEvent(clock_event_t evento) {
+    uint16_t indice = evento - eventos;
+
+    if (evento->ranura != NINGUNO) {
+        RuedaQuitar(indice);
+        evento->ranura = NINGUNO;
+        evento->siguiente = rueda.libres;
+        rueda.libres = indice;
+        rueda.pendientes--;
+    }
 }
 
 void DisableAlarm(clock_t reloj) {
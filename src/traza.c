@@ -0,0 +1,234 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Grabacion de las entradas y la pantalla
+ **
+ ** Guarda el ultimo estado grabado de las entradas y de la pantalla para escribir solo los cambios.
+ ** Cada registro se arma completo en la pila y se entrega con una sola llamada a la funcion de
+ ** escritura, de modo que un corte deja a lo sumo un registro incompleto al final.
+ **
+ ** \addtogroup traza Traza
+ ** \brief Grabacion de las entradas y la pantalla
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "traza.h"
+#include <stddef.h>
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+#ifndef TRACE_INSTANCES
+#define TRACE_INSTANCES 1
+#endif
+
+//! Bits del encabezado de cada registro que indican el tipo
+#define BITS_TIPO 2
+
+//! Cantidad maxima de bytes de un numero de 64 bits codificado
+#define LARGO_NUMERO 10
+
+/* === Private data type declarations ========================================================== */
+
+struct traza_s {
+    bool allocated;                     //!< Bandera que indica si el descriptor esta en uso
+    bool grabadas;                      //!< Bandera que indica si ya se grabaron las entradas
+    bool mostrada;                      //!< Bandera que indica si ya se grabo la pantalla
+    uint8_t digitos;                    //!< Cantidad de digitos de la pantalla
+    uint8_t entradas;                   //!< Ultimo estado grabado de las entradas
+    uint8_t pantalla[TRACE_MAX_DIGITS]; //!< Ultima imagen grabada de la pantalla
+    uint64_t tic;                       //!< Tic actual
+    uint64_t anterior;                  //!< Tic del ultimo registro grabado
+    traza_escribir_t escribir;          //!< Funcion que recibe los bytes de cada registro
+    void * objeto;                      //!< Puntero que se pasa a la funcion de escritura
+};
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static traza_t TraceAllocate(void);
+static uint8_t CodificarNumero(uint8_t * datos, uint64_t valor);
+static bool DecodificarNumero(traza_lector_t lector, uint64_t * valor);
+static void Grabar(traza_t traza, traza_tipo_t tipo, const uint8_t * datos, uint8_t cantidad);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static struct traza_s instances[TRACE_INSTANCES] = {0};
+
+/* === Private function implementation ========================================================= */
+
+static traza_t TraceAllocate(void) {
+    traza_t traza = NULL;
+
+    for (int i = 0; i < TRACE_INSTANCES; i++) {
+
+        if (!instances[i].allocated) {
+
+            instances[i].allocated = true;
+            traza = &instances[i];
+            break;
+        }
+    }
+    return traza;
+}
+
+static uint8_t CodificarNumero(uint8_t * datos, uint64_t valor) {
+    uint8_t cantidad = 0;
+
+    while (valor > 0x7F) {
+        datos[cantidad++] = (uint8_t)(valor | 0x80);
+        valor >>= 7;
+    }
+    datos[cantidad++] = (uint8_t)valor;
+    return cantidad;
+}
+
+static bool DecodificarNumero(traza_lector_t lector, uint64_t * valor) {
+    uint8_t byte;
+
+    *valor = 0;
+    for (uint8_t desplazamiento = 0; desplazamiento < 7 * LARGO_NUMERO; desplazamiento += 7) {
+        if (lector->posicion >= lector->tamano) {
+            return false;
+        }
+        byte = lector->datos[lector->posicion++];
+        *valor |= (uint64_t)(byte & 0x7F) << desplazamiento;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void Grabar(traza_t traza, traza_tipo_t tipo, const uint8_t * datos, uint8_t cantidad) {
+    uint8_t registro[LARGO_NUMERO + TRACE_MAX_DIGITS];
+    uint8_t largo;
+
+    largo = CodificarNumero(registro, ((traza->tic - traza->anterior) << BITS_TIPO) | tipo);
+    memcpy(&registro[largo], datos, cantidad);
+    traza->anterior = traza->tic;
+    traza->escribir(traza->objeto, registro, largo + cantidad);
+}
+
+/* === Public function implementation ========================================================== */
+
+traza_t TraceCreate(uint8_t digitos, traza_escribir_t escribir, void * objeto) {
+    uint8_t inicio[] = {TRACE_VERSION, digitos};
+    traza_t traza;
+
+    if ((digitos == 0) || (digitos > TRACE_MAX_DIGITS) || (escribir == NULL)) {
+        return NULL;
+    }
+    traza = TraceAllocate();
+    if (traza) {
+        traza->grabadas = false;
+        traza->mostrada = false;
+        traza->digitos = digitos;
+        traza->tic = 0;
+        traza->anterior = 0;
+        traza->escribir = escribir;
+        traza->objeto = objeto;
+        Grabar(traza, TRAZA_INICIO, inicio, sizeof(inicio));
+    }
+    return traza;
+}
+
+void TraceTick(traza_t traza, uint32_t tics) {
+    traza->tic += tics;
+}
+
+void TraceInputs(traza_t traza, uint8_t entradas) {
+    if (!traza->grabadas || (entradas != traza->entradas)) {
+        traza->grabadas = true;
+        traza->entradas = entradas;
+        Grabar(traza, TRAZA_ENTRADAS, &entradas, sizeof(entradas));
+    }
+}
+
+void TraceFrame(traza_t traza, const uint8_t * pantalla) {
+    if (!traza->mostrada || (memcmp(pantalla, traza->pantalla, traza->digitos) != 0)) {
+        traza->mostrada = true;
+        memcpy(traza->pantalla, pantalla, traza->digitos);
+        Grabar(traza, TRAZA_PANTALLA, pantalla, traza->digitos);
+    }
+}
+
+void TraceClose(traza_t traza) {
+    Grabar(traza, TRAZA_FIN, NULL, 0);
+    traza->allocated = false;
+}
+
+bool TraceOpen(traza_lector_t lector, const uint8_t * datos, uint32_t tamano) {
+    struct traza_registro_s registro;
+
+    memset(lector, 0, sizeof(*lector));
+    lector->datos = datos;
+    lector->tamano = tamano;
+    if (!TraceRead(lector, &registro) || (registro.tipo != TRAZA_INICIO) || (registro.datos[0] != TRACE_VERSION)) {
+        return false;
+    }
+    lector->digitos = registro.datos[1];
+    return (lector->digitos > 0) && (lector->digitos <= TRACE_MAX_DIGITS);
+}
+
+bool TraceRead(traza_lector_t lector, traza_registro_t registro) {
+    uint32_t posicion = lector->posicion;
+    uint64_t encabezado;
+    uint8_t cantidad;
+
+    if (!DecodificarNumero(lector, &encabezado)) {
+        lector->posicion = posicion;
+        return false;
+    }
+    registro->tipo = (traza_tipo_t)(encabezado & ((1 << BITS_TIPO) - 1));
+    switch (registro->tipo) {
+    case TRAZA_ENTRADAS:
+        cantidad = 1;
+        break;
+    case TRAZA_PANTALLA:
+        cantidad = lector->digitos;
+        break;
+    case TRAZA_INICIO:
+        // El registro de inicio lleva la version y la cantidad de digitos
+        cantidad = 2;
+        break;
+    default:
+        cantidad = 0;
+        break;
+    }
+    if (lector->tamano - lector->posicion < cantidad) {
+        lector->posicion = posicion;
+        return false;
+    }
+    memcpy(registro->datos, &lector->datos[lector->posicion], cantidad);
+    lector->posicion += cantidad;
+    lector->tic += encabezado >> BITS_TIPO;
+    registro->tic = lector->tic;
+    return true;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,144 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Mediciones de rendimiento de la aplicacion
+ **
+ ** Mide el costo del tic de la aplicacion mostrando la hora y durante un ajuste, con las esperas de
+ ** pulsacion e inactividad en curso. Las esperas las temporiza la plataforma, por lo que ambos
+ ** casos deben costar lo mismo.
+ **
+ ** \addtogroup pruebas Pruebas
+ ** \brief Pruebas unitarias y mediciones de rendimiento
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "aplicacion.h"
+#include "digital_simulado.h"
+#include "prueba.h"
+#include <stddef.h>
+
+/* === Macros definitions ====================================================================== */
+
+#define TICS_POR_SEGUNDO 1000
+
+#define ITERACIONES 10000000
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static void Seccion(void);
+static bool Notificar(evento_t evento);
+static void Temporizar(espera_t espera, uint32_t milisegundos);
+static void Detener(espera_t espera);
+static void Apagar(void);
+static void Encender(uint8_t valor);
+static void MedirApplicationTick(const char * nombre);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static const struct aplicacion_plataforma_s plataforma = {
+    .Bloquear = Seccion,
+    .Liberar = Seccion,
+    .Notificar = Notificar,
+    .Temporizar = Temporizar,
+    .Detener = Detener,
+};
+
+static volatile uint32_t sumidero;
+
+/* === Private function implementation ========================================================= */
+
+static void Seccion(void) {
+}
+
+// Los eventos del tic se descartan, la medicion solo incluye el trabajo hecho en el tic
+static bool Notificar(evento_t evento) {
+    sumidero += evento->tipo;
+    return true;
+}
+
+static void Temporizar(espera_t espera, uint32_t milisegundos) {
+    sumidero += milisegundos;
+}
+
+static void Detener(espera_t espera) {
+    sumidero++;
+}
+
+static void Apagar(void) {
+}
+
+static void Encender(uint8_t valor) {
+    sumidero += valor;
+}
+
+static void MedirApplicationTick(const char * nombre) {
+    uint64_t inicio = PruebaTiempo();
+
+    for (uint32_t indice = 0; indice < ITERACIONES; indice++) {
+        ApplicationTick();
+    }
+    PruebaMedicion(nombre, ITERACIONES, PruebaTiempo() - inicio);
+}
+
+/* === Public function implementation ========================================================== */
+
+int main(void) {
+    static const struct display_driver_s driver = {
+        .ScreenTurnOff = Apagar,
+        .SegmentsTurnOn = Encender,
+        .DigitTurnOn = Encender,
+    };
+    static struct board_s placa;
+    clock_t reloj;
+
+    placa.buzzer = DigitalOutputCreate(0, 0, false);
+    placa.set_time = DigitalInputCreate(0, 0, false);
+    placa.set_alarm = DigitalInputCreate(0, 1, false);
+    placa.decrement = DigitalInputCreate(0, 2, false);
+    placa.increment = DigitalInputCreate(0, 3, false);
+    placa.accept = DigitalInputCreate(0, 4, false);
+    placa.cancel = DigitalInputCreate(0, 5, false);
+    placa.display = DisplayCreate(4, &driver);
+    placa.referencia = NULL;
+
+    reloj = ClockCreate(TICS_POR_SEGUNDO, ApplicationAlarm);
+    ClockSetTime(reloj, (uint8_t[]){1, 2, 0, 0, 0, 0}, 6);
+    ApplicationCreate(&placa, reloj, NULL, &plataforma);
+    ApplicationProcess(&(struct evento_s){.tipo = EVENTO_TECLA_PRESIONADA, .dato = TECLA_CANCEL}, 0);
+    MedirApplicationTick("application_tick");
+
+    // Una pulsacion larga que entra al ajuste deja en curso la espera de inactividad
+    ApplicationProcess(&(struct evento_s){.tipo = EVENTO_TECLA_PRESIONADA, .dato = TECLA_SET_TIME}, 0);
+    ApplicationProcess(&(struct evento_s){.tipo = EVENTO_TIEMPO_AGOTADO, .dato = ESPERA_PULSACION}, 3000);
+    MedirApplicationTick("application_tick_adjusting");
+    return 0;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,142 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Mediciones de rendimiento de las entradas y salidas digitales
+ **
+ ** Compara el costo de escribir y leer un bus de ocho terminales con las funciones de un bit y con
+ ** las de puerto de la placa posix. Cada medicion de bus informa el costo de transferir un byte
+ ** completo. Tambien mide el cambio de una salida, que solo actualiza la imagen que dibuja la placa,
+ ** con la funcion de un bit y con el acceso rapido. En la placa posix el acceso rapido llama a las
+ ** mismas funciones, la comparacion en ciclos esta en el ejemplo gpio_cycles para las placas reales.
+ **
+ ** \addtogroup pruebas Pruebas
+ ** \brief Pruebas unitarias y mediciones de rendimiento
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "prueba.h"
+#include "soc_gpio.h"
+
+/* === Macros definitions ====================================================================== */
+
+#define ITERACIONES 10000000
+
+//! Cantidad de terminales del bus
+#define BITS 8
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static void MedirCambio(void);
+static void MedirEscritura(void);
+static void MedirLectura(void);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static hal_gpio_bit_t bus[BITS];
+
+static hal_gpio_port_t puerto;
+
+static hal_gpio_mask_t mascara;
+
+static volatile uint32_t sumidero;
+
+/* === Private function implementation ========================================================= */
+
+static void MedirCambio(void) {
+    uint64_t inicio = PruebaTiempo();
+
+    for (uint32_t indice = 0; indice < ITERACIONES; indice++) {
+        GpioBitToogle(bus[0]);
+    }
+    PruebaMedicion("bit_toggle", ITERACIONES, PruebaTiempo() - inicio);
+
+    inicio = PruebaTiempo();
+    for (uint32_t indice = 0; indice < ITERACIONES; indice++) {
+        GPIO_FAST_TOGGLE(HAL_GPIO1_0);
+    }
+    PruebaMedicion("fast_toggle", ITERACIONES, PruebaTiempo() - inicio);
+}
+
+static void MedirEscritura(void) {
+    uint64_t inicio = PruebaTiempo();
+
+    for (uint32_t indice = 0; indice < ITERACIONES; indice++) {
+        for (int bit = 0; bit < BITS; bit++) {
+            GpioSetState(bus[bit], (indice >> bit) & 1);
+        }
+    }
+    PruebaMedicion("bus_write_bitwise", ITERACIONES, PruebaTiempo() - inicio);
+
+    inicio = PruebaTiempo();
+    for (uint32_t indice = 0; indice < ITERACIONES; indice++) {
+        GpioPortSetState(puerto, mascara, indice);
+    }
+    PruebaMedicion("bus_write_port", ITERACIONES, PruebaTiempo() - inicio);
+}
+
+static void MedirLectura(void) {
+    uint64_t inicio = PruebaTiempo();
+
+    for (uint32_t indice = 0; indice < ITERACIONES; indice++) {
+        uint8_t valor = 0;
+        for (int bit = 0; bit < BITS; bit++) {
+            valor |= GpioGetState(bus[bit]) << bit;
+        }
+        sumidero += valor;
+    }
+    PruebaMedicion("bus_read_bitwise", ITERACIONES, PruebaTiempo() - inicio);
+
+    inicio = PruebaTiempo();
+    for (uint32_t indice = 0; indice < ITERACIONES; indice++) {
+        sumidero += GpioPortGetState(puerto, mascara);
+    }
+    PruebaMedicion("bus_read_port", ITERACIONES, PruebaTiempo() - inicio);
+}
+
+/* === Public function implementation ========================================================== */
+
+// No se configura la direccion de los terminales para que la placa no dibuje su estado en la terminal
+int main(void) {
+    hal_gpio_bit_t terminales[BITS] = {HAL_GPIO1_0, HAL_GPIO1_1, HAL_GPIO1_2, HAL_GPIO1_3,
+                                       HAL_GPIO1_4, HAL_GPIO1_5, HAL_GPIO1_6, HAL_GPIO1_7};
+
+    puerto = GpioGetPort(terminales[0]);
+    for (int bit = 0; bit < BITS; bit++) {
+        bus[bit] = terminales[bit];
+        mascara |= GpioGetMask(terminales[bit]);
+    }
+
+    MedirCambio();
+    MedirEscritura();
+    MedirLectura();
+    return 0;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,212 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Mediciones de rendimiento del reloj despertador
+ **
+ ** Cada medicion se informa en una linea JSON con el nombre de la operacion, la cantidad de
+ ** iteraciones y el tiempo promedio por operacion en nanosegundos.
+ **
+ ** \addtogroup pruebas Pruebas
+ ** \brief Pruebas unitarias y mediciones de rendimiento
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "prueba.h"
+#include "reloj.h"
+#include <stddef.h>
+
+/* === Macros definitions ====================================================================== */
+
+//! Misma frecuencia de tics que usa la aplicacion
+#define TICS_POR_SEGUNDO 1000
+
+#define ITERACIONES 10000000
+
+#define ITERACIONES_ALARMA 100000
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static void NotificarAlarma(bool estado);
+static void EventoVencido(clock_t reloj, void * objeto);
+static void MedirClockUpdate(const char * nombre);
+static void MedirClockGetTime(void);
+static void MedirAlarmCheck(void);
+static void MedirClockAdvance(void);
+static void MedirEventos(void);
+static void MedirCalendario(void);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static clock_t reloj;
+
+static volatile uint32_t sumidero;
+
+/* === Private function implementation ========================================================= */
+
+static void NotificarAlarma(bool estado) {
+    sumidero += estado;
+}
+
+static void EventoVencido(clock_t reloj, void * objeto) {
+    sumidero++;
+}
+
+static void MedirClockUpdate(const char * nombre) {
+    uint64_t inicio = PruebaTiempo();
+
+    for (uint32_t indice = 0; indice < ITERACIONES; indice++) {
+        sumidero += ClockUpdate(reloj);
+    }
+    PruebaMedicion(nombre, ITERACIONES, PruebaTiempo() - inicio);
+}
+
+static void MedirClockGetTime(void) {
+    uint8_t hora[6];
+    uint64_t inicio = PruebaTiempo();
+
+    for (uint32_t indice = 0; indice < ITERACIONES; indice++) {
+        ClockGetTime(reloj, hora, sizeof(hora));
+        sumidero += hora[5];
+    }
+    PruebaMedicion("clock_get_time", ITERACIONES, PruebaTiempo() - inicio);
+}
+
+// Mide solo el tic que completa el minuto en que vence la alarma, descontando el costo de leer el tiempo
+static void MedirAlarmCheck(void) {
+    uint8_t hora[6] = {0, 0, 0, 0, 0, 0};
+    uint8_t alarma[4];
+    uint64_t duracion = 0;
+    uint64_t vacio = 0;
+    uint64_t inicio;
+
+    // Comienza al principio de un segundo para que el tic medido sea el que completa el minuto
+    ClockSetTime(reloj, hora, sizeof(hora));
+    ActivateAlarm(reloj, true);
+    while (hora[5] == 0) {
+        ClockUpdate(reloj);
+        ClockGetTime(reloj, hora, sizeof(hora));
+    }
+    hora[5] = 0;
+    ClockSetTime(reloj, hora, sizeof(hora));
+
+    for (uint32_t indice = 0; indice < ITERACIONES_ALARMA; indice++) {
+        ClockGetTime(reloj, hora, sizeof(hora));
+        alarma[0] = hora[0];
+        alarma[1] = hora[1];
+        alarma[2] = hora[2];
+        alarma[3] = hora[3] + 1;
+        if (alarma[3] > 9) {
+            // Evita los cambios de decena de minutos para no tener que propagar el acarreo
+            ClockSetTime(reloj, (uint8_t[]){0, 0, 0, 0, 0, 0}, 6);
+            alarma[2] = 0;
+            alarma[3] = 1;
+        }
+        AlarmSetTime(reloj, alarma, sizeof(alarma));
+        ClockAdvance(reloj, 60 * TICS_POR_SEGUNDO - 1);
+
+        inicio = PruebaTiempo();
+        sumidero += ClockUpdate(reloj);
+        duracion += PruebaTiempo() - inicio;
+
+        inicio = PruebaTiempo();
+        vacio += PruebaTiempo() - inicio;
+    }
+    ActivateAlarm(reloj, false);
+    PruebaMedicion("alarm_check", ITERACIONES_ALARMA, duracion > vacio ? duracion - vacio : 0);
+}
+
+static void MedirClockAdvance(void) {
+    uint64_t inicio = PruebaTiempo();
+
+    for (uint32_t indice = 0; indice < ITERACIONES / 10; indice++) {
+        sumidero += ClockAdvance(reloj, 86400u * TICS_POR_SEGUNDO + indice % TICS_POR_SEGUNDO);
+    }
+    PruebaMedicion("clock_advance_day", ITERACIONES / 10, PruebaTiempo() - inicio);
+}
+
+static void MedirEventos(void) {
+    clock_event_t eventos[CLOCK_EVENTS / 2];
+    uint32_t cantidad = CLOCK_EVENTS / 2;
+    uint64_t inicio;
+
+    // La mitad de la reserva queda ocupada para que las listas de la rueda no esten vacias
+    for (uint32_t indice = 0; indice < cantidad; indice++) {
+        ClockScheduleEvent(reloj, 1 + PruebaAleatorio() % 1000000, EventoVencido, NULL);
+    }
+
+    inicio = PruebaTiempo();
+    for (uint32_t indice = 0; indice < ITERACIONES / 10; indice += cantidad) {
+        for (uint32_t evento = 0; evento < cantidad; evento++) {
+            eventos[evento] = ClockScheduleEvent(reloj, 1 + PruebaAleatorio() % 1000000, EventoVencido, NULL);
+        }
+        for (uint32_t evento = 0; evento < cantidad; evento++) {
+            ClockCancelEvent(eventos[evento]);
+        }
+    }
+    PruebaMedicion("event_schedule_cancel", ITERACIONES / 10, PruebaTiempo() - inicio);
+
+    MedirClockUpdate("clock_update_with_events");
+
+    inicio = PruebaTiempo();
+    sumidero += ClockAdvance(reloj, 1000000u * TICS_POR_SEGUNDO);
+    PruebaMedicion("event_expire", cantidad, PruebaTiempo() - inicio);
+}
+
+static void MedirCalendario(void) {
+    fecha_t fecha;
+    uint64_t inicio = PruebaTiempo();
+
+    for (uint32_t indice = 0; indice < ITERACIONES; indice++) {
+        CalendarCivilFromDays(indice, &fecha);
+        sumidero += CalendarDaysFromCivil(fecha.anio, fecha.mes, fecha.dia);
+    }
+    PruebaMedicion("calendar_round_trip", ITERACIONES, PruebaTiempo() - inicio);
+}
+
+/* === Public function implementation ========================================================== */
+
+int main(void) {
+    reloj = ClockCreate(TICS_POR_SEGUNDO, NotificarAlarma);
+    ClockSetTime(reloj, (uint8_t[]){1, 2, 0, 0, 0, 0}, 6);
+
+    MedirClockUpdate("clock_update");
+    for (int indice = 1; indice < CLOCK_INSTANCES; indice++) {
+        ClockSetZone(ClockCreate(TICS_POR_SEGUNDO, NotificarAlarma), reloj, indice * 3600);
+    }
+    MedirClockUpdate("clock_update_all_instances");
+    MedirClockGetTime();
+    MedirAlarmCheck();
+    MedirClockAdvance();
+    MedirEventos();
+    MedirCalendario();
+    return 0;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,87 @@
+#!/bin/bash
+##################################################################################################
+# Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+# associated documentation files (the "Software"), to deal in the Software without restriction,
+# including without limitation the rights to use, copy, modify, merge, publish, distribute,
+# sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all copies or substantial
+# portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+# NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+# NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+# OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+# SPDX-License-Identifier: MIT
+##################################################################################################
+
+# Ejecuta la aplicacion de la placa posix con una secuencia fija de teclas y mensajes de referencia, para medir el
+# peor uso de las pilas con los informes que la placa envia por el pseudo terminal de la referencia
+#
+#   test/carga_guionada.sh [programa]   por defecto build/bin/repo.out, compilado con make all BOARD=posix
+#
+# Las teclas se escriben en la entrada del programa, donde cada caracter alterna una entrada, y los informes recibidos
+# se muestran al terminar
+
+programa=${1:-build/bin/repo.out}
+temporal=$(mktemp -d)
+trap 'rm -rf "$temporal"' EXIT
+
+mkfifo "$temporal/teclas"
+"$programa" < "$temporal/teclas" > /dev/null 2> "$temporal/errores" &
+aplicacion=$!
+exec 3> "$temporal/teclas"
+
+for intento in $(seq 50); do
+    grep -q "SCI 0" "$temporal/errores" && break
+    sleep 0.1
+done
+terminal=$(awk '/SCI 0/ {print $3}' "$temporal/errores")
+if [ -z "$terminal" ]; then
+    echo "La aplicacion no informo el pseudo terminal de la referencia" >&2
+    kill $aplicacion
+    exit 1
+fi
+stty -F "$terminal" raw -echo
+cat "$terminal" > "$temporal/informes" &
+lector=$!
+exec 4> "$terminal"
+
+# Alterna una entrada dos veces, la mantiene activa el tiempo indicado en segundos
+Tecla() {
+    printf "$1" >&3
+    sleep ${2:-0.2}
+    printf "$1" >&3
+    sleep 0.2
+}
+
+Pulsar() {
+    for vez in $(seq $2); do
+        Tecla $1
+    done
+}
+
+Referencia() {
+    printf '$T,%d,0\r\n' $(date +%s) >&4
+}
+
+# Teclas 1 hora, 2 alarma, 3 bajar, 4 subir, 5 aceptar y 6 cancelar
+sleep 1
+for vuelta in 1 2 3; do
+    Referencia
+    Tecla 1 3.3; Pulsar 4 12; Tecla 5; Pulsar 3 5; Tecla 5
+    Tecla 2 3.3; Pulsar 4 7; Tecla 5; Pulsar 4 3; Tecla 5
+    Tecla 5; Tecla 6; Tecla 1 3.3; Tecla 6
+    printf '$C\r\n' >&4
+    Referencia
+    sleep 1
+done
+sleep 11
+
+kill $aplicacion $lector
+tr -d '\r' < "$temporal/informes"
@@ -0,0 +1,151 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Entradas y salidas digitales simuladas en memoria
+ **
+ ** \addtogroup pruebas Pruebas
+ ** \brief Pruebas unitarias y mediciones de rendimiento
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "digital_simulado.h"
+#include <stddef.h>
+
+/* === Macros definitions ====================================================================== */
+
+#ifndef OUTPUT_INSTANCES
+#define OUTPUT_INSTANCES 1
+#endif
+
+#ifndef INPUT_INSTANCES
+#define INPUT_INSTANCES 6
+#endif
+
+/* === Private data type declarations ========================================================== */
+
+//! Estructura para almacenar el descriptor de cada salida digital simulada
+struct digital_output_s {
+    bool allocated; //!< Bandera que indica si el descriptor esta en uso
+    bool inverted;  //!< Bandera que indica si trabaja de forma inversa
+    bool state;     //!< Estado del terminal simulado
+};
+
+//! Estructura para almacenar el descriptor de cada entrada digital simulada
+struct digital_input_s {
+    bool allocated;  //!< Bandera que indica si el descriptor esta en uso
+    bool inverted;   //!< Bandera que indica si trabaja de forma inversa
+    bool last_state; //!< Bandera con el ultimo estado de la entrada
+    bool state;      //!< Estado del terminal simulado
+};
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static struct digital_output_s outputs[OUTPUT_INSTANCES] = {0};
+
+static struct digital_input_s inputs[INPUT_INSTANCES] = {0};
+
+/* === Private function implementation ========================================================= */
+
+/* === Public function implementation ========================================================== */
+
+digital_output_t DigitalOutputCreate(uint8_t port, uint8_t pin, bool inverted) {
+    for (int i = 0; i < OUTPUT_INSTANCES; i++) {
+        if (!outputs[i].allocated) {
+            outputs[i].allocated = true;
+            outputs[i].inverted = inverted;
+            outputs[i].state = false;
+            return &outputs[i];
+        }
+    }
+    return NULL;
+}
+
+void DigitalOutputActivate(digital_output_t output) {
+    output->state = output->inverted ^ true;
+}
+
+void DigitalOutputDeactivate(digital_output_t output) {
+    output->state = output->inverted ^ false;
+}
+
+void DigitalOutputToggle(digital_output_t output) {
+    output->state = !output->state;
+}
+
+digital_input_t DigitalInputCreate(uint8_t port, uint8_t pin, bool inverted) {
+    for (int i = 0; i < INPUT_INSTANCES; i++) {
+        if (!inputs[i].allocated) {
+            inputs[i].allocated = true;
+            inputs[i].inverted = inverted;
+            inputs[i].last_state = false;
+            inputs[i].state = inverted;
+            return &inputs[i];
+        }
+    }
+    return NULL;
+}
+
+bool DigitalInputGetState(digital_input_t input) {
+    return input->inverted ^ input->state;
+}
+
+bool DigitalInputHasChanged(digital_input_t input) {
+    bool state = DigitalInputGetState(input);
+    bool resultado = state != input->last_state;
+    input->last_state = state;
+
+    return resultado;
+}
+
+bool DigitalInputHasActivated(digital_input_t input) {
+    bool state = DigitalInputGetState(input);
+    bool resultado = state && !input->last_state;
+    input->last_state = state;
+
+    return resultado;
+}
+
+bool DigitalInputHasDeactivated(digital_input_t input) {
+    bool state = DigitalInputGetState(input);
+    bool resultado = !state && input->last_state;
+    input->last_state = state;
+
+    return resultado;
+}
+
+void DigitalSimulatedSet(digital_input_t input, bool estado) {
+    input->state = input->inverted ^ estado;
+}
+
+bool DigitalSimulatedGet(digital_output_t output) {
+    return output->inverted ^ output->state;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,77 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef DIGITAL_SIMULADO_H
+#define DIGITAL_SIMULADO_H
+
+/** \brief Entradas y salidas digitales simuladas en memoria
+ **
+ ** Implementa la interfaz de digital.h sin acceder al hardware, para que las pruebas puedan fijar
+ ** el estado de las teclas y consultar el de las salidas.
+ **
+ ** \addtogroup pruebas Pruebas
+ ** \brief Pruebas unitarias y mediciones de rendimiento
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include "digital.h"
+#include <stdbool.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/* === Public data type declarations =========================================================== */
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Fija el estado que informa una entrada simulada
+ *
+ * @param  input   Puntero al descriptor de la entrada
+ * @param  estado  Indica si la entrada debe informarse activa
+ */
+void DigitalSimulatedSet(digital_input_t input, bool estado);
+
+/**
+ * @brief Consulta si una salida simulada esta activa
+ *
+ * @param  output  Puntero al descriptor de la salida
+ * @return true    La salida esta activa
+ */
+bool DigitalSimulatedGet(digital_output_t output);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* DIGITAL_SIMULADO_H */
@@ -0,0 +1,193 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Soporte minimo para pruebas unitarias y mediciones en la computadora de desarrollo
+ **
+ ** Este archivo no incluye reloj.h porque el tipo clock_t del reloj tiene el mismo nombre que el
+ ** definido por time.h en la biblioteca estandar.
+ **
+ ** \addtogroup pruebas Pruebas
+ ** \brief Pruebas unitarias y mediciones de rendimiento
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#define _DEFAULT_SOURCE
+
+#include "prueba.h"
+#include <pthread.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+
+/* === Macros definitions ====================================================================== */
+
+//! Tamano de la pila del hilo en que se mide el uso de la pila, en bytes, y patron con que se llena
+#define PILA_MEDIDA (256 * 1024)
+#define PATRON_PILA 0xA5
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static void Interrupcion(int senal);
+static void * HiloMedido(void * rutina);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static int ejecutadas = 0;
+
+static int fallidas = 0;
+
+static int fallas = 0;
+
+static uint32_t semilla = 0x12345678;
+
+static volatile prueba_t rutina_interrupcion = NULL;
+
+static sigset_t mascara_anterior;
+
+//! Pila del hilo en que se mide el uso de la pila y posicion de la pila al llamar a la funcion medida
+static uint8_t pila_medida[PILA_MEDIDA] __attribute__((aligned(16)));
+static uint8_t * volatile inicio_medida;
+
+/* === Private function implementation ========================================================= */
+
+static void Interrupcion(int senal) {
+    if (rutina_interrupcion) {
+        rutina_interrupcion();
+    }
+}
+
+// El sistema guarda los datos del hilo en el extremo alto de la pila, se mide desde una variable local
+static void * HiloMedido(void * rutina) {
+    uint8_t marca;
+
+    inicio_medida = &marca;
+    ((prueba_t)rutina)();
+    return NULL;
+}
+
+/* === Public function implementation ========================================================== */
+
+void PruebaFalla(const char * archivo, int linea, const char * condicion) {
+    if (fallas < 10) {
+        printf("    %s:%d: no se cumple %s\n", archivo, linea, condicion);
+    }
+    fallas++;
+}
+
+void PruebaEjecutar(const char * nombre, prueba_t prueba) {
+    fallas = 0;
+    prueba();
+    ejecutadas++;
+    if (fallas) {
+        fallidas++;
+        printf("FALLA %s (%d verificaciones)\n", nombre, fallas);
+    } else {
+        printf("OK    %s\n", nombre);
+    }
+}
+
+int PruebaResumen(void) {
+    printf("%d pruebas, %d fallidas\n", ejecutadas, fallidas);
+    return fallidas ? 1 : 0;
+}
+
+uint32_t PruebaAleatorio(void) {
+    semilla ^= semilla << 13;
+    semilla ^= semilla >> 17;
+    semilla ^= semilla << 5;
+    return semilla;
+}
+
+uint64_t PruebaTiempo(void) {
+    struct timespec ahora;
+
+    clock_gettime(CLOCK_MONOTONIC, &ahora);
+    return (uint64_t)ahora.tv_sec * 1000000000u + ahora.tv_nsec;
+}
+
+void PruebaMedicion(const char * nombre, uint32_t iteraciones, uint64_t duracion) {
+    printf("{\"benchmark\": \"%s\", \"iterations\": %u, \"ns_per_op\": %.2f}\n", nombre, iteraciones,
+           (double)duracion / iteraciones);
+}
+
+uint32_t PruebaMedirPila(prueba_t rutina) {
+    pthread_attr_t atributos;
+    pthread_t hilo;
+    uint32_t libre = 0;
+
+    memset(pila_medida, PATRON_PILA, sizeof(pila_medida));
+    pthread_attr_init(&atributos);
+    pthread_attr_setstack(&atributos, pila_medida, sizeof(pila_medida));
+    pthread_create(&hilo, &atributos, HiloMedido, (void *)rutina);
+    pthread_join(hilo, NULL);
+    pthread_attr_destroy(&atributos);
+
+    // La pila crece hacia las direcciones bajas, lo que nunca se escribio conserva el patron
+    while ((libre < sizeof(pila_medida)) && (pila_medida[libre] == PATRON_PILA)) {
+        libre++;
+    }
+    return inicio_medida - &pila_medida[libre];
+}
+
+void PruebaInterrumpir(prueba_t rutina, uint32_t periodo) {
+    struct sigaction accion = {.sa_handler = Interrupcion};
+    struct itimerval temporizador = {
+        .it_interval = {.tv_sec = periodo / 1000000, .tv_usec = periodo % 1000000},
+        .it_value = {.tv_sec = periodo / 1000000, .tv_usec = periodo % 1000000},
+    };
+
+    sigemptyset(&accion.sa_mask);
+    if (periodo) {
+        rutina_interrupcion = rutina;
+        sigaction(SIGALRM, &accion, NULL);
+    }
+    setitimer(ITIMER_REAL, &temporizador, NULL);
+    if (!periodo) {
+        rutina_interrupcion = NULL;
+    }
+}
+
+// La interrupcion no puede ejecutarse dentro de una seccion bloqueada, por lo que no pisa la mascara guardada
+void PruebaBloquear(void) {
+    sigset_t mascara;
+
+    sigemptyset(&mascara);
+    sigaddset(&mascara, SIGALRM);
+    sigprocmask(SIG_BLOCK, &mascara, &mascara_anterior);
+}
+
+void PruebaLiberar(void) {
+    sigprocmask(SIG_SETMASK, &mascara_anterior, NULL);
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,147 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef PRUEBA_H
+#define PRUEBA_H
+
+/** \brief Soporte minimo para pruebas unitarias y mediciones en la computadora de desarrollo
+ **
+ ** Las pruebas se compilan con el compilador nativo junto a los modulos bajo prueba, sin depender
+ ** de la placa ni del sistema operativo de tiempo real.
+ **
+ ** \addtogroup pruebas Pruebas
+ ** \brief Pruebas unitarias y mediciones de rendimiento
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+//! Registra una falla si la condicion no se cumple, sin interrumpir la prueba
+#define PRUEBA_VERIFICAR(condicion)                                                                \
+    do {                                                                                           \
+        if (!(condicion)) {                                                                        \
+            PruebaFalla(__FILE__, __LINE__, #condicion);                                           \
+        }                                                                                          \
+    } while (0)
+
+/* === Public data type declarations =========================================================== */
+
+//! Funcion que implementa una prueba
+typedef void (*prueba_t)(void);
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Informa una condicion no cumplida en la prueba que se esta ejecutando
+ *
+ * @param  archivo   Nombre del archivo de la prueba
+ * @param  linea     Numero de linea de la verificacion
+ * @param  condicion Texto de la condicion que no se cumplio
+ */
+void PruebaFalla(const char * archivo, int linea, const char * condicion);
+
+/**
+ * @brief Ejecuta una prueba e informa su resultado
+ *
+ * @param  nombre Nombre de la prueba
+ * @param  prueba Funcion que implementa la prueba
+ */
+void PruebaEjecutar(const char * nombre, prueba_t prueba);
+
+/**
+ * @brief Informa el resumen de las pruebas ejecutadas
+ *
+ * @return int Cero si todas las pruebas pasaron, uno en caso contrario, para usar como codigo de salida
+ */
+int PruebaResumen(void);
+
+/**
+ * @brief Genera un numero pseudoaleatorio reproducible entre ejecuciones
+ *
+ * @return uint32_t Numero pseudoaleatorio
+ */
+uint32_t PruebaAleatorio(void);
+
+/**
+ * @brief Lee un reloj monotono del sistema operativo anfitrion
+ *
+ * @return uint64_t Tiempo en nanosegundos desde un origen arbitrario
+ */
+uint64_t PruebaTiempo(void);
+
+/**
+ * @brief Informa el resultado de una medicion en una linea JSON para su procesamiento automatico
+ *
+ * @param  nombre      Nombre de la operacion medida
+ * @param  iteraciones Cantidad de veces que se ejecuto la operacion
+ * @param  duracion    Tiempo total de las iteraciones en nanosegundos
+ */
+void PruebaMedicion(const char * nombre, uint32_t iteraciones, uint64_t duracion);
+
+/**
+ * @brief Ejecuta una funcion en un hilo con la pila llena de un patron y mide cuanto de la pila uso
+ *
+ * La interrupcion simulada no debe estar activa, para que la señal no se atienda en otro hilo.
+ *
+ * @param  rutina   Funcion que se ejecuta en el hilo
+ * @return uint32_t Mayor cantidad de bytes de la pila que uso la funcion
+ */
+uint32_t PruebaMedirPila(prueba_t rutina);
+
+/**
+ * @brief Ejecuta periodicamente una funcion desde una señal, como si fuera una interrupcion
+ *
+ * @param  rutina   Funcion que atiende la interrupcion
+ * @param  periodo  Microsegundos entre interrupciones, cero para detenerlas
+ */
+void PruebaInterrumpir(prueba_t rutina, uint32_t periodo);
+
+/**
+ * @brief Impide que la interrupcion simulada se ejecute hasta llamar a PruebaLiberar
+ */
+void PruebaBloquear(void);
+
+/**
+ * @brief Vuelve a permitir la interrupcion simulada
+ */
+void PruebaLiberar(void);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* PRUEBA_H */
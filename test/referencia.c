@@ -0,0 +1,155 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Servidor de tiempo de referencia para disciplinar el reloj
+ **
+ ** Escribe periodicamente mensajes `$T,<segundos>,<microsegundos>` con la hora del sistema en un
+ ** dispositivo serie, por ejemplo la pseudo terminal que crea el puerto serie emulado de la placa
+ ** posix o el puerto USB de la EDU-CIAA. Se puede agregar ruido, deriva y desfase a la referencia
+ ** para evaluar el comportamiento del lazo de disciplina.
+ **
+ **   referencia <dispositivo> [-i intervalo s] [-j jitter ms] [-d deriva ppm] [-o desfase s] [-z zona s]
+ **
+ ** \addtogroup pruebas Pruebas
+ ** \brief Pruebas unitarias y mediciones de rendimiento
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#define _DEFAULT_SOURCE
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/* === Macros definitions ====================================================================== */
+
+//! Segundos entre el inicio de la epoca unix y el 1 de enero de 2000
+#define EPOCA_2000 946684800
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static int AbrirPuerto(const char * dispositivo);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+static int AbrirPuerto(const char * dispositivo) {
+    struct termios opciones;
+    int puerto = open(dispositivo, O_RDWR | O_NOCTTY);
+
+    if ((puerto >= 0) && (tcgetattr(puerto, &opciones) == 0)) {
+        cfmakeraw(&opciones);
+        cfsetspeed(&opciones, B115200);
+        tcsetattr(puerto, TCSANOW, &opciones);
+    }
+    return puerto;
+}
+
+/* === Public function implementation ========================================================== */
+
+int main(int argc, char * argv[]) {
+    double intervalo = 1;
+    double jitter = 0;
+    double deriva = 0;
+    double desfase = 0;
+    double zona = 0;
+    struct timespec inicio;
+    struct timespec ahora;
+    int opcion;
+    int puerto;
+
+    while ((opcion = getopt(argc, argv, "i:j:d:o:z:")) != -1) {
+        switch (opcion) {
+        case 'i':
+            intervalo = atof(optarg);
+            break;
+        case 'j':
+            jitter = atof(optarg) / 1000;
+            break;
+        case 'd':
+            deriva = atof(optarg) / 1000000;
+            break;
+        case 'o':
+            desfase = atof(optarg);
+            break;
+        case 'z':
+            zona = atof(optarg);
+            break;
+        default:
+            optind = argc;
+            break;
+        }
+    }
+    if ((optind != argc - 1) || (intervalo <= 0)) {
+        fprintf(stderr, "uso: %s <dispositivo> [-i intervalo s] [-j jitter ms] [-d deriva ppm] [-o desfase s] "
+                        "[-z zona s]\n",
+                argv[0]);
+        return 1;
+    }
+
+    puerto = AbrirPuerto(argv[optind]);
+    if (puerto < 0) {
+        perror(argv[optind]);
+        return 1;
+    }
+
+    clock_gettime(CLOCK_REALTIME, &inicio);
+    while (true) {
+        char mensaje[40];
+        double transcurrido;
+        double referencia;
+        int largo;
+
+        clock_gettime(CLOCK_REALTIME, &ahora);
+        transcurrido = (ahora.tv_sec - inicio.tv_sec) + (ahora.tv_nsec - inicio.tv_nsec) / 1e9;
+        referencia = (double)(ahora.tv_sec - EPOCA_2000) + ahora.tv_nsec / 1e9;
+        referencia += zona + desfase + deriva * transcurrido;
+        referencia += jitter * (2.0 * rand() / RAND_MAX - 1);
+
+        largo = snprintf(mensaje, sizeof(mensaje), "$T,%lu,%06lu\r\n", (unsigned long)referencia,
+                         (unsigned long)((referencia - (unsigned long)referencia) * 1000000));
+        if (write(puerto, mensaje, largo) != largo) {
+            perror(argv[optind]);
+            return 1;
+        }
+        printf("%s", mensaje);
+        fflush(stdout);
+        usleep(intervalo * 1000000);
+    }
+    return 0;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
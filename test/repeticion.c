@@ -0,0 +1,298 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Repeticion de una ejecucion grabada
+ **
+ ** Lee una grabacion hecha con la placa posix, vuelve a aplicar los cambios en las teclas en el mismo
+ ** tic en que los vio la aplicacion y compara la imagen de la pantalla despues de cada tic con la
+ ** grabada. Los tics se ejecutan tan rapido como se puede y, como en la placa, se omiten los que la
+ ** aplicacion permite dormir mientras no hay registros pendientes. Termina con error en la primera
+ ** diferencia, informando el tic y las dos imagenes.
+ **
+ **   repeticion <grabacion>
+ **
+ ** Los mensajes de la hora de referencia no se graban, por lo que una ejecucion en la que la
+ ** referencia corrigio el reloj no se puede repetir.
+ **
+ ** \addtogroup pruebas Pruebas
+ ** \brief Pruebas unitarias y mediciones de rendimiento
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "aplicacion.h"
+#include "digital_simulado.h"
+#include "prueba.h"
+#include "traza.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+//! Frecuencia del tic con la que graba la placa posix
+#define TICS_POR_SEGUNDO 1000
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static void Seccion(void);
+static bool Notificar(evento_t evento);
+static void Temporizar(espera_t espera, uint32_t milisegundos);
+static void Detener(espera_t espera);
+static void Apagar(void);
+static void Encender(uint8_t valor);
+static uint32_t Restante(void);
+static void Procesar(void);
+static uint8_t * Cargar(const char * nombre, uint32_t * tamano);
+static void Mostrar(const char * titulo, const uint8_t * pantalla, uint8_t digitos);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static const struct aplicacion_plataforma_s plataforma = {
+    .Bloquear = Seccion,
+    .Liberar = Seccion,
+    .Notificar = Notificar,
+    .Temporizar = Temporizar,
+    .Detener = Detener,
+};
+
+static struct board_s placa;
+
+//! Eventos que el tic envia a la tarea, se procesan despues de cada tic
+static struct evento_s cola[64];
+static uint32_t cola_entrada;
+static uint32_t cola_salida;
+
+//! Esperas en curso y momento en que vence cada una
+static bool temporizando[ESPERAS];
+static uint32_t vencimientos[ESPERAS];
+
+//! Tics ejecutados desde el inicio de la repeticion
+static uint64_t tic;
+
+/* === Private function implementation ========================================================= */
+
+static void Seccion(void) {
+}
+
+static bool Notificar(evento_t evento) {
+    if (cola_entrada - cola_salida >= sizeof(cola) / sizeof(cola[0])) {
+        return false;
+    }
+    cola[cola_entrada % (sizeof(cola) / sizeof(cola[0]))] = *evento;
+    cola_entrada++;
+    return true;
+}
+
+static void Temporizar(espera_t espera, uint32_t milisegundos) {
+    temporizando[espera] = true;
+    vencimientos[espera] = (uint32_t)tic + milisegundos;
+}
+
+static void Detener(espera_t espera) {
+    temporizando[espera] = false;
+}
+
+static void Apagar(void) {
+}
+
+static void Encender(uint8_t valor) {
+    (void)valor;
+}
+
+// Tiempo hasta el vencimiento mas cercano, cero si alguno ya vencio
+static uint32_t Restante(void) {
+    uint32_t restante = UINT32_MAX;
+
+    for (espera_t espera = 0; espera < ESPERAS; espera++) {
+        if (temporizando[espera]) {
+            if ((int32_t)(vencimientos[espera] - (uint32_t)tic) <= 0) {
+                return 0;
+            }
+            if (vencimientos[espera] - (uint32_t)tic < restante) {
+                restante = vencimientos[espera] - (uint32_t)tic;
+            }
+        }
+    }
+    return restante;
+}
+
+// Procesa los eventos pendientes y los vencimientos de las esperas como la tarea de la aplicacion
+static void Procesar(void) {
+    struct evento_s evento;
+
+    while (true) {
+        if (cola_salida != cola_entrada) {
+            evento = cola[cola_salida % (sizeof(cola) / sizeof(cola[0]))];
+            cola_salida++;
+        } else if (Restante() == 0) {
+            evento.tipo = EVENTO_TIEMPO_AGOTADO;
+            for (espera_t espera = 0; espera < ESPERAS; espera++) {
+                if (temporizando[espera] && ((int32_t)(vencimientos[espera] - (uint32_t)tic) <= 0)) {
+                    temporizando[espera] = false;
+                    evento.dato = espera;
+                }
+            }
+        } else {
+            break;
+        }
+        ApplicationProcess(&evento, (uint32_t)tic);
+    }
+}
+
+static uint8_t * Cargar(const char * nombre, uint32_t * tamano) {
+    uint8_t * datos = NULL;
+    FILE * archivo = fopen(nombre, "rb");
+    long largo;
+
+    if (archivo == NULL) {
+        return NULL;
+    }
+    if ((fseek(archivo, 0, SEEK_END) == 0) && ((largo = ftell(archivo)) > 0) && (largo <= UINT32_MAX)) {
+        rewind(archivo);
+        datos = malloc(largo);
+        if ((datos != NULL) && (fread(datos, 1, largo, archivo) == (size_t)largo)) {
+            *tamano = largo;
+        } else {
+            free(datos);
+            datos = NULL;
+        }
+    }
+    fclose(archivo);
+    return datos;
+}
+
+static void Mostrar(const char * titulo, const uint8_t * pantalla, uint8_t digitos) {
+    fprintf(stderr, "  %-9s", titulo);
+    for (uint8_t digito = 0; digito < digitos; digito++) {
+        fprintf(stderr, " %02x", pantalla[digito]);
+    }
+    fprintf(stderr, "\n");
+}
+
+/* === Public function implementation ========================================================== */
+
+int main(int argc, char * argv[]) {
+    static const struct display_driver_s driver = {
+        .ScreenTurnOff = Apagar,
+        .SegmentsTurnOn = Encender,
+        .DigitTurnOn = Encender,
+    };
+    struct traza_lector_s lector;
+    struct traza_registro_s registro;
+    uint8_t grabada[TRACE_MAX_DIGITS] = {0};
+    uint8_t repetida[TRACE_MAX_DIGITS];
+    digital_input_t teclas[TECLAS];
+    uint32_t cuadros = 0;
+    uint32_t tamano = 0;
+    uint32_t esperados;
+    uint8_t * datos;
+    uint64_t inicio;
+    double segundos;
+    bool pendiente;
+
+    if (argc != 2) {
+        fprintf(stderr, "uso: %s <grabacion>\n", argv[0]);
+        return 1;
+    }
+    datos = Cargar(argv[1], &tamano);
+    if (datos == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+    if (!TraceOpen(&lector, datos, tamano)) {
+        fprintf(stderr, "%s: no es una grabacion valida\n", argv[1]);
+        return 1;
+    }
+
+    placa.buzzer = DigitalOutputCreate(0, 0, false);
+    placa.set_time = teclas[TECLA_SET_TIME] = DigitalInputCreate(0, 0, false);
+    placa.set_alarm = teclas[TECLA_SET_ALARM] = DigitalInputCreate(0, 1, false);
+    placa.decrement = teclas[TECLA_DECREMENT] = DigitalInputCreate(0, 2, false);
+    placa.increment = teclas[TECLA_INCREMENT] = DigitalInputCreate(0, 3, false);
+    placa.accept = teclas[TECLA_ACCEPT] = DigitalInputCreate(0, 4, false);
+    placa.cancel = teclas[TECLA_CANCEL] = DigitalInputCreate(0, 5, false);
+    placa.display = DisplayCreate(lector.digitos, &driver);
+    placa.referencia = NULL;
+    placa.traza = NULL;
+
+    ApplicationCreate(&placa, ClockCreate(TICS_POR_SEGUNDO, ApplicationAlarm), NULL, &plataforma);
+
+    inicio = PruebaTiempo();
+    pendiente = TraceRead(&lector, &registro);
+    while (pendiente) {
+        // Mientras no hay registros que aplicar se duerme como en la placa, hasta el tic anterior al proximo
+        esperados = Restante();
+        if (registro.tic - tic - 1 < esperados) {
+            esperados = registro.tic - tic - 1;
+        }
+        if (esperados > 1) {
+            esperados = ApplicationSleepLimit(esperados);
+            tic += esperados;
+            ApplicationResume(esperados);
+        } else {
+            while (pendiente && (registro.tic <= tic + 1)) {
+                if (registro.tipo == TRAZA_ENTRADAS) {
+                    for (tecla_t tecla = 0; tecla < TECLAS; tecla++) {
+                        DigitalSimulatedSet(teclas[tecla], registro.datos[0] & (1 << tecla));
+                    }
+                } else if (registro.tipo == TRAZA_PANTALLA) {
+                    memcpy(grabada, registro.datos, lector.digitos);
+                }
+                pendiente = TraceRead(&lector, &registro);
+            }
+            tic++;
+            ApplicationTick();
+        }
+
+        DisplayGetFrame(placa.display, repetida);
+        if (memcmp(repetida, grabada, lector.digitos) != 0) {
+            fprintf(stderr, "Diferencia en el tic %llu (%llu s)\n", (unsigned long long)tic,
+                    (unsigned long long)(tic / TICS_POR_SEGUNDO));
+            Mostrar("grabada", grabada, lector.digitos);
+            Mostrar("repetida", repetida, lector.digitos);
+            return 1;
+        }
+        cuadros++;
+        Procesar();
+    }
+    segundos = (PruebaTiempo() - inicio) / 1e9;
+
+    if (lector.posicion != lector.tamano) {
+        fprintf(stderr, "%s: la grabacion termina con un registro incompleto\n", argv[1]);
+    }
+    printf("{\"tics\": %llu, \"simulated_s\": %.3f, \"wall_s\": %.3f, \"speedup\": %.0f, \"frames\": %u}\n",
+           (unsigned long long)tic, (double)tic / TICS_POR_SEGUNDO, segundos,
+           (segundos > 0) ? tic / (double)TICS_POR_SEGUNDO / segundos : 0, cuadros);
+    free(datos);
+    return 0;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
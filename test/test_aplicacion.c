@@ -0,0 +1,645 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Pruebas de la logica del reloj despertador
+ **
+ ** En la prueba de estres el tic se ejecuta desde una señal periodica que interrumpe a la tarea de
+ ** la aplicacion en cualquier punto, como lo hace la interrupcion en la placa. Las secciones
+ ** bloqueadas de la aplicacion y la lectura de la cola de eventos bloquean la señal.
+ **
+ ** \addtogroup pruebas Pruebas
+ ** \brief Pruebas unitarias y mediciones de rendimiento
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "aplicacion.h"
+#include "digital_simulado.h"
+#include "pilas.h"
+#include "prueba.h"
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/* === Macros definitions ====================================================================== */
+
+#define TICS_POR_SEGUNDO 1000
+
+#define DIGITOS 4
+
+//! Capacidad de la cola de eventos entre el hilo del tic y el de la aplicacion
+#define COLA_EVENTOS 4096
+
+//! Tics simulados en la prueba de estres y microsegundos entre tics
+#define TICS_ESTRES 100000
+#define PERIODO_ESTRES 20
+
+//! Capacidad de la cola en la prueba de estres con perdidas, menor que los eventos que puede generar un tic
+#define COLA_ESTRECHA 2
+
+//! Pila de la tarea de la aplicacion en la placa, en palabras de cuatro bytes, y margen recomendado en por ciento
+#define STACK_DISPATCHER 512
+#define MARGEN_PILA 25
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static void Bloquear(void);
+static void Liberar(void);
+static bool Notificar(evento_t evento);
+static bool Recibir(struct evento_s * evento);
+static void Temporizar(espera_t espera, uint32_t milisegundos);
+static void Detener(espera_t espera);
+static uint32_t Restante(void);
+static void ScreenTurnOff(void);
+static void SegmentsTurnOn(uint8_t segments);
+static void DigitTurnOn(uint8_t digit);
+static void Capturar(uint8_t cuadro[DIGITOS]);
+static void VerificarCuadro(const uint8_t cuadro[DIGITOS]);
+static void Tic(void);
+static void Procesar(void);
+static void Ejecutar(uint32_t milisegundos);
+static void Pulsar(tecla_t tecla, uint32_t milisegundos);
+static void Dormir(uint32_t milisegundos);
+static void InterrupcionTic(void);
+static void Recorrido(void);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static const uint8_t IMAGENES[] = {
+    SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F,
+    SEGMENT_B | SEGMENT_C,
+    SEGMENT_A | SEGMENT_B | SEGMENT_D | SEGMENT_E | SEGMENT_G,
+    SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_G,
+    SEGMENT_B | SEGMENT_C | SEGMENT_F | SEGMENT_G,
+    SEGMENT_A | SEGMENT_C | SEGMENT_D | SEGMENT_F | SEGMENT_G,
+    SEGMENT_A | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+    SEGMENT_A | SEGMENT_B | SEGMENT_C,
+    SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+    SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_F | SEGMENT_G,
+};
+
+static const struct aplicacion_plataforma_s plataforma = {
+    .Bloquear = Bloquear,
+    .Liberar = Liberar,
+    .Notificar = Notificar,
+    .Temporizar = Temporizar,
+    .Detener = Detener,
+};
+
+static struct board_s placa;
+static clock_t reloj;
+
+//! Cola de eventos entre el hilo del tic y el de la aplicacion
+static struct evento_s cola[COLA_EVENTOS];
+static uint32_t cola_entrada;
+static uint32_t cola_salida;
+static uint32_t eventos_perdidos;
+static uint32_t capacidad = COLA_EVENTOS;
+
+//! Esperas en curso y momento en que vence cada una, solo se usan desde la tarea
+static bool temporizando[ESPERAS];
+static uint32_t vencimientos[ESPERAS];
+
+//! Tiempo simulado en milisegundos, avanza con cada tic
+static atomic_uint_least32_t ahora;
+static atomic_bool terminado;
+
+//! Segmentos encendidos y ultimo cuadro completo enviado a la pantalla
+static uint8_t segmentos;
+static uint8_t pantalla[DIGITOS];
+static uint8_t digito_activo;
+
+//! Cantidad de cuadros verificados y de cuadros en cada tipo de modo durante la prueba de estres
+static uint32_t cuadros;
+static uint32_t cuadros_alarma;
+static uint32_t cuadros_hora;
+
+//! Cantidad de cuadros con todos los digitos apagados, solo el parpadeo sin hora valida los produce
+static uint32_t cuadros_apagados;
+
+//! Mayor cantidad de bytes de pila que uso el recorrido con teclas simuladas
+static uint32_t pila_usada;
+
+/* === Private function implementation ========================================================= */
+
+static void Bloquear(void) {
+    PruebaBloquear();
+}
+
+static void Liberar(void) {
+    PruebaLiberar();
+}
+
+// Solo se llama desde el tic, que no puede ser interrumpido por la lectura de la cola
+static bool Notificar(evento_t evento) {
+    if (cola_entrada - cola_salida >= capacidad) {
+        eventos_perdidos++;
+        return false;
+    }
+    cola[cola_entrada % COLA_EVENTOS] = *evento;
+    cola_entrada++;
+    return true;
+}
+
+static bool Recibir(struct evento_s * evento) {
+    bool resultado = false;
+
+    Bloquear();
+    if (cola_salida != cola_entrada) {
+        *evento = cola[cola_salida % COLA_EVENTOS];
+        cola_salida++;
+        resultado = true;
+    }
+    Liberar();
+    return resultado;
+}
+
+static void Temporizar(espera_t espera, uint32_t milisegundos) {
+    temporizando[espera] = true;
+    vencimientos[espera] = atomic_load(&ahora) + milisegundos;
+}
+
+static void Detener(espera_t espera) {
+    temporizando[espera] = false;
+}
+
+// Tiempo hasta el vencimiento mas cercano, cero si alguno ya vencio
+static uint32_t Restante(void) {
+    uint32_t restante = UINT32_MAX;
+    uint32_t tiempo = atomic_load(&ahora);
+
+    for (espera_t espera = 0; espera < ESPERAS; espera++) {
+        if (temporizando[espera]) {
+            if ((int32_t)(vencimientos[espera] - tiempo) <= 0) {
+                return 0;
+            }
+            if (vencimientos[espera] - tiempo < restante) {
+                restante = vencimientos[espera] - tiempo;
+            }
+        }
+    }
+    return restante;
+}
+
+static void ScreenTurnOff(void) {
+    segmentos = 0;
+}
+
+static void SegmentsTurnOn(uint8_t segments) {
+    segmentos = segments;
+}
+
+static void DigitTurnOn(uint8_t digit) {
+    pantalla[digit] = segmentos;
+    digito_activo = digit;
+}
+
+// Recorre todos los digitos desde el primero para obtener un cuadro completo, en el contexto del tic
+static void Capturar(uint8_t cuadro[DIGITOS]) {
+    while (digito_activo != DIGITOS - 1) {
+        DisplayRefresh(placa.display);
+    }
+    for (int digito = 0; digito < DIGITOS; digito++) {
+        DisplayRefresh(placa.display);
+    }
+    for (int digito = 0; digito < DIGITOS; digito++) {
+        cuadro[digito] = pantalla[digito];
+    }
+}
+
+// Un digito apagado por el parpadeo no tiene segmentos, cualquier otro debe ser una cifra valida
+static void VerificarCuadro(const uint8_t cuadro[DIGITOS]) {
+    uint8_t cifras[DIGITOS];
+    uint8_t puntos = 0;
+    uint8_t visibles = 0;
+
+    for (int digito = 0; digito < DIGITOS; digito++) {
+        cifras[digito] = 0xFF;
+        if (cuadro[digito]) {
+            visibles |= (1 << digito);
+            for (uint8_t cifra = 0; cifra < sizeof(IMAGENES); cifra++) {
+                if ((cuadro[digito] & ~SEGMENT_P) == IMAGENES[cifra]) {
+                    cifras[digito] = cifra;
+                }
+            }
+            PRUEBA_VERIFICAR(cifras[digito] != 0xFF);
+            if (cuadro[digito] & SEGMENT_P) {
+                puntos |= (1 << digito);
+            }
+        }
+    }
+
+    // El parpadeo apaga las horas, los minutos o todos los digitos, nunca un digito suelto
+    PRUEBA_VERIFICAR(visibles == 0x00 || visibles == 0x03 || visibles == 0x0C || visibles == 0x0F);
+    cuadros_apagados += (visibles == 0x00);
+
+    // Los puntos 0 y 2 solo se encienden al ajustar la alarma, y en ese caso se encienden todos
+    if (puntos & 0x05) {
+        PRUEBA_VERIFICAR(puntos == visibles);
+        cuadros_alarma++;
+    } else if (puntos & 0x02) {
+        cuadros_hora++;
+    }
+    if ((visibles & 0x03) == 0x03) {
+        PRUEBA_VERIFICAR(cifras[0] * 10 + cifras[1] <= 23);
+    }
+    if ((visibles & 0x0C) == 0x0C) {
+        PRUEBA_VERIFICAR(cifras[2] * 10 + cifras[3] <= 59);
+    }
+    cuadros++;
+}
+
+static void Tic(void) {
+    uint8_t cuadro[DIGITOS];
+
+    Bloquear();
+    ApplicationTick();
+    Capturar(cuadro);
+    VerificarCuadro(cuadro);
+    Liberar();
+    atomic_fetch_add(&ahora, 1);
+}
+
+// Procesa los eventos pendientes y los vencimientos de las esperas como la tarea de la aplicacion
+static void Procesar(void) {
+    struct evento_s evento;
+
+    while (true) {
+        if (Recibir(&evento)) {
+            ApplicationProcess(&evento, atomic_load(&ahora));
+        } else if (Restante() == 0) {
+            evento.tipo = EVENTO_TIEMPO_AGOTADO;
+            for (espera_t espera = 0; espera < ESPERAS; espera++) {
+                if (temporizando[espera] && ((int32_t)(vencimientos[espera] - atomic_load(&ahora)) <= 0)) {
+                    temporizando[espera] = false;
+                    evento.dato = espera;
+                }
+            }
+            ApplicationProcess(&evento, atomic_load(&ahora));
+        } else {
+            break;
+        }
+    }
+}
+
+static void Ejecutar(uint32_t milisegundos) {
+    for (uint32_t tic = 0; tic < milisegundos; tic++) {
+        Tic();
+        Procesar();
+    }
+}
+
+static void Pulsar(tecla_t tecla, uint32_t milisegundos) {
+    digital_input_t teclas[] = {placa.set_time,  placa.set_alarm, placa.decrement,
+                                placa.increment, placa.accept,    placa.cancel};
+
+    DigitalSimulatedSet(teclas[tecla], true);
+    Ejecutar(milisegundos);
+    DigitalSimulatedSet(teclas[tecla], false);
+    Ejecutar(50);
+}
+
+// Simula la tarea inactiva con reposo, el procesador duerme siempre los tics que permite la aplicacion
+static void Dormir(uint32_t milisegundos) {
+    uint32_t fin = atomic_load(&ahora) + milisegundos;
+    uint32_t esperados;
+    uint32_t limite;
+
+    while (atomic_load(&ahora) < fin) {
+        Procesar();
+        esperados = Restante();
+        if (esperados > fin - atomic_load(&ahora)) {
+            esperados = fin - atomic_load(&ahora);
+        }
+
+        Bloquear();
+        limite = ApplicationSleepLimit(esperados);
+        atomic_fetch_add(&ahora, limite);
+        ApplicationResume(limite);
+        Liberar();
+    }
+    Procesar();
+}
+
+// Atiende la señal periodica como la interrupcion del tic, cambiando las teclas al azar
+static void InterrupcionTic(void) {
+    static digital_input_t teclas[TECLAS];
+    static bool estados[TECLAS];
+    static uint32_t tics = 0;
+    uint32_t azar = PruebaAleatorio();
+
+    if (tics == 0) {
+        teclas[TECLA_SET_TIME] = placa.set_time;
+        teclas[TECLA_SET_ALARM] = placa.set_alarm;
+        teclas[TECLA_DECREMENT] = placa.decrement;
+        teclas[TECLA_INCREMENT] = placa.increment;
+        teclas[TECLA_ACCEPT] = placa.accept;
+        teclas[TECLA_CANCEL] = placa.cancel;
+    }
+
+    // Las teclas de ajuste cambian con poca frecuencia para que se cumplan pulsaciones largas
+    if ((azar % 4) == 0) {
+        tecla_t tecla = (azar >> 8) % TECLAS;
+        if ((tecla > TECLA_SET_ALARM) || ((azar >> 16) % 256 == 0)) {
+            estados[tecla] = !estados[tecla];
+            DigitalSimulatedSet(teclas[tecla], estados[tecla]);
+        }
+    }
+    Tic();
+
+    tics++;
+    if ((tics % TICS_ESTRES) == 0) {
+        atomic_store(&terminado, true);
+    }
+}
+
+static void PruebaReposo(void) {
+    struct reposo_s reposo;
+    uint8_t cuadro[DIGITOS];
+    uint32_t inicio, fin;
+    uint32_t fraccion_inicio, fraccion_fin;
+
+    // Sin hora valida la pantalla parpadea completa y mientras esta apagada solo hay que leer las teclas
+    inicio = ClockGetStamp(reloj, &fraccion_inicio);
+    Dormir(10000);
+    fin = ClockGetStamp(reloj, &fraccion_fin);
+    ApplicationSleepStats(&reposo);
+
+    printf("    %u despertares en %u tics, %u omitidos (pantalla %u, teclas %u, reloj %u, tarea %u)\n",
+           reposo.despertares, reposo.tics_dormido, reposo.tics_omitidos, reposo.causas[DESPERTAR_PANTALLA],
+           reposo.causas[DESPERTAR_TECLAS], reposo.causas[DESPERTAR_RELOJ], reposo.causas[DESPERTAR_TAREA]);
+    PRUEBA_VERIFICAR((fin - inicio == 10) && (fraccion_fin == fraccion_inicio));
+    PRUEBA_VERIFICAR(reposo.tics_dormido == 10000);
+    PRUEBA_VERIFICAR(reposo.despertares + reposo.tics_omitidos == reposo.tics_dormido);
+    PRUEBA_VERIFICAR(reposo.despertares < 7000);
+    PRUEBA_VERIFICAR((reposo.causas[DESPERTAR_PANTALLA] > 0) && (reposo.causas[DESPERTAR_TECLAS] > 0));
+    PRUEBA_VERIFICAR(reposo.causas[DESPERTAR_INTERRUPCION] == 0);
+
+    // Una pulsacion larga durante el reposo entra al ajuste igual que con todos los tics
+    DigitalSimulatedSet(placa.set_time, true);
+    Dormir(3100);
+    DigitalSimulatedSet(placa.set_time, false);
+    Dormir(50);
+    Bloquear();
+    Capturar(cuadro);
+    Liberar();
+    PRUEBA_VERIFICAR((cuadro[0] != 0) && (cuadro[1] != 0));
+
+    Pulsar(TECLA_CANCEL, 50);
+}
+
+static void PruebaAjusteHora(void) {
+    uint8_t hora[6];
+
+    Ejecutar(100);
+    PRUEBA_VERIFICAR(!ClockGetTime(reloj, hora, sizeof(hora)));
+
+    Pulsar(TECLA_SET_TIME, 3100);
+    for (int pulsacion = 0; pulsacion < 5; pulsacion++) {
+        Pulsar(TECLA_INCREMENT, 50);
+    }
+    Pulsar(TECLA_ACCEPT, 50);
+    for (int pulsacion = 0; pulsacion < 2; pulsacion++) {
+        Pulsar(TECLA_INCREMENT, 50);
+    }
+    Pulsar(TECLA_ACCEPT, 50);
+
+    PRUEBA_VERIFICAR(ClockGetTime(reloj, hora, sizeof(hora)));
+    PRUEBA_VERIFICAR(hora[0] == 0 && hora[1] == 2 && hora[2] == 0 && hora[3] == 5);
+}
+
+static void PruebaInactividad(void) {
+    uint8_t cuadro[DIGITOS];
+    uint8_t hora[6];
+    struct evento_s vencimiento = {.tipo = EVENTO_TIEMPO_AGOTADO, .dato = ESPERA_INACTIVIDAD};
+
+    Pulsar(TECLA_SET_ALARM, 3100);
+    Pulsar(TECLA_INCREMENT, 50);
+    Bloquear();
+    Capturar(cuadro);
+    Liberar();
+    PRUEBA_VERIFICAR((cuadro[0] & SEGMENT_P) && (cuadro[1] & SEGMENT_P));
+
+    // Un vencimiento que llega despues de reiniciar la espera se descarta
+    ApplicationProcess(&vencimiento, atomic_load(&ahora));
+    Bloquear();
+    Capturar(cuadro);
+    Liberar();
+    PRUEBA_VERIFICAR((cuadro[0] & SEGMENT_P) && (cuadro[1] & SEGMENT_P));
+
+    // Sin actividad se abandona el ajuste sin modificar la alarma
+    Ejecutar(30100);
+    Bloquear();
+    Capturar(cuadro);
+    Liberar();
+    PRUEBA_VERIFICAR(!(cuadro[0] & SEGMENT_P) && !(cuadro[2] & SEGMENT_P));
+    AlarmGetTime(reloj, hora, sizeof(hora));
+    PRUEBA_VERIFICAR(hora[0] == 0 && hora[1] == 0 && hora[2] == 0 && hora[3] == 0);
+}
+
+// Recorrido por los modos de la aplicacion con teclas y reposo, sin imprimir para medir solo su pila
+static void Recorrido(void) {
+    Ejecutar(30100);
+    Dormir(5000);
+    Pulsar(TECLA_SET_TIME, 3100);
+    Pulsar(TECLA_INCREMENT, 50);
+    Pulsar(TECLA_DECREMENT, 50);
+    Pulsar(TECLA_ACCEPT, 50);
+    Pulsar(TECLA_INCREMENT, 50);
+    Pulsar(TECLA_ACCEPT, 50);
+    Pulsar(TECLA_SET_ALARM, 3100);
+    Pulsar(TECLA_INCREMENT, 50);
+    Pulsar(TECLA_ACCEPT, 50);
+    Pulsar(TECLA_ACCEPT, 50);
+    Pulsar(TECLA_SET_ALARM, 3100);
+    Ejecutar(30100);
+    Pulsar(TECLA_CANCEL, 50);
+    Dormir(5000);
+}
+
+// El anfitrion usa punteros de ocho bytes, por lo que lo medido acota por arriba lo que usa la placa
+static void PruebaPila(void) {
+    pilas_t pilas = StackMonitorCreate(MARGEN_PILA);
+    struct pila_estado_s estado;
+    uint32_t tamano = STACK_DISPATCHER * sizeof(uint32_t);
+    struct pila_muestra_s muestra = {
+        .nombre = "TareaEventos",
+        .numero = 1,
+        .tamano = tamano,
+        .libre = (pila_usada < tamano) ? tamano - pila_usada : 0,
+    };
+    char informe[64];
+
+    PRUEBA_VERIFICAR(pilas != NULL);
+    StackMonitorSample(pilas, &muestra, 1);
+    StackMonitorGetTask(pilas, 0, &estado);
+    printf("    %u bytes usados, %u recomendados con %u%% de margen, %u reservados en la placa\n", pila_usada,
+           estado.recomendado, MARGEN_PILA, tamano);
+    printf("    %.*s", (int)StackMonitorReport(pilas, informe, sizeof(informe)), informe);
+    PRUEBA_VERIFICAR(pila_usada > 0);
+    PRUEBA_VERIFICAR(estado.recomendado <= tamano);
+}
+
+// Suelta todas las teclas y espera que la aplicacion procese los cambios
+static void SoltarTeclas(void) {
+    digital_input_t teclas[] = {placa.set_time,  placa.set_alarm, placa.decrement,
+                                placa.increment, placa.accept,    placa.cancel};
+
+    for (tecla_t tecla = 0; tecla < TECLAS; tecla++) {
+        DigitalSimulatedSet(teclas[tecla], false);
+    }
+    Ejecutar(100);
+}
+
+// Una liberacion que no entra en la cola no deja corriendo la espera de la pulsacion larga
+static void PruebaPerdida(void) {
+    uint32_t perdidos = ApplicationLostEvents();
+
+    Ejecutar(100);
+    capacidad = 1;
+    DigitalSimulatedSet(placa.set_time, true);
+    while (cola_entrada == cola_salida) {
+        Tic();
+    }
+    PRUEBA_VERIFICAR(cola[cola_salida % COLA_EVENTOS].tipo == EVENTO_TECLA_PRESIONADA);
+    DigitalSimulatedSet(placa.set_time, false);
+    while (ApplicationLostEvents() == perdidos) {
+        Tic();
+    }
+    capacidad = COLA_EVENTOS;
+
+    Procesar();
+    PRUEBA_VERIFICAR(ApplicationLostEvents() == eventos_perdidos);
+    PRUEBA_VERIFICAR(!temporizando[ESPERA_PULSACION]);
+    eventos_perdidos = 0;
+}
+
+static void PruebaEstres(void) {
+    cuadros = 0;
+    cuadros_alarma = 0;
+    cuadros_hora = 0;
+    atomic_store(&terminado, false);
+
+    PruebaInterrumpir(InterrupcionTic, PERIODO_ESTRES);
+    while (!atomic_load(&terminado)) {
+        Procesar();
+    }
+    PruebaInterrumpir(NULL, 0);
+
+    printf("    %u cuadros verificados, %u ajustando la alarma, %u mostrando la hora\n", cuadros, cuadros_alarma,
+           cuadros_hora);
+    PRUEBA_VERIFICAR(eventos_perdidos == 0);
+    PRUEBA_VERIFICAR(cuadros_alarma > 0);
+    PRUEBA_VERIFICAR(cuadros_hora > 0);
+}
+
+// Con una cola que se llena la aplicacion cuenta cada perdida y al soltar las teclas no queda una pulsacion pendiente
+static void PruebaEstresPerdidas(void) {
+    uint32_t perdidos = ApplicationLostEvents();
+
+    eventos_perdidos = 0;
+    capacidad = COLA_ESTRECHA;
+    atomic_store(&terminado, false);
+
+    PruebaInterrumpir(InterrupcionTic, PERIODO_ESTRES);
+    while (!atomic_load(&terminado)) {
+        Procesar();
+    }
+    PruebaInterrumpir(NULL, 0);
+    capacidad = COLA_EVENTOS;
+
+    printf("    %u eventos perdidos\n", eventos_perdidos);
+    PRUEBA_VERIFICAR(eventos_perdidos > 0);
+    PRUEBA_VERIFICAR(ApplicationLostEvents() - perdidos == eventos_perdidos);
+    SoltarTeclas();
+    PRUEBA_VERIFICAR(!temporizando[ESPERA_PULSACION]);
+}
+
+// Con la hora tomada de la referencia cancelar un ajuste vuelve a mostrar la hora y no al parpadeo inicial
+static void PruebaReferencia(void) {
+    static const char mensaje[] = "$T,738940800,0\r\n";
+    struct evento_s referencia = {.tipo = EVENTO_REFERENCIA};
+    disciplina_t disciplina;
+    uint8_t hora[6];
+
+    reloj = ClockCreate(TICS_POR_SEGUNDO, ApplicationAlarm);
+    disciplina = DisciplineCreate(reloj);
+    ApplicationCreate(&placa, reloj, disciplina, &plataforma);
+    PRUEBA_VERIFICAR(!ClockGetTime(reloj, hora, sizeof(hora)));
+
+    Bloquear();
+    PRUEBA_VERIFICAR(DisciplineReceive(disciplina, mensaje, sizeof(mensaje) - 1));
+    Liberar();
+    ApplicationProcess(&referencia, atomic_load(&ahora));
+    PRUEBA_VERIFICAR(ClockGetTime(reloj, hora, sizeof(hora)));
+    PRUEBA_VERIFICAR(hora[0] == 1 && hora[1] == 3 && hora[2] == 2 && hora[3] == 0);
+
+    Pulsar(TECLA_SET_TIME, 3100);
+    Pulsar(TECLA_CANCEL, 50);
+    cuadros_apagados = 0;
+    Ejecutar(1000);
+    PRUEBA_VERIFICAR(cuadros_apagados == 0);
+}
+
+/* === Public function implementation ========================================================== */
+
+int main(void) {
+    static const struct display_driver_s driver = {
+        .ScreenTurnOff = ScreenTurnOff,
+        .SegmentsTurnOn = SegmentsTurnOn,
+        .DigitTurnOn = DigitTurnOn,
+    };
+
+    placa.buzzer = DigitalOutputCreate(0, 0, false);
+    placa.set_time = DigitalInputCreate(0, 0, false);
+    placa.set_alarm = DigitalInputCreate(0, 1, false);
+    placa.decrement = DigitalInputCreate(0, 2, false);
+    placa.increment = DigitalInputCreate(0, 3, false);
+    placa.accept = DigitalInputCreate(0, 4, false);
+    placa.cancel = DigitalInputCreate(0, 5, false);
+    placa.display = DisplayCreate(DIGITOS, &driver);
+    placa.referencia = NULL;
+
+    reloj = ClockCreate(TICS_POR_SEGUNDO, ApplicationAlarm);
+    ApplicationCreate(&placa, reloj, NULL, &plataforma);
+
+    PruebaEjecutar("reposo", PruebaReposo);
+    PruebaEjecutar("ajuste_hora", PruebaAjusteHora);
+    PruebaEjecutar("inactividad", PruebaInactividad);
+    PruebaEjecutar("perdida", PruebaPerdida);
+    PruebaEjecutar("estres", PruebaEstres);
+    PruebaEjecutar("estres_perdidas", PruebaEstresPerdidas);
+
+    pila_usada = PruebaMedirPila(Recorrido);
+    PruebaEjecutar("pila", PruebaPila);
+    PruebaEjecutar("referencia", PruebaReferencia);
+    return PruebaResumen();
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
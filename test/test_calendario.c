@@ -0,0 +1,138 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Pruebas unitarias del calendario civil
+ **
+ ** \addtogroup pruebas Pruebas
+ ** \brief Pruebas unitarias y mediciones de rendimiento
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "calendario.h"
+#include "prueba.h"
+
+/* === Macros definitions ====================================================================== */
+
+//! Dias de un ciclo completo de 400 anios del calendario gregoriano
+#define DIAS_POR_ERA 146097
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static bool Bisiesto(int32_t anio);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+static bool Bisiesto(int32_t anio) {
+    return ((anio % 4 == 0) && (anio % 100 != 0)) || (anio % 400 == 0);
+}
+
+// Recorre dia por dia un ciclo de 400 anios comparando contra un contador de fechas trivial
+static void PruebaIdaYVueltaEnUnaEra(void) {
+    static const uint8_t dias_por_mes[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    fecha_t esperada = {1800, 3, 1};
+    int32_t inicial = CalendarDaysFromCivil(esperada.anio, esperada.mes, esperada.dia);
+    fecha_t fecha;
+
+    for (int32_t dias = inicial; dias < inicial + 2 * DIAS_POR_ERA; dias++) {
+        CalendarCivilFromDays(dias, &fecha);
+        PRUEBA_VERIFICAR(fecha.anio == esperada.anio);
+        PRUEBA_VERIFICAR(fecha.mes == esperada.mes);
+        PRUEBA_VERIFICAR(fecha.dia == esperada.dia);
+        PRUEBA_VERIFICAR(CalendarDaysFromCivil(fecha.anio, fecha.mes, fecha.dia) == dias);
+        PRUEBA_VERIFICAR(CalendarIsValid(&fecha));
+
+        esperada.dia++;
+        if (esperada.dia > dias_por_mes[esperada.mes - 1] + ((esperada.mes == 2) && Bisiesto(esperada.anio))) {
+            esperada.dia = 1;
+            esperada.mes++;
+            if (esperada.mes > 12) {
+                esperada.mes = 1;
+                esperada.anio++;
+            }
+        }
+    }
+}
+
+static void PruebaDiaDeLaSemana(void) {
+    PRUEBA_VERIFICAR(CalendarWeekday(0) == 4);
+    PRUEBA_VERIFICAR(CalendarWeekday(-1) == 3);
+    PRUEBA_VERIFICAR(CalendarWeekday(CalendarDaysFromCivil(2000, 1, 1)) == 6);
+    PRUEBA_VERIFICAR(CalendarWeekday(CalendarDaysFromCivil(2023, 6, 5)) == 1);
+    for (int32_t dias = -DIAS_POR_ERA; dias < DIAS_POR_ERA; dias++) {
+        PRUEBA_VERIFICAR(CalendarWeekday(dias + 1) == (CalendarWeekday(dias) + 1) % 7);
+    }
+}
+
+static void PruebaFechasInvalidas(void) {
+    static const fecha_t invalidas[] = {
+        {2023, 2, 29}, {2100, 2, 29}, {2023, 4, 31}, {2023, 13, 1}, {2023, 0, 1}, {2023, 1, 0},
+    };
+    fecha_t bisiesto = {2000, 2, 29};
+
+    PRUEBA_VERIFICAR(CalendarIsValid(&bisiesto));
+    for (unsigned indice = 0; indice < sizeof(invalidas) / sizeof(invalidas[0]); indice++) {
+        PRUEBA_VERIFICAR(!CalendarIsValid(&invalidas[indice]));
+    }
+}
+
+static void PruebaCambiosDeHorarioVerano(void) {
+    int32_t marzo = CalendarDaysFromCivil(2023, 3, 26);
+    int32_t octubre = CalendarDaysFromCivil(2023, 10, 29);
+    uint32_t siguiente;
+
+    // En Europa central el cambio ocurre a las 2 de la hora estandar del ultimo domingo del mes
+    PRUEBA_VERIFICAR(CalendarDstOffset(DST_EUROPA_CENTRAL, marzo, 2 * 3600 - 1, &siguiente) == 0);
+    PRUEBA_VERIFICAR(siguiente == 1);
+    PRUEBA_VERIFICAR(CalendarDstOffset(DST_EUROPA_CENTRAL, marzo, 2 * 3600, &siguiente) == 3600);
+    PRUEBA_VERIFICAR(CalendarDstOffset(DST_EUROPA_CENTRAL, octubre, 2 * 3600 - 1, &siguiente) == 3600);
+    PRUEBA_VERIFICAR(siguiente == 1);
+    PRUEBA_VERIFICAR(CalendarDstOffset(DST_EUROPA_CENTRAL, octubre, 2 * 3600, &siguiente) == 0);
+
+    PRUEBA_VERIFICAR(CalendarDstOffset(DST_AMERICA_NORTE, CalendarDaysFromCivil(2023, 3, 12), 2 * 3600, &siguiente) ==
+                     3600);
+    PRUEBA_VERIFICAR(CalendarDstOffset(DST_AMERICA_NORTE, CalendarDaysFromCivil(2023, 11, 5), 2 * 3600, &siguiente) ==
+                     0);
+    PRUEBA_VERIFICAR(CalendarDstOffset(DST_AUSTRALIA_SUR, CalendarDaysFromCivil(2023, 1, 1), 0, &siguiente) == 3600);
+    PRUEBA_VERIFICAR(CalendarDstOffset(DST_AUSTRALIA_SUR, CalendarDaysFromCivil(2023, 7, 1), 0, &siguiente) == 0);
+}
+
+/* === Public function implementation ========================================================== */
+
+int main(void) {
+    PruebaEjecutar("ida_y_vuelta_en_una_era", PruebaIdaYVueltaEnUnaEra);
+    PruebaEjecutar("dia_de_la_semana", PruebaDiaDeLaSemana);
+    PruebaEjecutar("fechas_invalidas", PruebaFechasInvalidas);
+    PruebaEjecutar("cambios_de_horario_verano", PruebaCambiosDeHorarioVerano);
+    return PruebaResumen();
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,147 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Pruebas de la medicion de carga del procesador
+ **
+ ** Simula los tiempos de ejecucion que informaria el sistema operativo y verifica los porcentajes
+ ** de cada ventana, el pico y el informe de texto.
+ **
+ ** \addtogroup pruebas Pruebas
+ ** \brief Pruebas unitarias y mediciones de rendimiento
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "carga.h"
+#include "prueba.h"
+#include <stddef.h>
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static void Muestrear(carga_t carga, uint32_t inactiva, uint32_t eventos, uint32_t total);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+// Muestra de dos tareas con sus tiempos acumulados, como las entrega el sistema operativo
+static void Muestrear(carga_t carga, uint32_t inactiva, uint32_t eventos, uint32_t total) {
+    struct carga_muestra_s muestras[] = {
+        {.nombre = "IDLE", .numero = 1, .tiempo = inactiva, .inactiva = true},
+        {.nombre = "TareaEventos", .numero = 2, .tiempo = eventos},
+    };
+
+    LoadSample(carga, muestras, sizeof(muestras) / sizeof(muestras[0]), total);
+}
+
+static void PruebaPorcentajes(void) {
+    carga_t carga = LoadCreate();
+    struct carga_estado_s estado;
+    char texto[64];
+    uint16_t largo;
+
+    PRUEBA_VERIFICAR(carga != NULL);
+    Muestrear(carga, 700, 300, 1000);
+    LoadGetStatus(carga, &estado);
+    PRUEBA_VERIFICAR(estado.ventanas == 1);
+    PRUEBA_VERIFICAR(estado.ventana == 1000);
+    PRUEBA_VERIFICAR(estado.inactivo == 700);
+    PRUEBA_VERIFICAR(estado.carga == 300);
+
+    LoadSetLostEvents(carga, 2);
+    largo = LoadReport(carga, texto, sizeof(texto));
+    PRUEBA_VERIFICAR((largo == 44) && (memcmp(texto, "$C,1000,300,300,2,IDLE,700,TareaEventos,300\n", largo) == 0));
+
+    // Las ventanas siguientes solo cuentan el tiempo usado desde la muestra anterior
+    Muestrear(carga, 1600, 400, 2000);
+    LoadGetStatus(carga, &estado);
+    PRUEBA_VERIFICAR(estado.inactivo == 900);
+    PRUEBA_VERIFICAR(estado.carga == 100);
+}
+
+static void PruebaVueltaContador(void) {
+    carga_t carga = LoadCreate();
+    struct carga_estado_s estado;
+
+    PRUEBA_VERIFICAR(carga != NULL);
+    Muestrear(carga, 0xFFFFF000u, 0x00000800u, 0xFFFFF800u);
+
+    // El contador da la vuelta dentro de la ventana, las diferencias sin signo siguen siendo correctas
+    Muestrear(carga, 0x00000200u, 0x00000A00u, 0x00000C00u);
+    LoadGetStatus(carga, &estado);
+    PRUEBA_VERIFICAR(estado.ventana == 0x1400);
+    PRUEBA_VERIFICAR(estado.inactivo == 900);
+    PRUEBA_VERIFICAR(estado.carga == 100);
+}
+
+static void PruebaPico(void) {
+    carga_t carga = LoadCreate();
+    struct carga_estado_s estado;
+
+    PRUEBA_VERIFICAR(carga != NULL);
+    Muestrear(carga, 700, 300, 1000);
+    Muestrear(carga, 1100, 900, 2000);
+    Muestrear(carga, 2000, 1000, 3000);
+    LoadGetStatus(carga, &estado);
+    PRUEBA_VERIFICAR(estado.ventanas == 3);
+    PRUEBA_VERIFICAR(estado.carga == 100);
+    PRUEBA_VERIFICAR(estado.pico == 600);
+    PRUEBA_VERIFICAR(estado.ventana_pico == 1);
+}
+
+static void PruebaInformeTruncado(void) {
+    carga_t carga = LoadCreate();
+    char texto[64];
+    uint16_t largo;
+
+    PRUEBA_VERIFICAR(carga != NULL);
+    Muestrear(carga, 700, 300, 1000);
+
+    // Las tareas que no entran completas se omiten, el fin de linea siempre se escribe
+    largo = LoadReport(carga, texto, 32);
+    PRUEBA_VERIFICAR((largo == 27) && (memcmp(texto, "$C,1000,300,300,0,IDLE,700\n", largo) == 0));
+
+    // Sin lugar para el encabezado no se escribe nada
+    PRUEBA_VERIFICAR(LoadReport(carga, texto, 8) == 0);
+}
+
+/* === Public function implementation ========================================================= */
+
+int main(void) {
+    PruebaEjecutar("porcentajes", PruebaPorcentajes);
+    PruebaEjecutar("vuelta_contador", PruebaVueltaContador);
+    PruebaEjecutar("pico", PruebaPico);
+    PruebaEjecutar("informe_truncado", PruebaInformeTruncado);
+    return PruebaResumen();
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
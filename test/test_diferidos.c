@@ -0,0 +1,246 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Pruebas de los eventos diferidos de la capa de abstraccion
+ **
+ ** Compila la implementacion posix de las entradas digitales con HAL_EVENT_DEFERRED, asi los cambios
+ ** de las entradas solo guardan el evento y los manejadores se llaman al despachar la cola. Verifica
+ ** el orden y los datos de los eventos, el limite de cada despacho, que con la cola llena el evento se
+ ** atiende en el momento y que varios hilos publicando mientras otro despacha no pierden eventos.
+ ** Tambien mide el costo de publicar un evento, que es el tiempo que agrega la interrupcion.
+ **
+ ** \addtogroup pruebas Pruebas
+ ** \brief Pruebas unitarias y mediciones de rendimiento
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "prueba.h"
+#include "hal_event.h"
+#include "soc_gpio.h"
+#include <pthread.h>
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+#define BITS 8
+
+//! Capacidad de la cola, la de la configuracion por defecto si no se compila con otra
+#ifdef HAL_EVENT_QUEUE_SIZE
+#define COLA HAL_EVENT_QUEUE_SIZE
+#else
+#define COLA 16
+#endif
+
+//! Hilos que publican eventos a la vez y cambios que hace cada uno
+#define HILOS 4
+#define CAMBIOS 200000
+
+//! Eventos publicados y despachados en la medicion
+#define MEDICIONES 1000000
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static void Evento(hal_gpio_bit_t gpio, bool rising, void * objeto);
+static void Reiniciar(void);
+static void * Publicar(void * objeto);
+static void * Despachar(void * objeto);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+//! Terminales del puerto 1 de la placa posix
+static hal_gpio_bit_t terminales[BITS];
+
+//! Llamadas recibidas por terminal y orden en que llegaron
+static uint32_t llamadas[BITS];
+static uint8_t orden[2 * COLA];
+static bool flancos[2 * COLA];
+static uint32_t total;
+
+//! Indica al hilo que despacha que los hilos que publican terminaron
+static bool terminado;
+
+/* === Private function implementation ========================================================= */
+
+static void Evento(hal_gpio_bit_t gpio, bool rising, void * objeto) {
+    hal_gpio_bit_t * terminal = objeto;
+    uint8_t bit = terminal - terminales;
+    uint32_t indice = __atomic_fetch_add(&total, 1, __ATOMIC_RELAXED);
+
+    PRUEBA_VERIFICAR(gpio == *terminal);
+    __atomic_fetch_add(&llamadas[bit], 1, __ATOMIC_RELAXED);
+    if (indice < 2 * COLA) {
+        orden[indice] = bit;
+        flancos[indice] = rising;
+    }
+}
+
+// Vacia la cola antes de borrar los contadores, asi cada prueba empieza sin eventos pendientes
+static void Reiniciar(void) {
+    for (int bit = 0; bit < BITS; bit++) {
+        GpioSetEventHandler(terminales[bit], NULL, NULL, false, false);
+    }
+    GpioEmulateInputs(1, 0xFF, 0x00);
+    while (HalEventDispatch(COLA)) {
+    }
+    memset(llamadas, 0, sizeof(llamadas));
+    total = 0;
+    for (int bit = 0; bit < BITS; bit++) {
+        GpioSetEventHandler(terminales[bit], Evento, &terminales[bit], true, true);
+    }
+}
+
+static void * Publicar(void * objeto) {
+    hal_gpio_mask_t mascara = 1 << (intptr_t)objeto;
+    hal_gpio_mask_t valor = 0;
+
+    for (uint32_t cambio = 0; cambio < CAMBIOS; cambio++) {
+        valor ^= mascara;
+        GpioEmulateInputs(1, mascara, valor);
+    }
+    return NULL;
+}
+
+static void * Despachar(void * objeto) {
+    (void)objeto;
+
+    while (!__atomic_load_n(&terminado, __ATOMIC_ACQUIRE)) {
+        HalEventDispatch(COLA);
+    }
+    while (HalEventDispatch(COLA)) {
+    }
+    return NULL;
+}
+
+static void PruebaDiferidos(void) {
+    Reiniciar();
+
+    // El cambio solo guarda los eventos, en el orden de los bits
+    GpioEmulateInputs(1, 0xFF, 0x81);
+    GpioEmulateInputs(1, 0x01, 0x00);
+    PRUEBA_VERIFICAR(total == 0);
+
+    PRUEBA_VERIFICAR(HalEventDispatch(COLA) == 3);
+    PRUEBA_VERIFICAR(total == 3);
+    PRUEBA_VERIFICAR((orden[0] == 0) && flancos[0]);
+    PRUEBA_VERIFICAR((orden[1] == 7) && flancos[1]);
+    PRUEBA_VERIFICAR((orden[2] == 0) && !flancos[2]);
+
+    PRUEBA_VERIFICAR(HalEventDispatch(COLA) == 0);
+}
+
+static void PruebaLimite(void) {
+    Reiniciar();
+    GpioEmulateInputs(1, 0xFF, 0xFF);
+
+    PRUEBA_VERIFICAR(HalEventDispatch(3) == 3);
+    PRUEBA_VERIFICAR((total == 3) && (orden[2] == 2));
+    PRUEBA_VERIFICAR(HalEventDispatch(COLA) == BITS - 3);
+    PRUEBA_VERIFICAR((total == BITS) && (orden[BITS - 1] == BITS - 1));
+}
+
+static void PruebaDesborde(void) {
+    struct hal_event_statistics_s antes, despues;
+
+    Reiniciar();
+    HalEventGetStatistics(&antes);
+
+    // Los cambios de los ocho bits, alternando subidas y bajadas, llenan la cola y el siguiente se atiende en el momento
+    for (int cambio = 0; cambio < COLA / BITS; cambio++) {
+        GpioEmulateInputs(1, 0xFF, (cambio % 2) ? 0x00 : 0xFF);
+    }
+    PRUEBA_VERIFICAR(total == 0);
+    GpioEmulateInputs(1, 0x01, 0x01);
+    PRUEBA_VERIFICAR((total == 1) && (orden[0] == 0) && flancos[0]);
+
+    PRUEBA_VERIFICAR(HalEventDispatch(2 * COLA) == COLA);
+    PRUEBA_VERIFICAR(total == COLA + 1);
+    for (int bit = 0; bit < BITS; bit++) {
+        PRUEBA_VERIFICAR(llamadas[bit] == COLA / BITS + ((bit == 0) ? 1 : 0));
+    }
+
+    HalEventGetStatistics(&despues);
+    PRUEBA_VERIFICAR(despues.posted - antes.posted == COLA);
+    PRUEBA_VERIFICAR(despues.dispatched - antes.dispatched == COLA);
+    PRUEBA_VERIFICAR(despues.overflows - antes.overflows == 1);
+    PRUEBA_VERIFICAR(despues.pending == COLA);
+}
+
+static void PruebaConcurrencia(void) {
+    pthread_t publicadores[HILOS], despachador;
+
+    Reiniciar();
+    terminado = false;
+    pthread_create(&despachador, NULL, Despachar, NULL);
+    for (intptr_t indice = 0; indice < HILOS; indice++) {
+        pthread_create(&publicadores[indice], NULL, Publicar, (void *)indice);
+    }
+    for (int indice = 0; indice < HILOS; indice++) {
+        pthread_join(publicadores[indice], NULL);
+    }
+    __atomic_store_n(&terminado, true, __ATOMIC_RELEASE);
+    pthread_join(despachador, NULL);
+
+    // Cada cambio produce exactamente un evento, despachado o atendido en el momento si la cola estaba llena
+    PRUEBA_VERIFICAR(total == HILOS * CAMBIOS);
+    for (int bit = 0; bit < HILOS; bit++) {
+        PRUEBA_VERIFICAR(llamadas[bit] == CAMBIOS);
+    }
+}
+
+// Publicar y despachar de a un evento mide el costo que se agrega a la interrupcion y a la tarea
+static void PruebaCosto(void) {
+    uint64_t inicio;
+    uint32_t publicados = 0;
+
+    inicio = PruebaTiempo();
+    for (uint32_t indice = 0; indice < MEDICIONES; indice++) {
+        publicados += HalEventPostGpio(Evento, terminales[0], true, &terminales[0]);
+        HalEventDispatch(1);
+    }
+    PruebaMedicion("publicar_y_despachar", MEDICIONES, PruebaTiempo() - inicio);
+    PRUEBA_VERIFICAR(publicados == MEDICIONES);
+}
+
+/* === Public function implementation ========================================================= */
+
+int main(void) {
+    hal_gpio_bit_t todos[BITS] = {HAL_GPIO1_0, HAL_GPIO1_1, HAL_GPIO1_2, HAL_GPIO1_3,
+                                  HAL_GPIO1_4, HAL_GPIO1_5, HAL_GPIO1_6, HAL_GPIO1_7};
+
+    memcpy(terminales, todos, sizeof(terminales));
+    PruebaEjecutar("diferidos", PruebaDiferidos);
+    PruebaEjecutar("limite", PruebaLimite);
+    PruebaEjecutar("desborde", PruebaDesborde);
+    PruebaEjecutar("concurrencia", PruebaConcurrencia);
+    PruebaEjecutar("costo", PruebaCosto);
+    return PruebaResumen();
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,237 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Pruebas de convergencia de la disciplina del reloj
+ **
+ ** Simula un oscilador con deriva y una referencia con ruido en la medicion, y mide cuanto tarda el
+ ** reloj en seguir a la referencia sin saltos en la hora.
+ **
+ ** \addtogroup pruebas Pruebas
+ ** \brief Pruebas unitarias y mediciones de rendimiento
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "disciplina.h"
+#include "prueba.h"
+#include <stddef.h>
+#include <stdio.h>
+
+/* === Macros definitions ====================================================================== */
+
+#define TICS_POR_SEGUNDO 1000
+
+//! Segundos desde el 1 de enero de 2000 hasta el 1 de junio de 2023, inicio de la simulacion
+#define INICIO 738892800u
+
+/* === Private data type declarations ========================================================== */
+
+//! Condiciones de una simulacion
+typedef struct simulacion_s {
+    int32_t deriva;    //!< Deriva del oscilador del reloj, en partes por mil millones
+    uint32_t jitter;   //!< Ruido maximo en la hora de la referencia, en microsegundos
+    uint32_t periodo;  //!< Segundos entre mensajes de la referencia
+    uint32_t duracion; //!< Segundos simulados
+} const * simulacion_t;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static void NotificarAlarma(bool estado);
+static int64_t Desfase(void);
+static void Simular(simulacion_t simulacion, int64_t salto);
+static void EnviarReferencia(int32_t jitter);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static clock_t reloj;
+
+static disciplina_t disciplina;
+
+//! Tiempo real simulado en microsegundos desde el inicio
+static uint64_t ahora;
+
+//! Fraccion de tic del oscilador simulado que todavia no se entrego al reloj, en millonesimas de tic
+static int64_t resto;
+
+//! Primer segundo desde el que el reloj sigue a la referencia sin volver a apartarse
+static uint32_t convergencia;
+
+//! Mayor diferencia entre el avance del reloj y el tiempo real en un segundo, en microsegundos
+static int64_t salto_maximo;
+
+/* === Private function implementation ========================================================= */
+
+static void NotificarAlarma(bool estado) {
+}
+
+// Desfase del reloj respecto del tiempo real, en microsegundos
+static int64_t Desfase(void) {
+    uint32_t fraccion;
+    uint32_t segundos = ClockGetStamp(reloj, &fraccion);
+    int64_t local = (int64_t)(segundos - INICIO) * 1000000 + (((uint64_t)fraccion * 1000000) >> 32);
+
+    return local - (int64_t)ahora;
+}
+
+static void EnviarReferencia(int32_t jitter) {
+    uint64_t referencia = ahora + jitter;
+    char mensaje[40];
+    int largo = snprintf(mensaje, sizeof(mensaje), "$T,%u,%u\r\n", (unsigned)(INICIO + referencia / 1000000),
+                         (unsigned)(referencia % 1000000));
+
+    DisciplineReceive(disciplina, mensaje, largo);
+}
+
+// Avanza la simulacion de a un segundo, entregando al reloj los tics del oscilador con deriva
+static void Simular(simulacion_t simulacion, int64_t salto) {
+    int64_t anterior = Desfase();
+
+    convergencia = 0;
+    salto_maximo = 0;
+    for (uint32_t segundo = 1; segundo <= simulacion->duracion; segundo++) {
+        int64_t tics;
+        int64_t desfase;
+
+        resto += (int64_t)TICS_POR_SEGUNDO * (1000000000 + simulacion->deriva);
+        tics = resto / 1000000000;
+        resto -= tics * 1000000000;
+        ClockAdvance(reloj, tics);
+        ahora += 1000000;
+
+        if (segundo % simulacion->periodo == 0) {
+            int32_t jitter = 0;
+
+            if (simulacion->jitter) {
+                jitter = (int32_t)(PruebaAleatorio() % (2 * simulacion->jitter + 1)) - (int32_t)simulacion->jitter;
+            }
+            EnviarReferencia(jitter + salto);
+        }
+
+        desfase = Desfase();
+        if ((desfase - anterior > salto_maximo) || (anterior - desfase > salto_maximo)) {
+            salto_maximo = desfase > anterior ? desfase - anterior : anterior - desfase;
+        }
+        anterior = desfase;
+        if ((desfase - salto > 2000 + 2 * (int64_t)simulacion->jitter) ||
+            (desfase - salto < -2000 - 2 * (int64_t)simulacion->jitter)) {
+            convergencia = segundo;
+        }
+    }
+}
+
+static void PruebaConvergencia(void) {
+    static const struct simulacion_s simulaciones[] = {
+        {.deriva = 50000, .jitter = 1000, .periodo = 8, .duracion = 3600},
+        {.deriva = -20000, .jitter = 5000, .periodo = 16, .duracion = 3600},
+        {.deriva = 100000, .jitter = 0, .periodo = 1, .duracion = 3600},
+        {.deriva = 5000, .jitter = 2000, .periodo = 300, .duracion = 12 * 3600},
+    };
+    struct disciplina_estado_s estado;
+    uint8_t hora[6];
+
+    // La hora tomada de la referencia es valida aunque nunca se haya configurado a mano
+    PRUEBA_VERIFICAR(!ClockGetTime(reloj, hora, sizeof(hora)));
+    for (unsigned indice = 0; indice < sizeof(simulaciones) / sizeof(simulaciones[0]); indice++) {
+        simulacion_t simulacion = &simulaciones[indice];
+
+        Simular(simulacion, 0);
+        PRUEBA_VERIFICAR(ClockGetTime(reloj, hora, sizeof(hora)));
+        DisciplineGetStatus(disciplina, &estado);
+        printf("    deriva %d ppb, jitter %u us, periodo %u s: converge en %u s, desfase %d us, "
+               "frecuencia %d ppb, jitter %u us\n",
+               simulacion->deriva, simulacion->jitter, simulacion->periodo, convergencia, estado.desfase,
+               estado.frecuencia, estado.jitter);
+        PRUEBA_VERIFICAR(convergencia < simulacion->duracion / 2);
+        PRUEBA_VERIFICAR(estado.sincronizado);
+        // El ruido de la referencia limita la precision con la que se puede estimar la frecuencia
+        PRUEBA_VERIFICAR(estado.frecuencia + simulacion->deriva < 2000 + (int32_t)simulacion->jitter);
+        PRUEBA_VERIFICAR(estado.frecuencia + simulacion->deriva > -2000 - (int32_t)simulacion->jitter);
+    }
+}
+
+static void PruebaCorreccionGradual(void) {
+    static const struct simulacion_s simulacion = {.deriva = 30000, .jitter = 500, .periodo = 8, .duracion = 3600};
+    struct disciplina_estado_s estado;
+    uint32_t saltos;
+
+    Simular(&simulacion, 0);
+    DisciplineGetStatus(disciplina, &estado);
+    saltos = estado.saltos;
+
+    // Un cambio de 300 ms en la referencia se corrige sin saltos, a lo sumo medio milisegundo por segundo mas
+    // la deriva y la resolucion de un tic
+    Simular(&simulacion, 300000);
+    DisciplineGetStatus(disciplina, &estado);
+    printf("    cambio de 300 ms corregido en %u s, mayor paso %d us\n", convergencia, (int)salto_maximo);
+    PRUEBA_VERIFICAR(estado.saltos == saltos);
+    PRUEBA_VERIFICAR(salto_maximo <= 500 + simulacion.deriva / 1000 + 1000000 / TICS_POR_SEGUNDO);
+    PRUEBA_VERIFICAR(estado.sincronizado);
+}
+
+static void PruebaSaltoInicial(void) {
+    static const struct simulacion_s simulacion = {.deriva = 0, .jitter = 0, .periodo = 8, .duracion = 600};
+    struct disciplina_estado_s estado;
+    uint32_t saltos;
+
+    DisciplineGetStatus(disciplina, &estado);
+    saltos = estado.saltos;
+
+    // Un desfase de varios segundos se corrige de un salto
+    ahora -= 30000000;
+    Simular(&simulacion, 0);
+    DisciplineGetStatus(disciplina, &estado);
+    PRUEBA_VERIFICAR(estado.saltos == saltos + 1);
+    PRUEBA_VERIFICAR(convergencia <= simulacion.periodo);
+}
+
+static void PruebaPicosAislados(void) {
+    static const struct simulacion_s simulacion = {.deriva = 10000, .jitter = 200, .periodo = 8, .duracion = 1800};
+    struct disciplina_estado_s antes;
+    struct disciplina_estado_s despues;
+
+    Simular(&simulacion, 0);
+    DisciplineGetStatus(disciplina, &antes);
+    EnviarReferencia(200000);
+    DisciplineGetStatus(disciplina, &despues);
+    PRUEBA_VERIFICAR(despues.frecuencia == antes.frecuencia);
+    PRUEBA_VERIFICAR(despues.desfase == antes.desfase);
+}
+
+/* === Public function implementation ========================================================== */
+
+int main(void) {
+    reloj = ClockCreate(TICS_POR_SEGUNDO, NotificarAlarma);
+    disciplina = DisciplineCreate(reloj);
+
+    PruebaEjecutar("convergencia", PruebaConvergencia);
+    PruebaEjecutar("correccion_gradual", PruebaCorreccionGradual);
+    PruebaEjecutar("salto_inicial", PruebaSaltoInicial);
+    PruebaEjecutar("picos_aislados", PruebaPicosAislados);
+    return PruebaResumen();
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,218 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Pruebas de carga de los eventos diferidos del reloj
+ **
+ ** Programa miles de eventos simultaneos con demoras que abarcan todos los niveles de la rueda de
+ ** tiempos, incluso mas alla de su alcance y a traves del desborde del contador de segundos.
+ **
+ ** \addtogroup pruebas Pruebas
+ ** \brief Pruebas unitarias y mediciones de rendimiento
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "prueba.h"
+#include "reloj.h"
+#include <stddef.h>
+
+/* === Macros definitions ====================================================================== */
+
+#define TICS_POR_SEGUNDO 1
+
+#define CANTIDAD (CLOCK_EVENTS - 16)
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static void NotificarAlarma(bool estado);
+static void EventoVencido(clock_t reloj, void * objeto);
+static void Reprogramar(clock_t reloj, void * objeto);
+static void Programar(uint32_t maxima);
+static uint32_t Verificar(void);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static clock_t reloj;
+
+//! Segundos transcurridos desde la creacion del reloj, llevados por la prueba
+static uint32_t ahora;
+
+static uint32_t vencimientos[CANTIDAD];
+
+static uint32_t notificaciones[CANTIDAD];
+
+static clock_event_t eventos[CANTIDAD];
+
+static uint32_t fuera_de_hora;
+
+//! Demora con la que el manejador vuelve a programar un evento durante un avance
+static uint32_t demora_reprogramada;
+
+/* === Private function implementation ========================================================= */
+
+static void NotificarAlarma(bool estado) {
+}
+
+static void EventoVencido(clock_t reloj, void * objeto) {
+    uint32_t indice = (uint32_t)(uintptr_t)objeto;
+
+    notificaciones[indice]++;
+    fuera_de_hora += (vencimientos[indice] != ahora);
+    eventos[indice] = NULL;
+}
+
+// Programa desde el manejador otro evento relativo al final del avance, como lo hace la aplicacion
+static void Reprogramar(clock_t reloj, void * objeto) {
+    vencimientos[0] = ahora + demora_reprogramada;
+    notificaciones[0] = 0;
+    eventos[0] = ClockScheduleEvent(reloj, demora_reprogramada, EventoVencido, (void *)0);
+}
+
+static void Programar(uint32_t maxima) {
+    for (uint32_t indice = 0; indice < CANTIDAD; indice++) {
+        uint32_t demora = 1 + PruebaAleatorio() % maxima;
+
+        vencimientos[indice] = ahora + demora;
+        notificaciones[indice] = 0;
+        eventos[indice] = ClockScheduleEvent(reloj, demora, EventoVencido, (void *)(uintptr_t)indice);
+        PRUEBA_VERIFICAR(eventos[indice] != NULL);
+    }
+    fuera_de_hora = 0;
+}
+
+// Cuenta los eventos que no vencieron exactamente una vez
+static uint32_t Verificar(void) {
+    uint32_t errores = 0;
+
+    for (uint32_t indice = 0; indice < CANTIDAD; indice++) {
+        errores += (notificaciones[indice] != 1);
+    }
+    return errores;
+}
+
+static void PruebaVencenEnHora(void) {
+    Programar(70000);
+    for (uint32_t segundo = 0; segundo < 70000; segundo++) {
+        ahora++;
+        ClockUpdate(reloj);
+    }
+    PRUEBA_VERIFICAR(Verificar() == 0);
+    PRUEBA_VERIFICAR(fuera_de_hora == 0);
+}
+
+static void PruebaVencenMasAllaDelAlcance(void) {
+    // La rueda cubre 2^24 segundos, los eventos mas lejanos esperan en el ultimo nivel
+    Programar(45000000);
+    for (uint32_t segundo = 0; segundo < 45000000; segundo++) {
+        ahora++;
+        ClockUpdate(reloj);
+    }
+    PRUEBA_VERIFICAR(Verificar() == 0);
+    PRUEBA_VERIFICAR(fuera_de_hora == 0);
+}
+
+static void PruebaCancelados(void) {
+    Programar(100000);
+    for (uint32_t indice = 0; indice < CANTIDAD; indice += 3) {
+        ClockCancelEvent(eventos[indice]);
+        notificaciones[indice] = 1;
+    }
+    for (uint32_t segundo = 0; segundo < 100000; segundo++) {
+        ahora++;
+        ClockUpdate(reloj);
+    }
+    PRUEBA_VERIFICAR(Verificar() == 0);
+    PRUEBA_VERIFICAR(fuera_de_hora == 0);
+}
+
+static void PruebaAvanceVenceUnaVez(void) {
+    uint32_t inicio = ahora;
+    uint32_t demorados = 0;
+
+    Programar(30000000);
+    while (ahora - inicio <= 30000000) {
+        uint32_t tics = PruebaAleatorio() % 200000;
+
+        ahora += tics;
+        demorados += ClockAdvance(reloj, tics);
+    }
+    PRUEBA_VERIFICAR(Verificar() == 0);
+    PRUEBA_VERIFICAR(demorados == fuera_de_hora);
+}
+
+// El evento que vence durante el avance deja la rueda vacia y programa otro desde su manejador, que no
+// debe caer en la ranura que se esta vaciando y vencer antes de tiempo
+static void PruebaReprogramarDuranteAvance(void) {
+    fuera_de_hora = 0;
+    for (uint32_t avance = 2; avance < 80; avance += 7) {
+        for (demora_reprogramada = 1; demora_reprogramada <= 2 * 64; demora_reprogramada++) {
+            PRUEBA_VERIFICAR(ClockScheduleEvent(reloj, 1, Reprogramar, NULL) != NULL);
+            ahora += avance;
+            ClockAdvance(reloj, avance);
+            PRUEBA_VERIFICAR(notificaciones[0] == 0);
+
+            while (ahora != vencimientos[0]) {
+                ahora++;
+                ClockUpdate(reloj);
+            }
+            PRUEBA_VERIFICAR(notificaciones[0] == 1);
+        }
+    }
+    PRUEBA_VERIFICAR(fuera_de_hora == 0);
+}
+
+static void PruebaDesbordeDelContador(void) {
+    uint32_t salto = UINT32_MAX - ahora - 20000000;
+
+    ahora += salto;
+    ClockAdvance(reloj, salto);
+    Programar(45000000);
+    for (uint32_t segundo = 0; segundo < 45000000; segundo++) {
+        ahora++;
+        ClockUpdate(reloj);
+    }
+    PRUEBA_VERIFICAR(Verificar() == 0);
+    PRUEBA_VERIFICAR(fuera_de_hora == 0);
+}
+
+/* === Public function implementation ========================================================== */
+
+int main(void) {
+    reloj = ClockCreate(TICS_POR_SEGUNDO, NotificarAlarma);
+
+    PruebaEjecutar("eventos_vencen_en_hora", PruebaVencenEnHora);
+    PruebaEjecutar("eventos_mas_alla_del_alcance", PruebaVencenMasAllaDelAlcance);
+    PruebaEjecutar("eventos_cancelados", PruebaCancelados);
+    PruebaEjecutar("avance_vence_una_vez", PruebaAvanceVenceUnaVez);
+    PruebaEjecutar("reprogramar_durante_avance", PruebaReprogramarDuranteAvance);
+    PruebaEjecutar("desborde_del_contador", PruebaDesbordeDelContador);
+    return PruebaResumen();
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
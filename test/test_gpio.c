@@ -0,0 +1,346 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Pruebas de los eventos de las entradas digitales
+ **
+ ** Usa la implementacion posix, que despacha los eventos con el mismo recorrido por mascaras que la
+ ** interrupcion de grupo del lpc43xx. Verifica que con todos los terminales asignados cada cambio
+ ** llama una sola vez al manejador de su terminal, respetando los flancos pedidos, y que varios
+ ** hilos cambiando terminales del mismo puerto a la vez no pierden cambios ni eventos. Tambien opera
+ ** los puertos desde otro proceso a traves del archivo compartido, como lo haria una prueba automatica
+ ** de la aplicacion, y mide el tiempo de ida y vuelta de cada pedido.
+ **
+ ** \addtogroup pruebas Pruebas
+ ** \brief Pruebas unitarias y mediciones de rendimiento
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#define _DEFAULT_SOURCE
+
+#include "prueba.h"
+#include "soc_gpio.h"
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* === Macros definitions ====================================================================== */
+
+#define PUERTOS 4
+
+#define BITS 8
+
+//! Cambios que hace cada hilo, impar para que todos los terminales terminen en alto
+#define CAMBIOS 1000001
+
+//! Hilos que cambian entradas con eventos a la vez
+#define HILOS_ENTRADAS 4
+
+//! Pedidos que hace el proceso externo a traves del archivo compartido
+#define PEDIDOS 10000
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static void Evento(hal_gpio_bit_t gpio, bool rising, void * objeto);
+static void Reiniciar(void);
+static void * CambiarSalida(void * objeto);
+static void * CambiarEntrada(void * objeto);
+static void * Ejecutar(void * (*rutina)(void *), int hilos);
+static void Eco(hal_gpio_bit_t gpio, bool rising, void * objeto);
+static void Esperar(uint32_t * palabra, uint32_t valor);
+static void Despertar(uint32_t * palabra);
+static int ProcesoExterno(const char * nombre);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+//! Terminales de la placa, en el orden de sus puertos y bits
+static hal_gpio_bit_t terminales[PUERTOS][BITS];
+
+//! Llamadas recibidas y ultimo flanco informado por terminal
+static uint32_t llamadas[PUERTOS][BITS];
+static bool flancos[PUERTOS][BITS];
+static uint32_t total;
+
+/* === Private function implementation ========================================================= */
+
+// El objeto identifica al terminal, asi tambien se verifica que el descriptor informado es el asignado
+static void Evento(hal_gpio_bit_t gpio, bool rising, void * objeto) {
+    hal_gpio_bit_t * terminal = objeto;
+    uint8_t puerto = (terminal - &terminales[0][0]) / BITS;
+    uint8_t bit = (terminal - &terminales[0][0]) % BITS;
+
+    PRUEBA_VERIFICAR(gpio == *terminal);
+    __atomic_fetch_add(&llamadas[puerto][bit], 1, __ATOMIC_RELAXED);
+    flancos[puerto][bit] = rising;
+    __atomic_fetch_add(&total, 1, __ATOMIC_RELAXED);
+}
+
+static void Reiniciar(void) {
+    for (int puerto = 0; puerto < PUERTOS; puerto++) {
+        GpioEmulateInputs(puerto, 0xFF, 0x00);
+        for (int bit = 0; bit < BITS; bit++) {
+            GpioSetEventHandler(terminales[puerto][bit], NULL, NULL, false, false);
+        }
+    }
+    memset(llamadas, 0, sizeof(llamadas));
+    total = 0;
+}
+
+// Cada hilo cambia un bit distinto del mismo puerto, un cambio perdido deja su bit en bajo
+static void * CambiarSalida(void * objeto) {
+    hal_gpio_bit_t terminal = terminales[3][(intptr_t)objeto];
+
+    for (uint32_t cambio = 0; cambio < CAMBIOS; cambio++) {
+        GpioBitToogle(terminal);
+    }
+    return NULL;
+}
+
+static void * CambiarEntrada(void * objeto) {
+    hal_gpio_mask_t mascara = 1 << (intptr_t)objeto;
+    hal_gpio_mask_t valor = 0;
+
+    for (uint32_t cambio = 0; cambio < CAMBIOS; cambio++) {
+        valor ^= mascara;
+        GpioEmulateInputs(1, mascara, valor);
+    }
+    return NULL;
+}
+
+static void * Ejecutar(void * (*rutina)(void *), int hilos) {
+    pthread_t hilo[BITS];
+
+    for (intptr_t indice = 0; indice < hilos; indice++) {
+        pthread_create(&hilo[indice], NULL, rutina, (void *)indice);
+    }
+    for (int indice = 0; indice < hilos; indice++) {
+        pthread_join(hilo[indice], NULL);
+    }
+    return NULL;
+}
+
+// Copia la entrada en una salida, como haria la aplicacion al atender una tecla
+static void Eco(hal_gpio_bit_t gpio, bool rising, void * objeto) {
+    Evento(gpio, rising, objeto);
+    GpioPortSetState(3, 0x01, rising ? 0x01 : 0x00);
+}
+
+static void Esperar(uint32_t * palabra, uint32_t valor) {
+    syscall(SYS_futex, palabra, FUTEX_WAIT, valor, NULL, NULL, 0);
+}
+
+static void Despertar(uint32_t * palabra) {
+    syscall(SYS_futex, palabra, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+// Se ejecuta en el proceso hijo, informa la cantidad de fallas en el codigo de salida
+static int ProcesoExterno(const char * nombre) {
+    struct hal_gpio_shared_s * puertos;
+    uint32_t cambios, pedido;
+    uint64_t inicio;
+    int fallas = 0;
+    int archivo;
+
+    archivo = open(nombre, O_RDWR);
+    if (archivo < 0) {
+        return 1;
+    }
+    puertos = mmap(NULL, sizeof(*puertos), PROT_READ | PROT_WRITE, MAP_SHARED, archivo, 0);
+    close(archivo);
+    if ((puertos == MAP_FAILED) || (__atomic_load_n(&puertos->magic, __ATOMIC_ACQUIRE) != HAL_GPIO_SHARED_MAGIC)) {
+        return 1;
+    }
+
+    inicio = PruebaTiempo();
+    for (uint32_t indice = 0; indice < PEDIDOS; indice++) {
+        uint8_t valor = (indice & 1) ? 0x00 : 0x01;
+
+        // Se anota como esperando antes de leer el contador, asi no se pierde el aviso de la salida
+        __atomic_fetch_add(&puertos->waiters, 1, __ATOMIC_SEQ_CST);
+        cambios = __atomic_load_n(&puertos->changes, __ATOMIC_SEQ_CST);
+
+        puertos->port = 0;
+        puertos->mask = 0x01;
+        puertos->value = valor;
+        pedido = __atomic_add_fetch(&puertos->request, 1, __ATOMIC_RELEASE);
+        Despertar(&puertos->request);
+
+        while (__atomic_load_n(&puertos->applied, __ATOMIC_ACQUIRE) != pedido) {
+            Esperar(&puertos->applied, pedido - 1);
+        }
+        while (__atomic_load_n(&puertos->changes, __ATOMIC_SEQ_CST) == cambios) {
+            Esperar(&puertos->changes, cambios);
+        }
+        __atomic_fetch_sub(&puertos->waiters, 1, __ATOMIC_SEQ_CST);
+
+        // La entrada y la salida copiada ya estan en el estado compartido
+        fallas += ((__atomic_load_n(&puertos->state[0], __ATOMIC_RELAXED) & 0x01) != valor);
+        fallas += ((__atomic_load_n(&puertos->state[3], __ATOMIC_RELAXED) & 0x01) != valor);
+    }
+    PruebaMedicion("ida_y_vuelta", PEDIDOS, PruebaTiempo() - inicio);
+    return fallas ? 1 : 0;
+}
+
+static void PruebaTodosLosTerminales(void) {
+    Reiniciar();
+    for (int puerto = 0; puerto < PUERTOS; puerto++) {
+        for (int bit = 0; bit < BITS; bit++) {
+            GpioSetEventHandler(terminales[puerto][bit], Evento, &terminales[puerto][bit], true, true);
+        }
+    }
+
+    // Un cambio simultaneo de varios terminales produce un evento por cada uno
+    GpioEmulateInputs(2, 0xFF, 0xA5);
+    PRUEBA_VERIFICAR(total == 4);
+    for (int bit = 0; bit < BITS; bit++) {
+        PRUEBA_VERIFICAR(llamadas[2][bit] == ((0xA5 >> bit) & 1));
+        PRUEBA_VERIFICAR(!llamadas[2][bit] || flancos[2][bit]);
+    }
+
+    GpioEmulateInputs(2, 0xFF, 0x00);
+    PRUEBA_VERIFICAR(total == 8);
+    PRUEBA_VERIFICAR((llamadas[2][7] == 2) && !flancos[2][7]);
+
+    // Sin cambios no hay eventos
+    GpioEmulateInputs(2, 0xFF, 0x00);
+    PRUEBA_VERIFICAR(total == 8);
+
+    for (int puerto = 0; puerto < PUERTOS; puerto++) {
+        GpioEmulateInputs(puerto, 0xFF, 0xFF);
+    }
+    PRUEBA_VERIFICAR(total == 8 + PUERTOS * BITS);
+    PRUEBA_VERIFICAR((llamadas[3][7] == 1) && flancos[3][7]);
+}
+
+static void PruebaFlancos(void) {
+    Reiniciar();
+    GpioSetEventHandler(terminales[1][0], Evento, &terminales[1][0], true, false);
+    GpioSetEventHandler(terminales[1][1], Evento, &terminales[1][1], false, true);
+
+    GpioEmulateInputs(1, 0x03, 0x03);
+    PRUEBA_VERIFICAR((total == 1) && (llamadas[1][0] == 1) && flancos[1][0]);
+    GpioEmulateInputs(1, 0x03, 0x00);
+    PRUEBA_VERIFICAR((total == 2) && (llamadas[1][1] == 1) && !flancos[1][1]);
+}
+
+static void PruebaReasignar(void) {
+    Reiniciar();
+    GpioSetEventHandler(terminales[0][4], Evento, &terminales[0][4], true, true);
+
+    // Volver a asignar el manejador lo reemplaza, no lo duplica
+    GpioSetEventHandler(terminales[0][4], Evento, &terminales[0][4], true, true);
+    GpioEmulateInputs(0, 0x10, 0x10);
+    PRUEBA_VERIFICAR(llamadas[0][4] == 1);
+
+    GpioSetEventHandler(terminales[0][4], NULL, NULL, false, false);
+    GpioEmulateInputs(0, 0x10, 0x00);
+    PRUEBA_VERIFICAR(total == 1);
+
+    // Sin manejador el terminal solo cambia de estado
+    PRUEBA_VERIFICAR(!GpioGetState(terminales[0][4]));
+}
+
+static void PruebaConcurrencia(void) {
+    Reiniciar();
+    Ejecutar(CambiarSalida, BITS);
+    PRUEBA_VERIFICAR(GpioPortGetState(3, 0xFF) == 0xFF);
+
+    // Cada cambio produce exactamente un evento y el flanco informado es el del estado que quedo
+    for (int bit = 0; bit < HILOS_ENTRADAS; bit++) {
+        GpioSetEventHandler(terminales[1][bit], Evento, &terminales[1][bit], true, true);
+    }
+    Ejecutar(CambiarEntrada, HILOS_ENTRADAS);
+    PRUEBA_VERIFICAR(GpioPortGetState(1, 0xFF) == (1 << HILOS_ENTRADAS) - 1);
+    PRUEBA_VERIFICAR(total == HILOS_ENTRADAS * CAMBIOS);
+    for (int bit = 0; bit < HILOS_ENTRADAS; bit++) {
+        PRUEBA_VERIFICAR((llamadas[1][bit] == CAMBIOS) && flancos[1][bit]);
+    }
+}
+
+// Debe ser la ultima prueba, a partir de aqui los puertos quedan en el archivo compartido
+static void PruebaMemoriaCompartida(void) {
+    char nombre[64];
+    int estado;
+    pid_t hijo;
+
+    Reiniciar();
+    GpioPortClear(3, 0xFF);
+    GpioPortSetState(2, 0xFF, 0x5A);
+    snprintf(nombre, sizeof(nombre), "/tmp/test_gpio.%d", (int)getpid());
+    PRUEBA_VERIFICAR(GpioShareState(nombre));
+
+    // El estado anterior se conserva al pasar al archivo
+    PRUEBA_VERIFICAR(GpioPortGetState(2, 0xFF) == 0x5A);
+
+    GpioSetEventHandler(terminales[0][0], Eco, &terminales[0][0], true, true);
+    // Sin vaciar la salida antes el hijo repetiria los mensajes pendientes del padre
+    fflush(stdout);
+    hijo = fork();
+    if (hijo == 0) {
+        estado = ProcesoExterno(nombre);
+        fflush(stdout);
+        _exit(estado);
+    }
+    PRUEBA_VERIFICAR(hijo > 0);
+    PRUEBA_VERIFICAR((waitpid(hijo, &estado, 0) == hijo) && WIFEXITED(estado) && (WEXITSTATUS(estado) == 0));
+    unlink(nombre);
+
+    // Cada pedido alterna la entrada, asi que produce exactamente un evento
+    PRUEBA_VERIFICAR(llamadas[0][0] == PEDIDOS);
+    PRUEBA_VERIFICAR(!GpioPortGetState(0, 0x01) && !GpioPortGetState(3, 0x01));
+}
+
+/* === Public function implementation ========================================================= */
+
+int main(void) {
+    hal_gpio_bit_t todos[PUERTOS][BITS] = {
+        {HAL_GPIO0_0, HAL_GPIO0_1, HAL_GPIO0_2, HAL_GPIO0_3, HAL_GPIO0_4, HAL_GPIO0_5, HAL_GPIO0_6, HAL_GPIO0_7},
+        {HAL_GPIO1_0, HAL_GPIO1_1, HAL_GPIO1_2, HAL_GPIO1_3, HAL_GPIO1_4, HAL_GPIO1_5, HAL_GPIO1_6, HAL_GPIO1_7},
+        {HAL_GPIO2_0, HAL_GPIO2_1, HAL_GPIO2_2, HAL_GPIO2_3, HAL_GPIO2_4, HAL_GPIO2_5, HAL_GPIO2_6, HAL_GPIO2_7},
+        {HAL_GPIO3_0, HAL_GPIO3_1, HAL_GPIO3_2, HAL_GPIO3_3, HAL_GPIO3_4, HAL_GPIO3_5, HAL_GPIO3_6, HAL_GPIO3_7},
+    };
+
+    memcpy(terminales, todos, sizeof(terminales));
+    PruebaEjecutar("todos_los_terminales", PruebaTodosLosTerminales);
+    PruebaEjecutar("flancos", PruebaFlancos);
+    PruebaEjecutar("reasignar", PruebaReasignar);
+    PruebaEjecutar("concurrencia", PruebaConcurrencia);
+    PruebaEjecutar("memoria_compartida", PruebaMemoriaCompartida);
+    return PruebaResumen();
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,123 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Pruebas del monitor de pilas
+ **
+ ** Simula el espacio libre que informaria el sistema operativo y verifica el peor caso registrado,
+ ** los tamanos recomendados y el informe de texto.
+ **
+ ** \addtogroup pruebas Pruebas
+ ** \brief Pruebas unitarias y mediciones de rendimiento
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "pilas.h"
+#include "prueba.h"
+#include <stddef.h>
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static void Muestrear(pilas_t pilas, uint32_t libre_eventos, uint32_t libre_inactiva);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+static void Muestrear(pilas_t pilas, uint32_t libre_eventos, uint32_t libre_inactiva) {
+    struct pila_muestra_s muestras[] = {
+        {.nombre = "TareaEventos", .numero = 2, .tamano = 512, .libre = libre_eventos},
+        {.nombre = "IDLE", .numero = 1, .tamano = 128, .libre = libre_inactiva},
+    };
+
+    StackMonitorSample(pilas, muestras, sizeof(muestras) / sizeof(muestras[0]));
+}
+
+static void PruebaPeorCaso(void) {
+    pilas_t pilas = StackMonitorCreate(25);
+    struct pila_estado_s estado;
+
+    PRUEBA_VERIFICAR(pilas != NULL);
+    Muestrear(pilas, 400, 100);
+    Muestrear(pilas, 300, 110);
+    Muestrear(pilas, 350, 90);
+
+    PRUEBA_VERIFICAR(StackMonitorGetTask(pilas, 0, &estado));
+    PRUEBA_VERIFICAR(strcmp(estado.nombre, "TareaEventos") == 0);
+    PRUEBA_VERIFICAR((estado.tamano == 512) && (estado.usado == 212));
+    PRUEBA_VERIFICAR(StackMonitorGetTask(pilas, 1, &estado));
+    PRUEBA_VERIFICAR((estado.tamano == 128) && (estado.usado == 38));
+    PRUEBA_VERIFICAR(!StackMonitorGetTask(pilas, 2, &estado));
+}
+
+static void PruebaRecomendacion(void) {
+    pilas_t pilas = StackMonitorCreate(25);
+    struct pila_estado_s estado;
+
+    PRUEBA_VERIFICAR(pilas != NULL);
+
+    // 212 palabras mas el 25% son 265, que se redondean al siguiente multiplo de ocho
+    Muestrear(pilas, 300, 128);
+    StackMonitorGetTask(pilas, 0, &estado);
+    PRUEBA_VERIFICAR(estado.recomendado == 272);
+
+    // Una pila que nunca se uso no necesita espacio adicional
+    StackMonitorGetTask(pilas, 1, &estado);
+    PRUEBA_VERIFICAR((estado.usado == 0) && (estado.recomendado == 0));
+}
+
+static void PruebaInforme(void) {
+    pilas_t pilas = StackMonitorCreate(25);
+    char texto[64];
+    uint16_t largo;
+
+    PRUEBA_VERIFICAR(pilas != NULL);
+    Muestrear(pilas, 300, 88);
+
+    largo = StackMonitorReport(pilas, texto, sizeof(texto));
+    PRUEBA_VERIFICAR((largo == 43) && (memcmp(texto, "$S,TareaEventos,512,212,272,IDLE,128,40,56\n", largo) == 0));
+
+    // Las tareas que no entran completas se omiten, el fin de linea siempre se escribe
+    largo = StackMonitorReport(pilas, texto, 30);
+    PRUEBA_VERIFICAR((largo == 28) && (memcmp(texto, "$S,TareaEventos,512,212,272\n", largo) == 0));
+}
+
+/* === Public function implementation ========================================================= */
+
+int main(void) {
+    PruebaEjecutar("peor_caso", PruebaPeorCaso);
+    PruebaEjecutar("recomendacion", PruebaRecomendacion);
+    PruebaEjecutar("informe", PruebaInforme);
+    return PruebaResumen();
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,314 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Pruebas de los accesos a los registros de las entradas y salidas digitales del stm32f1xx
+ **
+ ** Compila las funciones de soc_gpio.h del stm32f1xx con el compilador nativo y mapea memoria en las
+ ** mismas direcciones que los registros de los puertos y que su region de alias de bits. Antes de cada
+ ** operacion carga en esa memoria el estado de un modelo de los puertos y despues busca las palabras
+ ** escritas y las aplica al modelo como lo haria el hardware: el registro de activar y borrar, el de
+ ** borrar y los alias de los bits de las salidas. Verifica que cada operacion sea una unica escritura,
+ ** que nunca se escriba directamente el registro de salidas y que el resultado sea el esperado.
+ **
+ ** Las direcciones y desplazamientos son los del manual de referencia RM0008, independientes de los
+ ** que usa la capa de abstraccion, asi un error en el calculo de un alias escribe fuera del lugar
+ ** esperado y la prueba lo detecta.
+ **
+ ** \addtogroup pruebas Pruebas
+ ** \brief Pruebas unitarias y mediciones de rendimiento
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#define _DEFAULT_SOURCE
+
+#include "prueba.h"
+#include "soc_gpio.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+
+/* === Macros definitions ====================================================================== */
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE 0x100000
+#endif
+
+#define PUERTOS 4
+
+#define BITS 16
+
+//! Direcciones de los perifericos, de su alias de bits y del puerto A segun el manual de referencia
+#define PERIFERICOS 0x40000000UL
+#define ALIAS       0x42000000UL
+#define PUERTO_A    0x40010800UL
+
+//! Distancia entre los registros de dos puertos y desplazamientos de los registros en cada puerto
+#define TAMANO_PUERTO 0x400UL
+#define IDR           0x08UL
+#define ODR           0x0CUL
+#define BSRR          0x10UL
+#define BRR           0x14UL
+
+//! Paginas mapeadas para los registros de los puertos y para los alias de sus bits
+#define REGISTROS        0x40010000UL
+#define TAMANO_REGISTROS 0x2000UL
+#define ALIAS_PUERTOS    (ALIAS + 32 * (PUERTO_A - PERIFERICOS))
+#define TAMANO_ALIAS     (32 * PUERTOS * TAMANO_PUERTO)
+
+//! Cambios aleatorios en las pruebas de los puertos
+#define CAMBIOS 10000
+
+/* === Private data type declarations ========================================================== */
+
+//! Estado de un puerto en el modelo
+typedef struct puerto_s {
+    uint16_t entradas; //!< Valor del registro de entradas
+    uint16_t salidas;  //!< Valor del registro de salidas
+} * puerto_t;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static bool Mapear(uintptr_t direccion, size_t tamano);
+static volatile uint32_t * Palabra(uintptr_t direccion);
+static void Cargar(void);
+static uint32_t Aplicar(void);
+static bool Escribir(puerto_t puerto, uintptr_t registro, uint32_t valor);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static struct puerto_s modelo[PUERTOS];
+
+//! Contenido de la memoria mapeada despues de cargar el modelo
+static uint32_t registros[TAMANO_REGISTROS / sizeof(uint32_t)];
+static uint32_t alias[TAMANO_ALIAS / sizeof(uint32_t)];
+
+//! Escrituras en palabras que no corresponden a un registro que se puede escribir
+static uint32_t invalidas;
+
+/* === Private function implementation ========================================================= */
+
+static bool Mapear(uintptr_t direccion, size_t tamano) {
+    void * memoria = mmap((void *)direccion, tamano, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+    return (memoria == (void *)direccion);
+}
+
+static volatile uint32_t * Palabra(uintptr_t direccion) {
+    return (volatile uint32_t *)direccion;
+}
+
+// Los alias de los bits devuelven el bit del registro, como en el hardware
+static void Cargar(void) {
+    memset((void *)REGISTROS, 0, TAMANO_REGISTROS);
+    memset((void *)ALIAS_PUERTOS, 0, TAMANO_ALIAS);
+
+    for (int indice = 0; indice < PUERTOS; indice++) {
+        uintptr_t puerto = PUERTO_A + indice * TAMANO_PUERTO;
+        *Palabra(puerto + IDR) = modelo[indice].entradas;
+        *Palabra(puerto + ODR) = modelo[indice].salidas;
+        for (int bit = 0; bit < BITS; bit++) {
+            *Palabra(ALIAS + 32 * (puerto + IDR - PERIFERICOS) + 4 * bit) = (modelo[indice].entradas >> bit) & 1;
+            *Palabra(ALIAS + 32 * (puerto + ODR - PERIFERICOS) + 4 * bit) = (modelo[indice].salidas >> bit) & 1;
+        }
+    }
+    memcpy(registros, (void *)REGISTROS, TAMANO_REGISTROS);
+    memcpy(alias, (void *)ALIAS_PUERTOS, TAMANO_ALIAS);
+}
+
+// En el registro de activar y borrar la mitad baja activa y tiene prioridad sobre la alta, que borra
+static bool Escribir(puerto_t puerto, uintptr_t registro, uint32_t valor) {
+    if (registro == BSRR) {
+        puerto->salidas = (puerto->salidas & ~(valor >> 16)) | (valor & 0xFFFF);
+    } else if (registro == BRR) {
+        puerto->salidas &= ~valor;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static uint32_t Aplicar(void) {
+    uint32_t escrituras = 0;
+
+    for (uint32_t indice = 0; indice < TAMANO_REGISTROS / sizeof(uint32_t); indice++) {
+        uint32_t valor = *Palabra(REGISTROS + indice * sizeof(uint32_t));
+        uintptr_t desplazamiento = REGISTROS + indice * sizeof(uint32_t) - PUERTO_A;
+
+        if (valor != registros[indice]) {
+            escrituras++;
+            if ((desplazamiento >= PUERTOS * TAMANO_PUERTO) ||
+                !Escribir(&modelo[desplazamiento / TAMANO_PUERTO], desplazamiento % TAMANO_PUERTO, valor)) {
+                invalidas++;
+            }
+        }
+    }
+
+    for (uint32_t indice = 0; indice < TAMANO_ALIAS / sizeof(uint32_t); indice++) {
+        uint32_t valor = *Palabra(ALIAS_PUERTOS + indice * sizeof(uint32_t));
+        // Cada palabra de los registros tiene 32 alias consecutivos, uno por bit
+        uintptr_t desplazamiento = (indice / 32) * sizeof(uint32_t);
+        uint8_t bit = indice % 32;
+
+        if (valor != alias[indice]) {
+            escrituras++;
+            if ((desplazamiento % TAMANO_PUERTO == ODR) && (bit < BITS)) {
+                puerto_t puerto = &modelo[desplazamiento / TAMANO_PUERTO];
+                puerto->salidas = (puerto->salidas & ~(1 << bit)) | ((valor & 1) << bit);
+            } else {
+                invalidas++;
+            }
+        }
+    }
+    return escrituras;
+}
+
+static void PruebaBits(void) {
+    invalidas = 0;
+    for (int indice = 0; indice < PUERTOS; indice++) {
+        for (int bit = 0; bit < BITS; bit++) {
+            uint16_t mascara = 1 << bit;
+            uint16_t otras;
+
+            modelo[indice].salidas = PruebaAleatorio();
+            otras = modelo[indice].salidas & ~mascara;
+
+            Cargar();
+            GpioFastSet(indice, bit);
+            PRUEBA_VERIFICAR(Aplicar() == 1);
+            PRUEBA_VERIFICAR(modelo[indice].salidas == (otras | mascara));
+
+            Cargar();
+            GpioFastClear(indice, bit);
+            PRUEBA_VERIFICAR(Aplicar() == 1);
+            PRUEBA_VERIFICAR(modelo[indice].salidas == otras);
+
+            Cargar();
+            GpioFastWrite(indice, bit, true);
+            PRUEBA_VERIFICAR(Aplicar() == 1);
+            PRUEBA_VERIFICAR(modelo[indice].salidas == (otras | mascara));
+
+            Cargar();
+            GpioFastToggle(indice, bit);
+            PRUEBA_VERIFICAR(Aplicar() == 1);
+            PRUEBA_VERIFICAR(modelo[indice].salidas == otras);
+
+            Cargar();
+            GpioFastToggle(indice, bit);
+            PRUEBA_VERIFICAR(Aplicar() == 1);
+            PRUEBA_VERIFICAR(modelo[indice].salidas == (otras | mascara));
+
+            Cargar();
+            GpioFastWrite(indice, bit, false);
+            PRUEBA_VERIFICAR(Aplicar() == 1);
+            PRUEBA_VERIFICAR(modelo[indice].salidas == otras);
+        }
+    }
+    PRUEBA_VERIFICAR(invalidas == 0);
+}
+
+static void PruebaLectura(void) {
+    invalidas = 0;
+    for (int indice = 0; indice < PUERTOS; indice++) {
+        modelo[indice].entradas = PruebaAleatorio();
+        modelo[indice].salidas = ~modelo[indice].entradas;
+    }
+
+    Cargar();
+    for (int indice = 0; indice < PUERTOS; indice++) {
+        for (int bit = 0; bit < BITS; bit++) {
+            PRUEBA_VERIFICAR(GpioFastGet(indice, bit) == ((modelo[indice].entradas >> bit) & 1));
+        }
+    }
+    PRUEBA_VERIFICAR(Aplicar() == 0);
+    PRUEBA_VERIFICAR(invalidas == 0);
+}
+
+// Los bits altos de la mascara no existen en el puerto y no deben borrar otras salidas
+static void PruebaPuertos(void) {
+    invalidas = 0;
+    for (uint32_t cambio = 0; cambio < CAMBIOS; cambio++) {
+        uint8_t indice = PruebaAleatorio() % PUERTOS;
+        uint32_t mascara = PruebaAleatorio();
+        uint32_t valor = PruebaAleatorio();
+        uint16_t esperado;
+
+        modelo[indice].salidas = PruebaAleatorio();
+        esperado = (modelo[indice].salidas & ~mascara) | (valor & mascara);
+
+        Cargar();
+        GpioFastPortWrite(indice, mascara, valor);
+        PRUEBA_VERIFICAR(Aplicar() <= 1);
+        PRUEBA_VERIFICAR(modelo[indice].salidas == esperado);
+    }
+    PRUEBA_VERIFICAR(invalidas == 0);
+}
+
+// Los nombres de los terminales resuelven el puerto y el bit en la compilacion
+static void PruebaMacros(void) {
+    invalidas = 0;
+    memset(modelo, 0, sizeof(modelo));
+
+    Cargar();
+    GPIO_FAST_SET(HAL_GPIO_PB9);
+    Aplicar();
+    PRUEBA_VERIFICAR((modelo[1].salidas == (1 << 9)) && (modelo[0].salidas == 0) && (modelo[2].salidas == 0));
+
+    Cargar();
+    GPIO_FAST_TOGGLE(HAL_GPIO_PC13);
+    Aplicar();
+    PRUEBA_VERIFICAR(modelo[2].salidas == (1 << 13));
+
+    Cargar();
+    GPIO_FAST_WRITE(HAL_GPIO_PD1, true);
+    GPIO_FAST_CLEAR(HAL_GPIO_PB9);
+    Aplicar();
+    PRUEBA_VERIFICAR((modelo[3].salidas == (1 << 1)) && (modelo[1].salidas == 0));
+
+    modelo[0].entradas = 1 << 15;
+    Cargar();
+    PRUEBA_VERIFICAR(GPIO_FAST_GET(HAL_GPIO_PA15) && !GPIO_FAST_GET(HAL_GPIO_PA0));
+    PRUEBA_VERIFICAR(invalidas == 0);
+}
+
+/* === Public function implementation ========================================================= */
+
+int main(void) {
+    if (!Mapear(REGISTROS, TAMANO_REGISTROS) || !Mapear(ALIAS_PUERTOS, TAMANO_ALIAS)) {
+        printf("No se pudo mapear la memoria de los registros\n");
+        return 1;
+    }
+
+    PruebaEjecutar("bits", PruebaBits);
+    PruebaEjecutar("lectura", PruebaLectura);
+    PruebaEjecutar("puertos", PruebaPuertos);
+    PruebaEjecutar("macros", PruebaMacros);
+    return PruebaResumen();
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,384 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Pruebas unitarias del reloj despertador
+ **
+ ** Verifica propiedades del reloj sobre intervalos y horas elegidos al azar, de forma que los
+ ** desbordes de minutos, horas y dias se ejerciten sin enumerarlos uno por uno.
+ **
+ ** \addtogroup pruebas Pruebas
+ ** \brief Pruebas unitarias y mediciones de rendimiento
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "prueba.h"
+#include "reloj.h"
+#include <stddef.h>
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+#define TICS_POR_SEGUNDO 10
+
+#define SEGUNDOS_POR_DIA 86400u
+
+//! Dias desde el 1 de enero de 1970 hasta el 1 de enero de 2000
+#define DIAS_EPOCA 10957
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static void NotificarAlarma(bool estado);
+static uint32_t Segundos(clock_t reloj);
+static void FijarSegundos(clock_t reloj, uint32_t segundos);
+static void FijarAlarma(uint32_t hora);
+static void Sincronizar(void);
+static void Tics(uint32_t cantidad);
+static void Reiniciar(void);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static clock_t reloj;
+
+static uint32_t alarmas;
+
+static uint32_t alarmas_fuera_de_hora;
+
+static uint32_t hora_esperada;
+
+/* === Private function implementation ========================================================= */
+
+static void NotificarAlarma(bool estado) {
+    if (estado) {
+        alarmas++;
+        alarmas_fuera_de_hora += (Segundos(reloj) % SEGUNDOS_POR_DIA != hora_esperada);
+    }
+}
+
+// Hora del reloj en segundos desde el 1 de enero de 2000
+static uint32_t Segundos(clock_t reloj) {
+    uint8_t hora[6];
+    fecha_t fecha;
+
+    ClockGetTime(reloj, hora, sizeof(hora));
+    ClockGetDate(reloj, &fecha);
+    return (CalendarDaysFromCivil(fecha.anio, fecha.mes, fecha.dia) - DIAS_EPOCA) * SEGUNDOS_POR_DIA +
+           (10 * hora[0] + hora[1]) * 3600 + (10 * hora[2] + hora[3]) * 60 + 10 * hora[4] + hora[5];
+}
+
+static void FijarSegundos(clock_t reloj, uint32_t segundos) {
+    uint32_t dia = segundos % SEGUNDOS_POR_DIA;
+    uint8_t hora[6] = {
+        dia / 36000, (dia / 3600) % 10, (dia / 600) % 6, (dia / 60) % 10, (dia / 10) % 6, dia % 10,
+    };
+    fecha_t fecha;
+
+    CalendarCivilFromDays(DIAS_EPOCA + segundos / SEGUNDOS_POR_DIA, &fecha);
+    ClockSetDate(reloj, &fecha);
+    ClockSetTime(reloj, hora, sizeof(hora));
+}
+
+static void FijarAlarma(uint32_t hora) {
+    uint8_t alarma[4] = {hora / 36000, (hora / 3600) % 10, (hora / 600) % 6, (hora / 60) % 10};
+
+    hora_esperada = hora - hora % 60;
+    AlarmSetTime(reloj, alarma, sizeof(alarma));
+    ActivateAlarm(reloj, true);
+}
+
+// Avanza hasta el comienzo de un segundo, para que las pruebas no dependan de la fase de los tics
+static void Sincronizar(void) {
+    uint32_t inicial = Segundos(reloj);
+
+    while (Segundos(reloj) == inicial) {
+        ClockUpdate(reloj);
+    }
+}
+
+static void Tics(uint32_t cantidad) {
+    for (uint32_t indice = 0; indice < cantidad; indice++) {
+        ClockUpdate(reloj);
+    }
+}
+
+static void Reiniciar(void) {
+    ActivateAlarm(reloj, false);
+    AlarmSetWeekdays(reloj, 0x7F);
+    ClockSetDst(reloj, DST_NINGUNO);
+    alarmas = 0;
+    alarmas_fuera_de_hora = 0;
+}
+
+static void PruebaTicsAvanzanSegundos(void) {
+    Reiniciar();
+    for (int repeticion = 0; repeticion < 200; repeticion++) {
+        uint32_t cantidad = PruebaAleatorio() % (TICS_POR_SEGUNDO * 20000);
+        uint32_t inicial;
+
+        FijarSegundos(reloj, PruebaAleatorio() % (100 * 365 * SEGUNDOS_POR_DIA));
+        Sincronizar();
+        inicial = Segundos(reloj);
+        Tics(cantidad);
+        PRUEBA_VERIFICAR(Segundos(reloj) == inicial + cantidad / TICS_POR_SEGUNDO);
+    }
+}
+
+static void PruebaAvanceEquivaleATics(void) {
+    Reiniciar();
+    for (int repeticion = 0; repeticion < 1000; repeticion++) {
+        uint32_t cantidad = PruebaAleatorio() % (TICS_POR_SEGUNDO * 10 * 365 * SEGUNDOS_POR_DIA);
+        uint32_t faltan = TICS_POR_SEGUNDO - cantidad % TICS_POR_SEGUNDO;
+        uint32_t inicial;
+
+        FijarSegundos(reloj, PruebaAleatorio() % (100 * 365 * SEGUNDOS_POR_DIA));
+        Sincronizar();
+        inicial = Segundos(reloj);
+        ClockAdvance(reloj, cantidad);
+        PRUEBA_VERIFICAR(Segundos(reloj) == inicial + cantidad / TICS_POR_SEGUNDO);
+
+        // El avance conserva la fase de los tics dentro del segundo
+        Tics(faltan - 1);
+        PRUEBA_VERIFICAR(Segundos(reloj) == inicial + cantidad / TICS_POR_SEGUNDO);
+        Tics(1);
+        PRUEBA_VERIFICAR(Segundos(reloj) == inicial + cantidad / TICS_POR_SEGUNDO + 1);
+    }
+}
+
+static void PruebaCambioDeDia(void) {
+    static const fecha_t fechas[][2] = {
+        {{2023, 12, 31}, {2024, 1, 1}},
+        {{2024, 2, 28}, {2024, 2, 29}},
+        {{2024, 2, 29}, {2024, 3, 1}},
+        {{2100, 2, 28}, {2100, 3, 1}},
+    };
+    uint8_t hora[6] = {2, 3, 5, 9, 5, 9};
+    uint8_t esperada[6] = {0, 0, 0, 0, 0, 0};
+    uint8_t actual[6];
+    fecha_t fecha;
+
+    Reiniciar();
+    for (unsigned indice = 0; indice < sizeof(fechas) / sizeof(fechas[0]); indice++) {
+        ClockSetDate(reloj, &fechas[indice][0]);
+        Sincronizar();
+        ClockSetTime(reloj, hora, sizeof(hora));
+        Tics(TICS_POR_SEGUNDO - 1);
+        ClockGetTime(reloj, actual, sizeof(actual));
+        PRUEBA_VERIFICAR(memcmp(actual, hora, sizeof(hora)) == 0);
+        Tics(1);
+        ClockGetTime(reloj, actual, sizeof(actual));
+        ClockGetDate(reloj, &fecha);
+        PRUEBA_VERIFICAR(memcmp(actual, esperada, sizeof(esperada)) == 0);
+        PRUEBA_VERIFICAR(fecha.anio == fechas[indice][1].anio);
+        PRUEBA_VERIFICAR(fecha.mes == fechas[indice][1].mes);
+        PRUEBA_VERIFICAR(fecha.dia == fechas[indice][1].dia);
+    }
+}
+
+static void PruebaAlarmaSuenaUnaVezPorDia(void) {
+    Reiniciar();
+    for (int repeticion = 0; repeticion < 5; repeticion++) {
+        FijarSegundos(reloj, PruebaAleatorio() % (100 * 365 * SEGUNDOS_POR_DIA));
+        FijarAlarma(PruebaAleatorio() % SEGUNDOS_POR_DIA);
+        alarmas = 0;
+        Tics(3 * SEGUNDOS_POR_DIA * TICS_POR_SEGUNDO);
+        PRUEBA_VERIFICAR(alarmas == 3);
+        PRUEBA_VERIFICAR(alarmas_fuera_de_hora == 0);
+    }
+}
+
+static void PruebaAlarmaEnDiasHabilitados(void) {
+    fecha_t lunes = {2023, 6, 5};
+    uint8_t hora[6] = {0, 6, 0, 0, 0, 0};
+
+    Reiniciar();
+    ClockSetDate(reloj, &lunes);
+    ClockSetTime(reloj, hora, sizeof(hora));
+    FijarAlarma(7 * 3600);
+    AlarmSetWeekdays(reloj, 0x3E);
+    for (int dia = 0; dia < 14; dia++) {
+        Tics(2 * 3600 * TICS_POR_SEGUNDO);
+        ClockAdvance(reloj, 22 * 3600 * TICS_POR_SEGUNDO);
+    }
+    PRUEBA_VERIFICAR(alarmas == 10);
+    PRUEBA_VERIFICAR(alarmas_fuera_de_hora == 0);
+}
+
+static void PruebaAvanceInformaDemoras(void) {
+    uint32_t demoradas;
+
+    Reiniciar();
+    FijarSegundos(reloj, 20 * 365 * SEGUNDOS_POR_DIA + 6 * 3600);
+    FijarAlarma(7 * 3600);
+    hora_esperada = 6 * 3600;
+
+    // Las tres alarmas vencidas durante el avance se notifican una sola vez al terminar
+    demoradas = ClockAdvance(reloj, 3 * SEGUNDOS_POR_DIA * TICS_POR_SEGUNDO);
+    PRUEBA_VERIFICAR(demoradas == 3);
+    PRUEBA_VERIFICAR(alarmas == 1);
+
+    // Una alarma que vence en el ultimo segundo del avance se atiende a tiempo
+    hora_esperada = 7 * 3600;
+    demoradas = ClockAdvance(reloj, 3600 * TICS_POR_SEGUNDO);
+    PRUEBA_VERIFICAR(demoradas == 0);
+    PRUEBA_VERIFICAR(alarmas == 2);
+    PRUEBA_VERIFICAR(alarmas_fuera_de_hora == 0);
+}
+
+static void PruebaPostergacion(void) {
+    Reiniciar();
+    FijarSegundos(reloj, 20 * 365 * SEGUNDOS_POR_DIA + 7 * 3600 - 1);
+    FijarAlarma(7 * 3600);
+    Sincronizar();
+    PRUEBA_VERIFICAR(alarmas == 1);
+
+    hora_esperada = 7 * 3600 + 5 * 60;
+    ExtendAlarm(reloj, 5);
+    Tics((5 * 60 - 1) * TICS_POR_SEGUNDO);
+    PRUEBA_VERIFICAR(alarmas == 1);
+    Tics(TICS_POR_SEGUNDO);
+    PRUEBA_VERIFICAR(alarmas == 2);
+
+    // La alarma diaria no suena mientras la alarma esta pospuesta
+    hora_esperada = 7 * 3600 + 5 * 60;
+    ExtendAlarm(reloj, 2 * 24 * 60);
+    Tics(2 * SEGUNDOS_POR_DIA * TICS_POR_SEGUNDO);
+    PRUEBA_VERIFICAR(alarmas == 3);
+    PRUEBA_VERIFICAR(alarmas_fuera_de_hora == 0);
+}
+
+static void PruebaHorarioVerano(void) {
+    fecha_t cambio = {2023, 3, 26};
+    uint8_t hora[6] = {0, 1, 5, 9, 5, 9};
+    uint8_t esperada[6] = {0, 3, 0, 0, 0, 0};
+    uint8_t actual[6];
+
+    Reiniciar();
+    ClockSetDst(reloj, DST_EUROPA_CENTRAL);
+    ClockSetDate(reloj, &cambio);
+    Sincronizar();
+    ClockSetTime(reloj, hora, sizeof(hora));
+    Tics(TICS_POR_SEGUNDO);
+    ClockGetTime(reloj, actual, sizeof(actual));
+    PRUEBA_VERIFICAR(memcmp(actual, esperada, sizeof(esperada)) == 0);
+    ClockSetDst(reloj, DST_NINGUNO);
+}
+
+static void PruebaZonasHorarias(void) {
+    static clock_t zona = NULL;
+    uint32_t inicial;
+
+    Reiniciar();
+    if (zona == NULL) {
+        zona = ClockCreate(TICS_POR_SEGUNDO, NotificarAlarma);
+    }
+    PRUEBA_VERIFICAR(zona != NULL);
+    FijarSegundos(reloj, 20 * 365 * SEGUNDOS_POR_DIA);
+    ClockSetZone(zona, reloj, -3 * 3600);
+    PRUEBA_VERIFICAR(Segundos(zona) == Segundos(reloj) - 3 * 3600);
+
+    // Cambiar la hora de la referencia mueve la zona, cambiar la zona no mueve la referencia
+    FijarSegundos(reloj, 30 * 365 * SEGUNDOS_POR_DIA);
+    PRUEBA_VERIFICAR(Segundos(zona) == Segundos(reloj) - 3 * 3600);
+    inicial = Segundos(reloj);
+    FijarSegundos(zona, inicial + 1800);
+    PRUEBA_VERIFICAR(Segundos(reloj) == inicial);
+    PRUEBA_VERIFICAR(Segundos(zona) == inicial + 1800);
+
+    ClockAdvance(reloj, 1000 * TICS_POR_SEGUNDO);
+    PRUEBA_VERIFICAR(Segundos(zona) == Segundos(reloj) + 1800);
+}
+
+static void ContarEvento(clock_t reloj, void * objeto) {
+    uint32_t * contador = objeto;
+
+    (*contador)++;
+}
+
+static void PruebaLiberarReloj(void) {
+    uint32_t propios = 0, ajenos = 0, inicial;
+    clock_t liberado, zona;
+
+    Reiniciar();
+    FijarSegundos(reloj, 20 * 365 * SEGUNDOS_POR_DIA);
+    liberado = ClockCreate(TICS_POR_SEGUNDO, NotificarAlarma);
+    zona = ClockCreate(TICS_POR_SEGUNDO, NotificarAlarma);
+    PRUEBA_VERIFICAR((liberado != NULL) && (zona != NULL));
+    FijarSegundos(liberado, 25 * 365 * SEGUNDOS_POR_DIA);
+    ClockSetZone(zona, liberado, 3600);
+    ClockScheduleEvent(reloj, 10, ContarEvento, &ajenos);
+    for (uint32_t segundos = 5; segundos <= 15; segundos += 5) {
+        ClockScheduleEvent(liberado, segundos, ContarEvento, &propios);
+    }
+
+    // Los eventos del reloj liberado no vencen y los de los otros relojes no se pierden
+    inicial = Segundos(zona);
+    ClockDestroy(liberado);
+    Tics(20 * TICS_POR_SEGUNDO);
+    PRUEBA_VERIFICAR(propios == 0);
+    PRUEBA_VERIFICAR(ajenos == 1);
+    PRUEBA_VERIFICAR(Segundos(zona) == inicial + 20);
+    PRUEBA_VERIFICAR(ClockGetTime(zona, (uint8_t[6]){0}, 6));
+
+    // El descriptor liberado vuelve a la reserva
+    PRUEBA_VERIFICAR(ClockCreate(TICS_POR_SEGUNDO, NotificarAlarma) == liberado);
+    ClockDestroy(liberado);
+    ClockDestroy(zona);
+}
+
+static void PruebaReservaDeRelojes(void) {
+    int creados = 0;
+
+    PRUEBA_VERIFICAR(ClockCreate(TICS_POR_SEGUNDO + 1, NotificarAlarma) == NULL);
+    while (ClockCreate(TICS_POR_SEGUNDO, NotificarAlarma) != NULL) {
+        creados++;
+        PRUEBA_VERIFICAR(creados < CLOCK_INSTANCES);
+    }
+    PRUEBA_VERIFICAR(creados == CLOCK_INSTANCES - 2);
+}
+
+/* === Public function implementation ========================================================== */
+
+int main(void) {
+    reloj = ClockCreate(TICS_POR_SEGUNDO, NotificarAlarma);
+
+    PruebaEjecutar("tics_avanzan_segundos", PruebaTicsAvanzanSegundos);
+    PruebaEjecutar("avance_equivale_a_tics", PruebaAvanceEquivaleATics);
+    PruebaEjecutar("cambio_de_dia", PruebaCambioDeDia);
+    PruebaEjecutar("alarma_suena_una_vez_por_dia", PruebaAlarmaSuenaUnaVezPorDia);
+    PruebaEjecutar("alarma_en_dias_habilitados", PruebaAlarmaEnDiasHabilitados);
+    PruebaEjecutar("avance_informa_demoras", PruebaAvanceInformaDemoras);
+    PruebaEjecutar("postergacion", PruebaPostergacion);
+    PruebaEjecutar("horario_verano", PruebaHorarioVerano);
+    PruebaEjecutar("zonas_horarias", PruebaZonasHorarias);
+    PruebaEjecutar("liberar_reloj", PruebaLiberarReloj);
+    PruebaEjecutar("reserva_de_relojes", PruebaReservaDeRelojes);
+    return PruebaResumen();
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
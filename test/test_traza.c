@@ -0,0 +1,173 @@
+/************************************************************************************************
+Copyright (c) 2023, Rosales Facundo Ezequiel <facundoerosales@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Pruebas de la grabacion de entradas y pantalla
+ **
+ ** Graba en memoria y vuelve a leer los registros, verificando que solo se graban los cambios, que
+ ** el tic se conserva en grabaciones de semanas y que una grabacion cortada no se lee de mas.
+ **
+ ** \addtogroup pruebas Pruebas
+ ** \brief Pruebas unitarias y mediciones de rendimiento
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "prueba.h"
+#include "traza.h"
+#include <stddef.h>
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+//! Tics de un dia con un tic por milisegundo
+#define TICS_POR_DIA 86400000u
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static void Guardar(void * objeto, const uint8_t * datos, uint16_t cantidad);
+static traza_t Crear(uint8_t digitos);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+//! Bytes grabados y cantidad de llamadas a la funcion de escritura
+static uint8_t grabacion[256];
+static uint32_t grabados;
+static uint32_t escrituras;
+
+/* === Private function implementation ========================================================= */
+
+static void Guardar(void * objeto, const uint8_t * datos, uint16_t cantidad) {
+    PRUEBA_VERIFICAR(objeto == grabacion);
+    PRUEBA_VERIFICAR(grabados + cantidad <= sizeof(grabacion));
+    memcpy(&grabacion[grabados], datos, cantidad);
+    grabados += cantidad;
+    escrituras++;
+}
+
+static traza_t Crear(uint8_t digitos) {
+    grabados = 0;
+    escrituras = 0;
+    return TraceCreate(digitos, Guardar, grabacion);
+}
+
+static void PruebaIdaYVuelta(void) {
+    static const uint8_t HORA[] = {0x06, 0x5B | 0x80, 0x4F, 0x66};
+    struct traza_lector_s lector;
+    struct traza_registro_s registro;
+    traza_t traza = Crear(4);
+
+    PRUEBA_VERIFICAR(traza != NULL);
+    PRUEBA_VERIFICAR(escrituras == 1);
+
+    // El primer estado se graba aunque las entradas esten en cero, los repetidos no se graban
+    TraceTick(traza, 1);
+    TraceFrame(traza, HORA);
+    TraceInputs(traza, 0x00);
+    TraceTick(traza, 1);
+    TraceFrame(traza, HORA);
+    TraceInputs(traza, 0x00);
+    TraceTick(traza, 5);
+    TraceInputs(traza, 0x21);
+    TraceClose(traza);
+    PRUEBA_VERIFICAR(escrituras == 5);
+
+    PRUEBA_VERIFICAR(TraceOpen(&lector, grabacion, grabados));
+    PRUEBA_VERIFICAR(lector.digitos == 4);
+    PRUEBA_VERIFICAR(TraceRead(&lector, &registro));
+    PRUEBA_VERIFICAR((registro.tipo == TRAZA_PANTALLA) && (registro.tic == 1));
+    PRUEBA_VERIFICAR(memcmp(registro.datos, HORA, sizeof(HORA)) == 0);
+    PRUEBA_VERIFICAR(TraceRead(&lector, &registro));
+    PRUEBA_VERIFICAR((registro.tipo == TRAZA_ENTRADAS) && (registro.tic == 1) && (registro.datos[0] == 0x00));
+    PRUEBA_VERIFICAR(TraceRead(&lector, &registro));
+    PRUEBA_VERIFICAR((registro.tipo == TRAZA_ENTRADAS) && (registro.tic == 7) && (registro.datos[0] == 0x21));
+    PRUEBA_VERIFICAR(TraceRead(&lector, &registro));
+    PRUEBA_VERIFICAR((registro.tipo == TRAZA_FIN) && (registro.tic == 7));
+    PRUEBA_VERIFICAR(!TraceRead(&lector, &registro));
+}
+
+static void PruebaSemanas(void) {
+    struct traza_lector_s lector;
+    struct traza_registro_s registro;
+    traza_t traza = Crear(4);
+    uint32_t inicio;
+
+    TraceTick(traza, 1);
+    TraceInputs(traza, 0x01);
+
+    // Sesenta dias sin cambios superan los 32 bits de tics y ocupan un registro de seis bytes
+    for (int dia = 0; dia < 60; dia++) {
+        TraceTick(traza, TICS_POR_DIA);
+    }
+    inicio = grabados;
+    TraceInputs(traza, 0x00);
+    PRUEBA_VERIFICAR(grabados - inicio == 6);
+    TraceClose(traza);
+
+    PRUEBA_VERIFICAR(TraceOpen(&lector, grabacion, grabados));
+    PRUEBA_VERIFICAR(TraceRead(&lector, &registro));
+    PRUEBA_VERIFICAR(TraceRead(&lector, &registro));
+    PRUEBA_VERIFICAR((registro.tipo == TRAZA_ENTRADAS) && (registro.tic == 1 + 60ull * TICS_POR_DIA));
+}
+
+static void PruebaIncompleta(void) {
+    static const uint8_t HORA[] = {0x06, 0x5B, 0x4F, 0x66};
+    struct traza_lector_s lector;
+    struct traza_registro_s registro;
+    traza_t traza = Crear(4);
+    uint32_t completos;
+
+    TraceTick(traza, 200);
+    TraceInputs(traza, 0x01);
+    completos = grabados;
+    TraceFrame(traza, HORA);
+    TraceClose(traza);
+
+    // Un corte en medio de la pantalla deja el lector en el ultimo registro completo
+    PRUEBA_VERIFICAR(TraceOpen(&lector, grabacion, completos + 3));
+    PRUEBA_VERIFICAR(TraceRead(&lector, &registro));
+    PRUEBA_VERIFICAR(!TraceRead(&lector, &registro));
+    PRUEBA_VERIFICAR(lector.posicion == completos);
+
+    // Un registro de inicio con otra version no se acepta
+    grabacion[1] = TRACE_VERSION + 1;
+    PRUEBA_VERIFICAR(!TraceOpen(&lector, grabacion, grabados));
+    PRUEBA_VERIFICAR(!TraceOpen(&lector, grabacion, 0));
+    PRUEBA_VERIFICAR(Crear(TRACE_MAX_DIGITS + 1) == NULL);
+}
+
+/* === Public function implementation ========================================================= */
+
+int main(void) {
+    PruebaEjecutar("ida_y_vuelta", PruebaIdaYVuelta);
+    PruebaEjecutar("semanas", PruebaSemanas);
+    PruebaEjecutar("incompleta", PruebaIncompleta);
+    return PruebaResumen();
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */